@@ -0,0 +1,305 @@
+# Constant Propagation
+# Tracks which register, flag and zero page values are known constants before every instruction, along every path through the code sections.
+# NOTES:
+# -Code sections which can be entered at runtime in ways we don't follow (interrupts, calls, runtime calculated jumps, the interpreter) begin
+#  with nothing known, as do the given entry addresses (labels in the middle of a code section). Nothing is known after a call either.
+# -Interrupts can occur after any instruction. Handlers are assumed to preserve the registers (RTI restores the flags), since the code they
+#  interrupt couldn't rely on them otherwise. Zero page addresses the handlers may write are never tracked.
+from MOS6502Instructions import *
+from NESMemory import NESMemory
+from PRGROM import *
+
+class ConstantPropagationResult:
+    """Describes the effects of an instruction, given what was known before it (None where a value isn't known)."""
+    def __init__(self):
+        self.address = None # the effective address the instruction accesses
+        self.value = None # the value the instruction reads (its operand)
+        self.registers = {} # register name : value written
+        self.flags = {} # flag name (C, Z, V, N) : value written
+        self.write = None # (address, value) written to memory
+        self.branchTaken = None # if a conditional branch is taken
+
+class ConstantPropagation:
+    FLAG_BITS = { "C" : 0, "Z" : 1, "V" : 6, "N" : 7 }
+    def __init__(self, rom, prgRom, entryAddresses):
+        """Determines what is known before every instruction of the given PRG-ROM, where the given addresses can also be entered at runtime."""
+        self.__states = {} # instruction address : state before it (dictionary of register/flag name or zero page address : value), None if unreachable
+        self.__untrackedZeroPage = ConstantPropagation.findInterruptWrites(rom, prgRom)
+        self.__Propagate(rom, prgRom, entryAddresses)
+
+    @staticmethod
+    def getZeroPageAddress(address):
+        """Obtains the zero page address the given CPU address accesses (including RAM mirrors), or None if it isn't in zero page."""
+        if(address < 0x2000 and (address & 0x7FF) < 0x100):
+            return address & 0xFF
+        return None
+
+    def getState(self, address):
+        """Obtains what is known before the instruction at the given address (None if no path reaches it)."""
+        return self.__states.get(address)
+
+    @staticmethod
+    def __GetSuccessors(rom, prgRom, section):
+        """Obtains the code section addresses the given code section continues at (branch and jump targets, and the code following it)."""
+        successors = []
+        for instruction in section.instructions:
+            if(instruction.definition.isJumpOrBranch and type(instruction.definition) is not MOSInstr_JSR):
+                offset = prgRom.resolveJumpOffset(rom, instruction)
+                if(offset != None):
+                    successors.append(NESMemory.offsetToPointer(offset))
+        if(len(section.instructions) > 0 and not section.instructions[-1].definition.marksEndOfSection):
+            successors.append(section.address + section.getSize())
+        return successors
+
+    @staticmethod
+    def findInterruptWrites(rom, prgRom):
+        """Determines the zero page addresses code reachable from the NMI/IRQ handlers may write (all of them, if we can't tell)."""
+        allAddresses = set(range(0, 0x100))
+        pending = [NESMemory.offsetToPointer(NESMemory.pointerToOffset(rom, vector)) for vector in [prgRom.interruptNMI, prgRom.interruptIRQ]]
+        visited = set([])
+        written = set([])
+        while(len(pending) > 0):
+            address = pending.pop()
+            if(address in visited or address not in prgRom.codeSections):
+                continue
+            visited.add(address)
+            section = prgRom.codeSections[address]
+            pending.extend(ConstantPropagation.__GetSuccessors(rom, prgRom, section))
+            for instruction in section.instructions:
+                instrType = type(instruction.definition)
+                if(instrType is MOSInstr_JSR):
+                    pending.append(NESMemory.offsetToPointer(prgRom.resolveJumpOffset(rom, instruction)))
+                elif(instruction.address in prgRom.computedJumps):
+                    if(len(prgRom.computedJumps[instruction.address]) == 0):
+                        return allAddresses
+                    pending.extend(prgRom.computedJumps[instruction.address])
+                written |= ConstantPropagation.getPossibleWrites(instruction)
+        return written
+
+    @staticmethod
+    def getPossibleWrites(instruction):
+        """Obtains the zero page addresses the given instruction may write, regardless of what is known."""
+        if(type(instruction.definition) not in {MOSInstr_STA, MOSInstr_STX, MOSInstr_STY, MOSInstr_ASL, MOSInstr_DEC, MOSInstr_INC, MOSInstr_LSR, MOSInstr_ROL, MOSInstr_ROR}):
+            return set([])
+        mode = instruction.definition.mode
+        if(mode == MOSAddressingMode.ACCUMULATOR):
+            return set([])
+        if(mode == MOSAddressingMode.ZERO_PAGE or mode == MOSAddressingMode.ABSOLUTE):
+            addresses = [instruction.operand]
+        elif(mode == MOSAddressingMode.ABSOLUTE_X or mode == MOSAddressingMode.ABSOLUTE_Y):
+            addresses = range(instruction.operand, instruction.operand + 0x100)
+        else:
+            return set(range(0, 0x100)) # zero page indexed or indirect could be anywhere.
+        zeroPageAddresses = [ConstantPropagation.getZeroPageAddress(address & 0xFFFF) for address in addresses]
+        return set([address for address in zeroPageAddresses if address != None])
+
+    def __Propagate(self, rom, prgRom, entryAddresses):
+        """Propagates what is known through all code sections until nothing changes."""
+        # Sections entered any other way than a branch or jump we follow begin with nothing known.
+        instructionsByOffset = dict([(instruction.offset, instruction) for section in prgRom.codeSections.values() for instruction in section.instructions])
+        def isFollowed(referencedBy):
+            instruction = instructionsByOffset.get(referencedBy)
+            return instruction != None and (instruction.definition.mode == MOSAddressingMode.RELATIVE or (type(instruction.definition) is MOSInstr_JMP and instruction.definition.mode == MOSAddressingMode.ABSOLUTE))
+        # The interpreter executes runtime calculated jumps we couldn't resolve, and returns to compiled code at any code section.
+        allDynamic = prgRom.hasUnresolvedJumps()
+        computedTargets = set([target for targets in prgRom.computedJumps.values() for target in targets])
+        entryStates = {}
+        for address, section in prgRom.codeSections.items():
+            if(allDynamic or address in entryAddresses or address in computedTargets or section.referenceType != PRGROMCodeSectionType.LOCATION or any(not isFollowed(referencedBy) for referencedBy in section.referencedBy)):
+                entryStates[address] = {}
+
+        pending = sorted(entryStates.keys())
+        while(len(pending) > 0):
+            address = pending.pop(0)
+            section = prgRom.codeSections[address]
+            state = dict(entryStates[address])
+            for instruction in section.instructions:
+                if(instruction.address in entryAddresses and instruction.address != address):
+                    state = {}
+                self.__states[instruction.address] = state
+                result = self.evaluate(state, instruction)
+                if(result.branchTaken != False and instruction.definition.isJumpOrBranch and type(instruction.definition) is not MOSInstr_JSR):
+                    offset = prgRom.resolveJumpOffset(rom, instruction)
+                    if(offset != None):
+                        self.__Join(entryStates, pending, NESMemory.offsetToPointer(offset), state)
+                if(result.branchTaken == True):
+                    state = None
+                    break
+                state = self.__Apply(state, instruction, result)
+            if(state != None and len(section.instructions) > 0 and not section.instructions[-1].definition.marksEndOfSection):
+                self.__Join(entryStates, pending, section.address + section.getSize(), state)
+        # Instructions after a branch which is always taken (or in sections no path reaches) are unreachable.
+        for section in prgRom.codeSections.values():
+            for instruction in section.instructions:
+                if(instruction.address not in self.__states):
+                    self.__states[instruction.address] = None
+
+    def __Join(self, entryStates, pending, address, state):
+        """Adds the given state as one the code section at the given address can be entered with, and revisits it if that changed what is known."""
+        if(address not in entryStates):
+            joined = dict(state)
+        else:
+            joined = dict([(key, value) for key, value in entryStates[address].items() if state.get(key) == value])
+            if(len(joined) == len(entryStates[address])):
+                return
+        entryStates[address] = joined
+        if(address not in pending):
+            pending.append(address)
+
+    def __Apply(self, state, instruction, result):
+        """Obtains what is known after the given instruction, given what was known before it and its effects."""
+        instrType = type(instruction.definition)
+        if(instrType is MOSInstr_JSR):
+            return {} # the subroutine could change anything.
+        state = dict(state)
+        for name, value in list(result.registers.items()) + list(result.flags.items()):
+            if(value == None):
+                state.pop(name, None)
+            else:
+                state[name] = value
+        if(instrType is MOSInstr_PLP):
+            for name in self.FLAG_BITS:
+                state.pop(name, None)
+        if(result.write != None):
+            address, value = result.write
+            if(address == None):
+                for zeroPageAddress in self.getPossibleWrites(instruction):
+                    state.pop(zeroPageAddress, None)
+            else:
+                zeroPageAddress = self.getZeroPageAddress(address)
+                if(zeroPageAddress != None):
+                    if(value == None or zeroPageAddress in self.__untrackedZeroPage):
+                        state.pop(zeroPageAddress, None)
+                    else:
+                        state[zeroPageAddress] = value
+        return state
+
+    def __GetAddress(self, state, instruction):
+        """Obtains the effective address the given instruction accesses, if it's known."""
+        mode = instruction.definition.mode
+        operand = instruction.operand
+        if(mode == MOSAddressingMode.ZERO_PAGE or mode == MOSAddressingMode.ABSOLUTE):
+            return operand
+        if(mode == MOSAddressingMode.ZERO_PAGE_X and "X" in state):
+            return (operand + state["X"]) & 0xFF
+        if(mode == MOSAddressingMode.ZERO_PAGE_Y and "Y" in state):
+            return (operand + state["Y"]) & 0xFF
+        if(mode == MOSAddressingMode.ABSOLUTE_X and "X" in state):
+            return (operand + state["X"]) & 0xFFFF
+        if(mode == MOSAddressingMode.ABSOLUTE_Y and "Y" in state):
+            return (operand + state["Y"]) & 0xFFFF
+        if(mode == MOSAddressingMode.INDIRECT_X and "X" in state):
+            pointer = self.__GetPointer(state, (operand + state["X"]) & 0xFF)
+            return pointer
+        if(mode == MOSAddressingMode.INDIRECT_Y and "Y" in state):
+            pointer = self.__GetPointer(state, operand)
+            return (pointer + state["Y"]) & 0xFFFF if pointer != None else None
+        return None
+
+    def __GetPointer(self, state, zeroPageAddress):
+        """Obtains the pointer at the given zero page address, if it's known (pointers read from 0xFF read their high byte outside of zero page)."""
+        if(zeroPageAddress == 0xFF or zeroPageAddress not in state or zeroPageAddress + 1 not in state):
+            return None
+        return state[zeroPageAddress] | (state[zeroPageAddress + 1] << 8)
+
+    def evaluate(self, state, instruction):
+        """Determines the effects of the given instruction, given what is known before it."""
+        result = ConstantPropagationResult()
+        if(state == None):
+            return result
+        instrType = type(instruction.definition)
+        mode = instruction.definition.mode
+
+        # Determine the address accessed and the value read.
+        if(mode == MOSAddressingMode.IMMEDIATE):
+            result.value = instruction.operand
+        elif(mode == MOSAddressingMode.ACCUMULATOR):
+            result.value = state.get("A")
+        elif(mode not in {MOSAddressingMode.IMPLIED, MOSAddressingMode.RELATIVE, MOSAddressingMode.INDIRECT} and not instruction.definition.isJumpOrBranch):
+            result.address = self.__GetAddress(state, instruction)
+            if(result.address != None):
+                zeroPageAddress = self.getZeroPageAddress(result.address)
+                if(zeroPageAddress != None and zeroPageAddress not in self.__untrackedZeroPage):
+                    result.value = state.get(zeroPageAddress)
+        value = result.value
+        known = lambda *names: all(name in state for name in names)
+
+        def setLoad(register, loaded):
+            result.registers[register] = loaded
+            result.flags["Z"] = None if loaded == None else loaded == 0
+            result.flags["N"] = None if loaded == None else (loaded & 0x80) != 0
+
+        if(instrType in {MOSInstr_LDA, MOSInstr_LDX, MOSInstr_LDY}):
+            setLoad({MOSInstr_LDA : "A", MOSInstr_LDX : "X", MOSInstr_LDY : "Y"}[instrType], value)
+        elif(instrType in {MOSInstr_STA, MOSInstr_STX, MOSInstr_STY}):
+            result.write = (result.address, state.get({MOSInstr_STA : "A", MOSInstr_STX : "X", MOSInstr_STY : "Y"}[instrType]))
+        elif(instrType in {MOSInstr_TAX, MOSInstr_TAY, MOSInstr_TXA, MOSInstr_TYA}):
+            source, destination = { MOSInstr_TAX : ("A", "X"), MOSInstr_TAY : ("A", "Y"), MOSInstr_TXA : ("X", "A"), MOSInstr_TYA : ("Y", "A") }[instrType]
+            setLoad(destination, state.get(source))
+        elif(instrType in {MOSInstr_TSX, MOSInstr_PLA}):
+            setLoad("X" if instrType is MOSInstr_TSX else "A", None)
+        elif(instrType in {MOSInstr_INX, MOSInstr_INY, MOSInstr_DEX, MOSInstr_DEY}):
+            register = "X" if instrType in {MOSInstr_INX, MOSInstr_DEX} else "Y"
+            step = 1 if instrType in {MOSInstr_INX, MOSInstr_INY} else -1
+            setLoad(register, (state[register] + step) & 0xFF if known(register) else None)
+        elif(instrType in {MOSInstr_AND, MOSInstr_ORA, MOSInstr_EOR}):
+            operation = { MOSInstr_AND : lambda a, b: a & b, MOSInstr_ORA : lambda a, b: a | b, MOSInstr_EOR : lambda a, b: a ^ b }[instrType]
+            setLoad("A", operation(state["A"], value) if known("A") and value != None else None)
+        elif(instrType in {MOSInstr_ADC, MOSInstr_SBC}):
+            if(known("A", "C") and value != None):
+                a = state["A"]
+                operand = value if instrType is MOSInstr_ADC else (value ^ 0xFF)
+                total = a + operand + (1 if state["C"] else 0)
+                setLoad("A", total & 0xFF)
+                result.flags["C"] = total > 0xFF
+                result.flags["V"] = (~(a ^ operand) & (a ^ total) & 0x80) != 0
+            else:
+                setLoad("A", None)
+                result.flags["C"] = None
+                result.flags["V"] = None
+        elif(instrType in {MOSInstr_CMP, MOSInstr_CPX, MOSInstr_CPY}):
+            register = { MOSInstr_CMP : "A", MOSInstr_CPX : "X", MOSInstr_CPY : "Y" }[instrType]
+            compared = known(register) and value != None
+            difference = (state[register] - value) & 0xFF if compared else None
+            result.flags["C"] = state[register] >= value if compared else None
+            result.flags["Z"] = difference == 0 if compared else None
+            result.flags["N"] = (difference & 0x80) != 0 if compared else None
+        elif(instrType is MOSInstr_BIT):
+            result.flags["V"] = (value & 0x40) != 0 if value != None else None
+            result.flags["N"] = (value & 0x80) != 0 if value != None else None
+            result.flags["Z"] = (value & state["A"]) == 0 if value != None and known("A") else None
+        elif(instrType in {MOSInstr_ASL, MOSInstr_LSR, MOSInstr_ROL, MOSInstr_ROR, MOSInstr_INC, MOSInstr_DEC}):
+            shifted = None
+            carry = None
+            if(value != None and instrType is MOSInstr_ASL):
+                shifted, carry = (value << 1) & 0xFF, (value & 0x80) != 0
+            elif(value != None and instrType is MOSInstr_LSR):
+                shifted, carry = value >> 1, (value & 0x01) != 0
+            elif(value != None and instrType is MOSInstr_ROL and known("C")):
+                shifted, carry = ((value << 1) | (1 if state["C"] else 0)) & 0xFF, (value & 0x80) != 0
+            elif(value != None and instrType is MOSInstr_ROR and known("C")):
+                shifted, carry = (value >> 1) | (0x80 if state["C"] else 0), (value & 0x01) != 0
+            elif(value != None and instrType in {MOSInstr_INC, MOSInstr_DEC}):
+                shifted = (value + (1 if instrType is MOSInstr_INC else -1)) & 0xFF
+            result.flags["Z"] = shifted == 0 if shifted != None else None
+            result.flags["N"] = (shifted & 0x80) != 0 if shifted != None else None
+            if(instrType not in {MOSInstr_INC, MOSInstr_DEC}):
+                result.flags["C"] = carry
+            if(mode == MOSAddressingMode.ACCUMULATOR):
+                result.registers["A"] = shifted
+            else:
+                result.write = (result.address, shifted)
+        elif(instrType in {MOSInstr_CLC, MOSInstr_SEC}):
+            result.flags["C"] = instrType is MOSInstr_SEC
+        elif(instrType is MOSInstr_CLV):
+            result.flags["V"] = False
+        elif(instruction.definition.mode == MOSAddressingMode.RELATIVE):
+            flag, taken = {
+                MOSInstr_BCC : ("C", False), MOSInstr_BCS : ("C", True),
+                MOSInstr_BNE : ("Z", False), MOSInstr_BEQ : ("Z", True),
+                MOSInstr_BPL : ("N", False), MOSInstr_BMI : ("N", True),
+                MOSInstr_BVC : ("V", False), MOSInstr_BVS : ("V", True),
+            }[instrType]
+            if(flag in state):
+                result.branchTaken = state[flag] == taken
+        return result
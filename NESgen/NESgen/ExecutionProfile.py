@@ -0,0 +1,58 @@
+# Execution Profile Support
+# Profiles are written by NESsys (games generated with -g) after a run, one record per line:
+#   block <address> <count>                       (times a code section was entered)
+#   branch <address> <not taken> <taken>          (outcomes of a conditional branch)
+#   indirect <address> <target address> <count>   (targets of a runtime calculated jump)
+#   miss <address> <count>                        (jumps the compiled code had no label for)
+from NESMemory import NESMemory
+class ExecutionProfile:
+    def __init__(self, rom, path):
+        """Loads the profile at the given path, with PRG-ROM addresses corrected for mirroring."""
+        self.blockCounts = {} # address : count
+        self.branchCounts = {} # address : (not taken count, taken count)
+        self.indirectTargets = {} # address : { target address : count }
+        self.missCounts = {} # address : count (including addresses outside of PRG-ROM, such as RAM)
+        with open(path, "r") as file:
+            for line in file:
+                fields = line.split("#")[0].split()
+                if(len(fields) == 0):
+                    continue
+                # Addresses are hexadecimal, counts are decimal.
+                addressCount = 2 if fields[0] == "indirect" else 1
+                values = [int(field, 16) if x < addressCount else int(field) for x, field in enumerate(fields[1:])]
+                address = self.__fixAddress(rom, values[0])
+                if(fields[0] == "block"):
+                    self.blockCounts[address] = self.blockCounts.get(address, 0) + values[1]
+                elif(fields[0] == "branch"):
+                    counts = self.branchCounts.get(address, (0, 0))
+                    self.branchCounts[address] = (counts[0] + values[1], counts[1] + values[2])
+                elif(fields[0] == "indirect"):
+                    targets = self.indirectTargets.setdefault(address, {})
+                    target = self.__fixAddress(rom, values[1])
+                    targets[target] = targets.get(target, 0) + values[2]
+                elif(fields[0] == "miss"):
+                    self.missCounts[address] = self.missCounts.get(address, 0) + values[1]
+                else:
+                    raise ValueError("Unexpected record in execution profile: {}".format(line.strip()))
+
+    def __fixAddress(self, rom, address):
+        """Corrects mirrored PRG-ROM addresses, leaving others as they are."""
+        if(not NESMemory.isROMMemory(address)):
+            return address
+        return NESMemory.offsetToPointer(NESMemory.pointerToOffset(rom, address))
+
+    def getCodeAddresses(self):
+        """Obtains all PRG-ROM addresses the profile observed code being executed at, but which may not have been jumped to directly."""
+        addresses = set([target for targets in self.indirectTargets.values() for target in targets]) | set(self.missCounts.keys())
+        return sorted([address for address in addresses if NESMemory.isROMMemory(address)])
+
+    def getBlockCount(self, address):
+        """Obtains how many times the code section at the given address was entered."""
+        return self.blockCounts.get(address, 0)
+
+    def getBranchBias(self, address, minimumSamples):
+        """Obtains the ratio of times the branch at the given address was taken, or None if it wasn't executed enough to tell."""
+        counts = self.branchCounts.get(address, (0, 0))
+        if(counts[0] + counts[1] < minimumSamples):
+            return None
+        return counts[1] / (counts[0] + counts[1])
@@ -0,0 +1,178 @@
+# Known Routines
+# A library of routines many games share (multiplication, division, decimal conversion, pseudo-random number generators), recognized at
+# subroutine addresses by their instructions, so the runtime can execute them with native code (hle.c) instead.
+# NOTES:
+# -Patterns list a routine's instructions in memory order, up to its RTS. Names stand for a zero page address (or an immediate value, after #),
+#  which must be the same everywhere the name is used. Names followed by a colon label branch targets within the routine.
+# -Only zero page operands are matched, so a routine never accesses memory with side effects, and its instructions take the same cycles
+#  in every game. The runtime executes the instructions' exact effects on memory, registers and flags (whatever the variables hold).
+# -The operands a routine was matched with are given to the runtime in the order their names first appear in the pattern.
+from MOS6502Instructions import *
+from NESMemory import NESMemory
+from PRGROM import *
+
+class KnownRoutine:
+    """Describes a routine the runtime has a native implementation of."""
+    def __init__(self, name, routineType, pattern):
+        self.name = name
+        self.routineType = routineType # HLETYPE the runtime implements it with
+        self.pattern = [line.split() for line in pattern.strip().splitlines()]
+
+class KnownRoutineMatch:
+    """Describes a subroutine recognized as a known routine."""
+    def __init__(self, routine, address, exitAddress, operands, text):
+        self.routine = routine
+        self.address = address
+        self.exitAddress = exitAddress # address of the routine's RTS
+        self.operands = operands # list of (name, value), in the order the runtime expects them
+        self.text = text # the operands summarized
+        self.arrayIndex = 0 # index into gameKnownRoutines
+
+class KnownRoutines:
+    ROUTINES = [
+        # Shift and add multiplication: factor * multiplicand, the high byte in A and the low byte in factor.
+        KnownRoutine("8x8 multiply", "HLE_MULTIPLY", """
+            LDA #$00
+            LDX #count
+            LSR factor
+            loop:
+            BCC skip
+            CLC
+            ADC multiplicand
+            skip:
+            ROR A
+            ROR factor
+            DEX
+            BNE loop
+            RTS"""),
+        # Shift and subtract division: (high:low) / divisor, the quotient in high:low and the remainder in A.
+        KnownRoutine("16/8 divide", "HLE_DIVIDE", """
+            LDA #$00
+            LDX #count
+            loop:
+            ASL low
+            ROL high
+            ROL A
+            CMP divisor
+            BCC skip
+            SBC divisor
+            INC low
+            skip:
+            DEX
+            BNE loop
+            RTS"""),
+        # Decimal conversion by repeated subtraction: A into hundreds, tens and ones digits.
+        KnownRoutine("decimal conversion", "HLE_DECIMAL", """
+            LDY #$00
+            hundredsLoop:
+            CMP #$64
+            BCC tensStart
+            SBC #$64
+            INY
+            BNE hundredsLoop
+            tensStart:
+            STY hundreds
+            LDY #$00
+            tensLoop:
+            CMP #$0a
+            BCC onesStart
+            SBC #$0a
+            INY
+            BNE tensLoop
+            onesStart:
+            STY tens
+            STA ones
+            RTS"""),
+        # Galois linear feedback shift register: seedHigh:seedLow shifted count times, with the feedback taps applied for every bit shifted out.
+        KnownRoutine("LFSR random number", "HLE_LFSR", """
+            LDX #count
+            LDA seedLow
+            loop:
+            ASL A
+            ROL seedHigh
+            BCC skip
+            EOR #feedback
+            skip:
+            DEX
+            BNE loop
+            STA seedLow
+            CMP #$00
+            RTS"""),
+    ]
+
+    def __init__(self, rom, prgRom):
+        """Recognizes known routines at every subroutine address of the given PRG-ROM, printing a report of them."""
+        self.matches = {} # subroutine address : KnownRoutineMatch
+        instructions = dict([(instruction.address, instruction) for section in prgRom.codeSections.values() for instruction in section.instructions])
+        subroutineAddresses = set([])
+        for instruction in instructions.values():
+            if(type(instruction.definition) is MOSInstr_JSR):
+                offset = prgRom.resolveJumpOffset(rom, instruction)
+                if(offset is not None):
+                    subroutineAddresses.add(NESMemory.offsetToPointer(offset))
+        for address in sorted(subroutineAddresses):
+            for routine in self.ROUTINES:
+                match = self.__Match(rom, prgRom, instructions, routine, address)
+                if(match is not None):
+                    match.arrayIndex = len(self.matches)
+                    self.matches[address] = match
+                    break
+
+        # Print our report.
+        counts = ", ".join(["{}: {}".format(routine.name, len([match for match in self.matches.values() if match.routine is routine])) for routine in self.ROUTINES])
+        print("Known routines: replaced {} of {} subroutines with native code ({}).".format(len(self.matches), len(subroutineAddresses), counts))
+        for address, match in self.matches.items():
+            print("\t{}: {} ({})".format(hex(address), match.routine.name, match.text))
+
+    def __Match(self, rom, prgRom, instructions, routine, address):
+        """Matches the given routine's pattern against the instructions at the given address. Returns a KnownRoutineMatch, or None if they differ."""
+        start = address
+        bindings = {} # name : zero page address or immediate value
+        order = [] # names in the order they first appear
+        labels = {} # label name : address
+        branches = [] # (branch instruction, label name)
+        instruction = None
+        for fields in routine.pattern:
+            if(fields[0].endswith(":")):
+                labels[fields[0][:-1]] = address
+                continue
+            instruction = instructions.get(address)
+            if(instruction is None or instruction.definition.name != fields[0]):
+                return None
+            mode = instruction.definition.mode
+            operand = fields[1] if len(fields) > 1 else None
+            if(operand is None):
+                if(mode != MOSAddressingMode.IMPLIED):
+                    return None
+            elif(operand == "A"):
+                if(mode != MOSAddressingMode.ACCUMULATOR):
+                    return None
+            elif(instruction.definition.isJumpOrBranch):
+                if(mode != MOSAddressingMode.RELATIVE):
+                    return None
+                branches.append((instruction, operand))
+            else:
+                # Immediate values and zero page addresses are literals, or names bound to the first value they're matched with.
+                immediate = operand.startswith("#")
+                if(mode != (MOSAddressingMode.IMMEDIATE if immediate else MOSAddressingMode.ZERO_PAGE)):
+                    return None
+                name = operand[1:] if immediate else operand
+                if(name.startswith("$")):
+                    if(instruction.operand != int(name[1:], 16)):
+                        return None
+                elif(name in bindings):
+                    if(bindings[name] != instruction.operand):
+                        return None
+                else:
+                    bindings[name] = instruction.operand
+                    order.append(name)
+            address += instruction.definition.size
+        if(type(instruction.definition) is not MOSInstr_RTS):
+            return None
+        # Every branch must go to its label.
+        for branch, label in branches:
+            if(NESMemory.offsetToPointer(prgRom.resolveJumpOffset(rom, branch)) != labels[label]):
+                return None
+        operands = [(name, bindings[name]) for name in order]
+        text = ", ".join(["{}: {}".format(name, hex(value)) for name, value in operands])
+        return KnownRoutineMatch(routine, start, instruction.address, operands, text)
@@ -0,0 +1,322 @@
+# Liveness
+# Summarizes which registers and flags every subroutine reads, writes and preserves (following its own calls, until nothing changes), and with
+# those summaries determines which registers and flags may still be read after every instruction (are live), across JSRs and RTSs.
+# NOTES:
+# -Only A, X, Y and the C, Z, V and N flags are tracked. Everything is live wherever we can't follow the code: runtime calculated jumps, RTI, BRK,
+#  jumps out of the PRG-ROM, the given opaque addresses (which runtime code reads everything at), and RTS whose callers we don't know.
+# -Subroutines which may not return to their caller (stack pointer changes, more pulls than pushes, stack page writes, runtime calculated jumps)
+#  are treated as reading everything and writing nothing, as are their callers' JSRs to them.
+# -Interrupts can occur after any instruction. Handlers are assumed to preserve the registers (RTI restores the flags), as in ConstantPropagation.
+from MOS6502Instructions import *
+from NESMemory import NESMemory
+from PRGROM import *
+
+class SubroutineSummary:
+    """Describes the registers and flags a subroutine reads before writing them, may write, and writes along every path to its RTS."""
+    def __init__(self, reads, writes, mustWrites, understood):
+        self.reads = reads
+        self.writes = writes
+        self.mustWrites = mustWrites
+        self.understood = understood # if the subroutine is known to return to its caller, with the effects above
+
+class Liveness:
+    LOCATIONS = ["A", "X", "Y", "C", "Z", "V", "N"]
+    ALL = (1 << len(LOCATIONS)) - 1
+    FLAGS = 0x78 # C, Z, V, N
+    # Instruction type : (registers/flags used, registers/flags defined), not including index registers used by the addressing mode.
+    EFFECTS = {
+        MOSInstr_ADC : ("A C", "A C Z V N"), MOSInstr_SBC : ("A C", "A C Z V N"),
+        MOSInstr_AND : ("A", "A Z N"), MOSInstr_ORA : ("A", "A Z N"), MOSInstr_EOR : ("A", "A Z N"),
+        MOSInstr_BIT : ("A", "Z V N"),
+        MOSInstr_CMP : ("A", "C Z N"), MOSInstr_CPX : ("X", "C Z N"), MOSInstr_CPY : ("Y", "C Z N"),
+        MOSInstr_BCC : ("C", ""), MOSInstr_BCS : ("C", ""), MOSInstr_BEQ : ("Z", ""), MOSInstr_BNE : ("Z", ""),
+        MOSInstr_BMI : ("N", ""), MOSInstr_BPL : ("N", ""), MOSInstr_BVC : ("V", ""), MOSInstr_BVS : ("V", ""),
+        MOSInstr_CLC : ("", "C"), MOSInstr_SEC : ("", "C"), MOSInstr_CLV : ("", "V"),
+        MOSInstr_CLD : ("", ""), MOSInstr_SED : ("", ""), MOSInstr_CLI : ("", ""), MOSInstr_SEI : ("", ""), MOSInstr_NOP : ("", ""),
+        MOSInstr_INC : ("", "Z N"), MOSInstr_DEC : ("", "Z N"),
+        MOSInstr_INX : ("X", "X Z N"), MOSInstr_DEX : ("X", "X Z N"), MOSInstr_INY : ("Y", "Y Z N"), MOSInstr_DEY : ("Y", "Y Z N"),
+        MOSInstr_LDA : ("", "A Z N"), MOSInstr_LDX : ("", "X Z N"), MOSInstr_LDY : ("", "Y Z N"),
+        MOSInstr_STA : ("A", ""), MOSInstr_STX : ("X", ""), MOSInstr_STY : ("Y", ""),
+        MOSInstr_TAX : ("A", "X Z N"), MOSInstr_TAY : ("A", "Y Z N"), MOSInstr_TXA : ("X", "A Z N"), MOSInstr_TYA : ("Y", "A Z N"),
+        MOSInstr_TSX : ("", "X Z N"), MOSInstr_TXS : ("X", ""),
+        MOSInstr_PHA : ("A", ""), MOSInstr_PLA : ("", "A Z N"), MOSInstr_PHP : ("C Z V N", ""), MOSInstr_PLP : ("", "C Z V N"),
+        MOSInstr_JMP : ("", ""), MOSInstr_JSR : ("", ""), MOSInstr_RTS : ("", ""),
+    }
+    SHIFT_EFFECTS = { MOSInstr_ASL : ("", "C Z N"), MOSInstr_LSR : ("", "C Z N"), MOSInstr_ROL : ("C", "C Z N"), MOSInstr_ROR : ("C", "C Z N") }
+
+    def __init__(self, rom, prgRom, opaqueAddresses):
+        """Determines what is live after every instruction of the given PRG-ROM, where runtime code reads everything at the given addresses."""
+        self.__opaqueAddresses = opaqueAddresses
+        self.__liveAfter = {} # instruction address : bit mask of live locations after it
+        self.__summaries = {} # subroutine address : SubroutineSummary
+        self.__FindSubroutines(rom, prgRom)
+        self.__Summarize(rom, prgRom)
+        self.__Propagate(rom, prgRom)
+
+    @staticmethod
+    def getMask(names):
+        """Obtains the bit mask of the given space separated register/flag names."""
+        return sum([1 << Liveness.LOCATIONS.index(name) for name in names.split()])
+
+    @staticmethod
+    def getNames(mask):
+        """Obtains the register/flag names in the given bit mask."""
+        return [name for x, name in enumerate(Liveness.LOCATIONS) if mask & (1 << x)]
+
+    def getLiveAfter(self, address):
+        """Obtains the bit mask of registers/flags which may be read after the instruction at the given address (all of them if we don't know)."""
+        return self.__liveAfter.get(address, self.ALL)
+
+    def getSummaries(self):
+        """Obtains the summary of every subroutine (JSR target), by address."""
+        return self.__summaries
+
+    def getEffects(self, instruction):
+        """Obtains the (used, defined) bit masks of the given instruction on its own (None for instructions we don't follow)."""
+        instrType = type(instruction.definition)
+        mode = instruction.definition.mode
+        if(instrType in self.SHIFT_EFFECTS):
+            used, defined = [self.getMask(names) for names in self.SHIFT_EFFECTS[instrType]]
+            if(mode == MOSAddressingMode.ACCUMULATOR):
+                used, defined = used | self.getMask("A"), defined | self.getMask("A")
+        elif(instrType in self.EFFECTS):
+            used, defined = [self.getMask(names) for names in self.EFFECTS[instrType]]
+        else:
+            return None
+        if(mode in {MOSAddressingMode.ZERO_PAGE_X, MOSAddressingMode.ABSOLUTE_X, MOSAddressingMode.INDIRECT_X}):
+            used |= self.getMask("X")
+        elif(mode in {MOSAddressingMode.ZERO_PAGE_Y, MOSAddressingMode.ABSOLUTE_Y, MOSAddressingMode.INDIRECT_Y}):
+            used |= self.getMask("Y")
+        return (used, defined)
+
+    def __GetTarget(self, rom, prgRom, instruction):
+        """Obtains the code section address the given branch/jump/JSR goes to (None if it's runtime calculated, or not in the PRG-ROM)."""
+        if(instruction.definition.mode == MOSAddressingMode.INDIRECT or instruction.address in prgRom.computedJumps):
+            return None
+        offset = prgRom.resolveJumpOffset(rom, instruction)
+        if(offset == None):
+            return None
+        address = NESMemory.offsetToPointer(offset)
+        return address if address in prgRom.codeSections else None
+
+    def __GetSuccessors(self, rom, prgRom, section):
+        """Obtains the code section addresses the given code section continues at without a call (None among them if we can't follow it)."""
+        successors = []
+        for instruction in section.instructions:
+            if(instruction.address in prgRom.computedJumps):
+                targets = prgRom.computedJumps[instruction.address]
+                successors.extend([target if target in prgRom.codeSections else None for target in targets] if len(targets) > 0 else [None])
+            elif(instruction.definition.isJumpOrBranch and type(instruction.definition) not in {MOSInstr_JSR, MOSInstr_RTS, MOSInstr_RTI}):
+                successors.append(self.__GetTarget(rom, prgRom, instruction))
+        if(len(section.instructions) > 0 and not section.instructions[-1].definition.marksEndOfSection):
+            nextAddress = section.address + section.getSize()
+            successors.append(nextAddress if nextAddress in prgRom.codeSections else None)
+        return successors
+
+    def __GetReachableSections(self, rom, prgRom, addresses):
+        """Obtains the code section addresses reachable from the given ones without a call (None among them if we can't follow them all)."""
+        reachable = set([])
+        pending = list(addresses)
+        while(len(pending) > 0):
+            address = pending.pop()
+            if(address in reachable):
+                continue
+            reachable.add(address)
+            if(address != None):
+                pending.extend(self.__GetSuccessors(rom, prgRom, prgRom.codeSections[address]))
+        return reachable
+
+    def __MayLeaveSubroutine(self, instruction):
+        """Determines if the given instruction may keep a subroutine from returning to its caller (by changing or writing the stack)."""
+        instrType = type(instruction.definition)
+        if(instrType in {MOSInstr_TXS, MOSInstr_RTI, MOSInstr_BRK}):
+            return True
+        if(instrType not in {MOSInstr_STA, MOSInstr_STX, MOSInstr_STY, MOSInstr_ASL, MOSInstr_DEC, MOSInstr_INC, MOSInstr_LSR, MOSInstr_ROL, MOSInstr_ROR}):
+            return False
+        mode = instruction.definition.mode
+        if(mode in {MOSAddressingMode.ACCUMULATOR, MOSAddressingMode.ZERO_PAGE, MOSAddressingMode.ZERO_PAGE_X, MOSAddressingMode.ZERO_PAGE_Y}):
+            return False
+        if(mode == MOSAddressingMode.ABSOLUTE):
+            addresses = [instruction.operand]
+        elif(mode == MOSAddressingMode.ABSOLUTE_X or mode == MOSAddressingMode.ABSOLUTE_Y):
+            addresses = range(instruction.operand, instruction.operand + 0x100)
+        else:
+            return True
+        return any(address < 0x2000 and (address & 0x7FF) >> 8 == 1 for address in addresses)
+
+    def __FindSubroutines(self, rom, prgRom):
+        """Determines every subroutine's code sections and call sites, and which RTS return to known call sites."""
+        self.__bodies = {} # subroutine address : code section addresses
+        self.__callSites = {} # subroutine address : JSR instructions
+        self.__instructions = dict([(instruction.address, instruction) for section in prgRom.codeSections.values() for instruction in section.instructions])
+        for instruction in self.__instructions.values():
+            if(type(instruction.definition) is MOSInstr_JSR):
+                target = self.__GetTarget(rom, prgRom, instruction)
+                if(target != None):
+                    self.__callSites.setdefault(target, []).append(instruction)
+        for address in self.__callSites:
+            self.__bodies[address] = self.__GetReachableSections(rom, prgRom, [address])
+
+        # Code reachable any other way than a JSR (interrupts, runtime calculated jumps, the interpreter) returns somewhere we don't know.
+        instructionsByOffset = dict([(instruction.offset, instruction) for instruction in self.__instructions.values()])
+        def isFollowed(referencedBy):
+            instruction = instructionsByOffset.get(referencedBy)
+            return instruction != None and (instruction.definition.mode == MOSAddressingMode.RELATIVE or (type(instruction.definition) in {MOSInstr_JMP, MOSInstr_JSR} and instruction.definition.mode == MOSAddressingMode.ABSOLUTE))
+        computedTargets = set([target for targets in prgRom.computedJumps.values() for target in targets])
+        roots = [address for address, section in prgRom.codeSections.items() if address in computedTargets or section.referenceType == PRGROMCodeSectionType.INTERRUPT or any(not isFollowed(referencedBy) for referencedBy in section.referencedBy)]
+        self.__unknownReturns = self.__GetReachableSections(rom, prgRom, roots)
+        if(prgRom.hasUnresolvedJumps()):
+            self.__unknownReturns = set(prgRom.codeSections.keys())
+
+        # The subroutines (by code section address) each RTS returns from.
+        self.__returnsFrom = {}
+        for address, body in self.__bodies.items():
+            for sectionAddress in body:
+                if(sectionAddress != None):
+                    self.__returnsFrom.setdefault(sectionAddress, []).append(address)
+
+    def __Summarize(self, rom, prgRom):
+        """Determines every subroutine's summary, iterating over the call graph until none change."""
+        for address, body in self.__bodies.items():
+            instructions = [instruction for sectionAddress in body if sectionAddress != None for instruction in prgRom.codeSections[sectionAddress].instructions]
+            pushes = len([instruction for instruction in instructions if type(instruction.definition) in {MOSInstr_PHA, MOSInstr_PHP}])
+            pulls = len([instruction for instruction in instructions if type(instruction.definition) in {MOSInstr_PLA, MOSInstr_PLP}])
+            understood = None not in body and pulls <= pushes and not any(self.__MayLeaveSubroutine(instruction) or self.getEffects(instruction) == None for instruction in instructions)
+            if(understood):
+                self.__summaries[address] = SubroutineSummary(0, 0, self.ALL, True)
+            else:
+                self.__summaries[address] = SubroutineSummary(self.ALL, self.ALL, 0, False)
+
+        changed = True
+        while(changed):
+            changed = False
+            for address in sorted(self.__bodies.keys()):
+                summary = self.__summaries[address]
+                if(not summary.understood):
+                    continue
+                reads = self.__GetLiveIn(rom, prgRom, address, self.__bodies[address])
+                writes, mustWrites = self.__GetWrites(rom, prgRom, address, self.__bodies[address])
+                if((reads, writes, mustWrites) != (summary.reads, summary.writes, summary.mustWrites)):
+                    summary.reads, summary.writes, summary.mustWrites = reads, writes, mustWrites
+                    changed = True
+
+    def __GetCallEffects(self, rom, prgRom, instruction):
+        """Obtains the (read, written, written along every path) bit masks of the subroutine the given JSR calls."""
+        summary = self.__summaries.get(self.__GetTarget(rom, prgRom, instruction))
+        if(summary == None):
+            return (self.ALL, self.ALL, 0)
+        return (summary.reads, summary.writes, summary.mustWrites)
+
+    def __Transfer(self, rom, prgRom, instruction, liveOut):
+        """Obtains what is live before the given instruction, given what is live after it."""
+        if(instruction.address in self.__opaqueAddresses):
+            return self.ALL
+        if(type(instruction.definition) is MOSInstr_JSR):
+            reads, writes, mustWrites = self.__GetCallEffects(rom, prgRom, instruction)
+            return reads | (liveOut & ~mustWrites)
+        effects = self.getEffects(instruction)
+        if(effects == None):
+            return self.ALL
+        used, defined = effects
+        return used | (liveOut & ~defined)
+
+    def __GetLiveOut(self, rom, prgRom, section, x, liveIn, returnLive):
+        """Obtains what is live after the instruction at the given index of the given section, given what is live at the start of each section."""
+        instruction = section.instructions[x]
+        instrType = type(instruction.definition)
+        if(x + 1 < len(section.instructions)):
+            liveOut = liveIn(section.instructions[x + 1].address)
+        elif(not instruction.definition.marksEndOfSection):
+            liveOut = liveIn(section.address + section.getSize())
+        else:
+            liveOut = 0
+        if(instruction.address in prgRom.computedJumps or instrType in {MOSInstr_RTI, MOSInstr_BRK} or (instrType is MOSInstr_JMP and instruction.definition.mode == MOSAddressingMode.INDIRECT)):
+            return self.ALL
+        if(instrType is MOSInstr_RTS):
+            return returnLive(section.address)
+        if(instruction.definition.isJumpOrBranch and instrType is not MOSInstr_JSR):
+            target = self.__GetTarget(rom, prgRom, instruction)
+            liveOut |= liveIn(target) if target != None else self.ALL
+        return liveOut
+
+    def __Solve(self, rom, prgRom, sectionAddresses, returnLive):
+        """Determines what is live after every instruction in the given code sections (everything is live outside them), until nothing changes."""
+        liveAfter = {}
+        sectionLiveIn = {}
+        def liveIn(address):
+            if(address not in sectionAddresses):
+                return self.ALL
+            return sectionLiveIn.get(address, 0)
+        changed = True
+        while(changed):
+            changed = False
+            for address in sorted([address for address in sectionAddresses if address != None], reverse=True):
+                section = prgRom.codeSections[address]
+                instructionLiveIn = {}
+                def liveInAt(target):
+                    return instructionLiveIn[target] if target in instructionLiveIn else liveIn(target)
+                live = 0
+                for x in range(len(section.instructions) - 1, -1, -1):
+                    instruction = section.instructions[x]
+                    liveOut = self.__GetLiveOut(rom, prgRom, section, x, liveInAt, returnLive)
+                    liveAfter[instruction.address] = liveOut
+                    live = self.__Transfer(rom, prgRom, instruction, liveOut)
+                    instructionLiveIn[instruction.address] = live
+                if(live != sectionLiveIn.get(address, 0)):
+                    sectionLiveIn[address] = live
+                    changed = True
+        return (liveAfter, sectionLiveIn)
+
+    def __GetLiveIn(self, rom, prgRom, address, body):
+        """Obtains what the subroutine at the given address reads before writing it (nothing is live after its RTS)."""
+        liveAfter, sectionLiveIn = self.__Solve(rom, prgRom, body, lambda sectionAddress: 0)
+        return sectionLiveIn.get(address, 0)
+
+    def __GetWrites(self, rom, prgRom, address, body):
+        """Obtains what the subroutine at the given address may write, and what it writes along every path to its RTS."""
+        writes = 0
+        definedBefore = { address : 0 } # code section address : written along every path to it
+        mustWrites = self.ALL
+        pending = [address]
+        while(len(pending) > 0):
+            sectionAddress = pending.pop()
+            section = prgRom.codeSections[sectionAddress]
+            defined = definedBefore[sectionAddress]
+            for instruction in section.instructions:
+                if(type(instruction.definition) is MOSInstr_JSR):
+                    reads, calleeWrites, calleeMustWrites = self.__GetCallEffects(rom, prgRom, instruction)
+                    writes |= calleeWrites
+                    defined |= calleeMustWrites
+                else:
+                    writes |= self.getEffects(instruction)[1]
+                    defined |= self.getEffects(instruction)[1]
+                if(type(instruction.definition) is MOSInstr_RTS):
+                    mustWrites &= defined
+            for successor in self.__GetSuccessors(rom, prgRom, section):
+                if(successor not in definedBefore or (definedBefore[successor] & defined) != definedBefore[successor]):
+                    definedBefore[successor] = definedBefore[successor] & defined if successor in definedBefore else defined
+                    pending.append(successor)
+        return (writes, mustWrites)
+
+    def __Propagate(self, rom, prgRom):
+        """Determines what is live after every instruction, where each RTS returns to the instructions following its subroutine's JSRs."""
+        returnLive = {} # subroutine address : live after its JSRs
+        def getReturnLive(sectionAddress):
+            if(sectionAddress in self.__unknownReturns or sectionAddress not in self.__returnsFrom):
+                return self.ALL
+            live = 0
+            for address in self.__returnsFrom[sectionAddress]:
+                if(not self.__summaries[address].understood):
+                    return self.ALL
+                live |= returnLive.get(address, 0)
+            return live
+        sectionAddresses = set(prgRom.codeSections.keys())
+        while(True):
+            self.__liveAfter, sectionLiveIn = self.__Solve(rom, prgRom, sectionAddresses, getReturnLive)
+            updated = dict([(address, 0) for address in self.__callSites])
+            for address, instructions in self.__callSites.items():
+                for instruction in instructions:
+                    updated[address] |= self.__liveAfter[instruction.address]
+            if(updated == returnLive):
+                break
+            returnLive = updated
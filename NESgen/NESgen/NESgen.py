@@ -4,11 +4,11 @@ NESgen - A NES->C compiler.
 '''
 from iNESROM import iNESROM
 from iNESROMDisassembler import iNESROMDisassembler
-import getopt, sys
+import getopt, re, sys
 
 def usage():
 	"""Prints the usage for the application"""
-	print("NESgen.py [-n] -i <input.NES> -c <game.c> -h <game.h>")
+	print("NESgen.py [-n] [-f] [-l] [-m] [-d] [-r] [-k] [-u] [-e] [-x] [-o] [-v] [-w] [-j] [-z] [-p] [-t <targets.txt>] [-g] [-P <profile>] [-s <shards>] [-b] [-G <name>] -i <input.NES> -c <game.c> -h <game.h>")
 	print("Options:")
 	print("-i")
 	print("\tInput path for the .NES ROM file.")
@@ -20,6 +20,47 @@ def usage():
 	print("\tNo readability-based optimizations enabled.")
 	print("-f")
 	print("\tMake full PRG-ROM data available, instead of just predicted data sections.")
+	print("-l")
+	print("\tNo loop idioms (counted store/copy loops are not executed in bulk).")
+	print("-m")
+	print("\tMonolithic output (subroutines are not output as their own C functions).")
+	print("-d")
+	print("\tNo dense jump tables (jump tables are only output as switches, not computed goto tables).")
+	print("-r")
+	print("\tNo register promotion (registers are always accessed through the registers structure, not local variables).")
+	print("-k")
+	print("\tNo constant folding (values known at compile time are still computed at runtime, and all branches are tested).")
+	print("-u")
+	print("\tNo peephole fusion (common instruction sequences are output instruction by instruction, not as single operations).")
+	print("-e")
+	print("\tNo subroutine inlining (small leaf subroutines are called rather than output at each call, and JSR / RTS tail calls return through the RTS).")
+	print("-x")
+	print("\tNo dead result removal (registers and flags are computed even where liveness analysis finds they're never read).")
+	print("-o")
+	print("\tNo loop structuring (loops are output as gotos, not do/while loops, and always sync every instruction).")
+	print("-v")
+	print("\tNo loop unrolling (loops iterating a known number of times are still output as loops).")
+	print("-w")
+	print("\tNo known routine HLE (recognized multiply/divide/decimal/random number subroutines execute instruction by instruction, not natively).")
+	print("-j")
+	print("\tReturn stack (JSR pushes its return address onto the stack and RTS dispatches to it, instead of calling subroutines, implies -m).")
+	print("-z")
+	print("\tMemoize subroutines (subroutines which only depend on registers, flags and a few RAM addresses cache their results by them, has no effect with -m or -j).")
+	print("-p")
+	print("\tPrune runtime locations (only instructions pointed to by data are labeled, jumps elsewhere are interpreted).")
+	print("-t")
+	print("\tPath of a list of hexadecimal runtime jump targets to label (one per line), implies -p.")
+	print("-g")
+	print("\tInstrument for profiling (NESsys writes an execution profile on exit, for use with -P).")
+	print("-P")
+	print("\tPath of an execution profile to tune the output with (adds code it saw executed, orders code hot to cold, hints branches).")
+	print("-s")
+	print("\tSplit subroutine functions across this many C source files (game.c, game_1.c, ...), so they compile in parallel.")
+	print("-G")
+	print("\tPrefix the game's symbols with this name and register it in games_list.h (next to the header), so one NESsys binary built with")
+	print("\tAPPLICATION_MULTIPLE_GAMES can link in every game generated into the directory, and run the one named on its command line.")
+	print("-b")
+	print("\tWrite PRG-ROM and CHR-ROM data to binary files next to the C source, linked in as read-only data with .incbin (GCC/Clang), not C arrays.")
 
 if __name__ == "__main__":
 	# For debugging:
@@ -27,7 +68,7 @@ if __name__ == "__main__":
 
 	# Attempt to obtain our options/arguments.
 	try:
-		opts, args = getopt.getopt(sys.argv[1:],"i:c:h:fn",[])
+		opts, args = getopt.getopt(sys.argv[1:],"i:c:h:t:P:s:G:fnlmdrkuexovwjzpgb",[])
 	except getopt.GetoptError as err:
 		print(err)
 		usage()
@@ -49,6 +90,67 @@ if __name__ == "__main__":
 		elif opt == "-f":
 			# Provide data access to entire PRG-ROM instead of just determined data sections
 			iNESROMDisassembler.OUTPUT_FULL_PRGROM_DATA = True
+		elif opt == "-l":
+			# Execute every loop instruction by instruction
+			iNESROMDisassembler.ALLOW_LOOP_IDIOMS = False
+		elif opt == "-m":
+			# Output all code in game_execute()
+			iNESROMDisassembler.ALLOW_SUBROUTINE_FUNCTIONS = False
+		elif opt == "-d":
+			# Dispatch jumps through switches only
+			iNESROMDisassembler.ALLOW_COMPUTED_GOTO_DISPATCH = False
+		elif opt == "-r":
+			# Access registers through the registers structure only
+			iNESROMDisassembler.ALLOW_REGISTER_PROMOTION = False
+		elif opt == "-k":
+			# Don't propagate or fold constants
+			iNESROMDisassembler.ALLOW_CONSTANT_FOLDING = False
+		elif opt == "-u":
+			# Output every instruction on its own
+			iNESROMDisassembler.ALLOW_PEEPHOLE_FUSION = False
+		elif opt == "-e":
+			# Call every subroutine
+			iNESROMDisassembler.ALLOW_SUBROUTINE_INLINING = False
+		elif opt == "-x":
+			# Compute every register and flag
+			iNESROMDisassembler.ALLOW_DEAD_RESULT_REMOVAL = False
+		elif opt == "-o":
+			# Output every loop with gotos
+			iNESROMDisassembler.ALLOW_LOOP_STRUCTURING = False
+		elif opt == "-v":
+			# Iterate every loop at runtime
+			iNESROMDisassembler.ALLOW_LOOP_UNROLLING = False
+		elif opt == "-w":
+			# Execute every subroutine instruction by instruction
+			iNESROMDisassembler.ALLOW_KNOWN_ROUTINES = False
+		elif opt == "-j":
+			# Return through the stack
+			iNESROMDisassembler.USE_RETURN_STACK = True
+		elif opt == "-z":
+			# Cache subroutine results
+			iNESROMDisassembler.MEMOIZE_SUBROUTINES = True
+		elif opt == "-p":
+			# Label only plausible runtime jump targets
+			iNESROMDisassembler.PRUNE_RUNTIME_LOCATIONS = True
+		elif opt == "-t":
+			# Label the given runtime jump targets
+			iNESROMDisassembler.PRUNE_RUNTIME_LOCATIONS = True
+			iNESROMDisassembler.RUNTIME_LOCATION_TARGETS_PATH = arg
+		elif opt == "-g":
+			# Record an execution profile at runtime
+			iNESROMDisassembler.INSTRUMENT_PROFILING = True
+		elif opt == "-P":
+			# Tune the output with an execution profile
+			iNESROMDisassembler.PROFILE_PATH = arg
+		elif opt == "-s":
+			# Split the C source into shards
+			iNESROMDisassembler.SOURCE_SHARDS = max(int(arg), 1)
+		elif opt == "-G":
+			# Prefix the game's symbols (the name must be usable in C identifiers)
+			iNESROMDisassembler.GAME_SYMBOL_PREFIX = re.sub("^([0-9])", "_\\1", re.sub("[^A-Za-z0-9_]", "_", arg))
+		elif opt == "-b":
+			# Link ROM data in from binary files
+			iNESROMDisassembler.OUTPUT_BINARY_ROM_DATA = True
 		elif opt == "-n":
 			# Marked as "no optimizations"
 			iNESROMDisassembler.ALLOW_FUNCTION_NAME_OVERRIDES = False
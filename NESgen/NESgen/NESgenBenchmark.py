@@ -0,0 +1,146 @@
+'''
+NESgen Benchmark - Times how long NESgen takes to generate C for the sprint test ROMs, and to discover
+the code and data sections of synthetic PRG-ROMs up to 512KB (to check discovery scales linearly with PRG-ROM size).
+Optionally times how long the C compiler takes to compile the generated C as one source file, and split across shards.
+'''
+from iNESROM import iNESROM
+from iNESROMDisassembler import iNESROMDisassembler
+from PRGROM import PRGROM
+import contextlib, getopt, glob, io, os, subprocess, sys, tempfile, time
+
+def usage():
+	"""Prints the usage for the application"""
+	print("NESgenBenchmark.py [-r <repeats>] [-s <synthetic KB>] [-c <shards>] [<input.NES>...]")
+	print("Options:")
+	print("-r")
+	print("\tTimes every measurement this many times, reporting the fastest (default 3).")
+	print("-s")
+	print("\tLargest synthetic PRG-ROM size in KB, timed along with each power of two size from 64KB up to it (default 512, 0 for none).")
+	print("-c")
+	print("\tAlso time compiling the generated C (with $CC, cc by default) as one source file and as this many shards, compiling shards in parallel.")
+	print("\tInput ROMs default to the sprint test suite.")
+
+def measure(repeats, function):
+	"""Obtains the fastest time in seconds the given function took over the given amount of runs (its output is discarded)."""
+	best = None
+	for x in range(0, repeats):
+		with contextlib.redirect_stdout(io.StringIO()):
+			start = time.perf_counter()
+			function()
+			elapsed = time.perf_counter() - start
+		best = elapsed if best is None else min(best, elapsed)
+	return best
+
+def generate(rom, directory):
+	"""Generates C source and header files for the given ROM into the given directory."""
+	iNESROMDisassembler().DisassembleToC(rom, os.path.join(directory, "game.c"), os.path.join(directory, "game.h"))
+
+def compileSources(directory, jobs):
+	"""
+	Compiles the generated C source files in the given directory, up to the given amount at once.
+	Returns the wall-clock time in seconds it took, and the longest time any one source file took.
+	"""
+	includeDirectory = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "NESsys", "src")
+	command = [os.environ.get("CC", "cc"), "-O2", "-fcommon", "-w", "-I", directory, "-I", includeDirectory, "-c", "-o", os.devnull]
+	pending = sorted(glob.glob(os.path.join(directory, "*.c")))
+	running = [] # (process, start time)
+	longest = 0
+	start = time.perf_counter()
+	while len(pending) > 0 or len(running) > 0:
+		while len(pending) > 0 and len(running) < jobs:
+			running.append((subprocess.Popen(command + [pending.pop(0)]), time.perf_counter()))
+		process, processStart = running.pop(0)
+		if(process.wait() != 0):
+			raise RuntimeError("Compiling the generated C failed.")
+		longest = max(longest, time.perf_counter() - processStart)
+	return time.perf_counter() - start, longest
+
+def synthesize(size):
+	"""
+	Creates a ROM with a PRG-ROM of the given size in KB, 7/8 code and 1/8 data. The code is a chain of blocks which each branch forward into
+	the middle of themselves and back to their start (so discovery splits every block and follows the whole chain from the reset vector).
+	"""
+	prgRom = bytearray()
+	codeSize = (size * 0x400 * 7) // 8
+	while len(prgRom) + 8 < codeSize:
+		# LDA #$01 / BEQ +2 / INX / INX / BNE -8
+		prgRom += bytes([0xA9, 0x01, 0xF0, 0x02, 0xE8, 0xE8, 0xD0, 0xF8])
+	prgRom += bytes([0x60]) # RTS
+	while len(prgRom) < (size * 0x400) - 6:
+		prgRom.append((len(prgRom) * 0x9D) & 0xFF)
+	prgRom += bytes([0x00, 0x80] * 3) # NMI, reset and IRQ vectors (0x8000)
+	header = bytes([0x4E, 0x45, 0x53, 0x1A, len(prgRom) // iNESROM.PRG_ROM_BANK_SIZE, 1, 0, 0]) + bytes(8)
+	return iNESROM(header + bytes(prgRom) + bytes(iNESROM.CHR_ROM_BANK_SIZE))
+
+if __name__ == "__main__":
+	# Attempt to obtain our options/arguments.
+	try:
+		opts, args = getopt.getopt(sys.argv[1:],"r:s:c:",[])
+	except getopt.GetoptError as err:
+		print(err)
+		usage()
+		sys.exit(2)
+
+	repeats = 3
+	syntheticSize = 512
+	shards = None
+	for opt, arg in opts:
+		if opt == "-r":
+			repeats = int(arg)
+		elif opt == "-s":
+			syntheticSize = int(arg)
+		elif opt == "-c":
+			shards = max(int(arg), 1)
+	romPaths = args
+	if(len(romPaths) == 0):
+		testSuite = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "sprints", "sprint4", "testSuite")
+		romPaths = sorted([os.path.join(testSuite, name) for name in os.listdir(testSuite) if name.lower().endswith(".nes")])
+
+	# Time discovery, and generating the C files, for every ROM given.
+	print("{:20} {:>8} {:>10} {:>14} {:>14}".format("ROM", "PRG KB", "Sections", "Discovery (s)", "Generation (s)"))
+	total = 0
+	with tempfile.TemporaryDirectory() as directory:
+		for romPath in romPaths:
+			with open(romPath, mode='rb') as file:
+				rom = iNESROM(file.read())
+			with contextlib.redirect_stdout(io.StringIO()):
+				sectionCount = len(PRGROM(rom).codeSections)
+			discovery = measure(repeats, lambda: PRGROM(rom))
+			generation = measure(repeats, lambda: generate(rom, directory))
+			total += generation
+			print("{:20} {:>8} {:>10} {:>14.3f} {:>14.3f}".format(os.path.splitext(os.path.basename(romPath))[0], len(rom.prgRom) // 0x400, sectionCount, discovery, generation))
+	print("Total generation time: {:.3f}s".format(total))
+
+	# Time compiling the generated C for every ROM given, as one source file and split across shards (compiled in parallel).
+	if(shards != None):
+		jobs = os.cpu_count() or 1
+		print("")
+		print("{:20} {:>14} {:>14} {:>14}".format("ROM", "1 shard (s)", "{} shards (s)".format(shards), "Longest (s)"))
+		totals = [0, 0]
+		for romPath in romPaths:
+			with open(romPath, mode='rb') as file:
+				rom = iNESROM(file.read())
+			times = []
+			for shardCount in [1, shards]:
+				with tempfile.TemporaryDirectory() as directory:
+					iNESROMDisassembler.SOURCE_SHARDS = shardCount
+					with contextlib.redirect_stdout(io.StringIO()):
+						generate(rom, directory)
+					times.append(compileSources(directory, jobs))
+			iNESROMDisassembler.SOURCE_SHARDS = 1
+			totals = [totals[0] + times[0][0], totals[1] + times[1][0]]
+			print("{:20} {:>14.3f} {:>14.3f} {:>14.3f}".format(os.path.splitext(os.path.basename(romPath))[0], times[0][0], times[1][0], times[1][1]))
+		print("Total compile time: {:.3f}s with 1 shard, {:.3f}s with {} shards ({} compiled at once, the longest shard bounds it with enough cores).".format(totals[0], totals[1], shards, jobs))
+
+	# Time discovery for synthetic PRG-ROMs doubling in size (the time per KB should stay about the same).
+	if(syntheticSize > 0):
+		print("")
+		print("{:20} {:>8} {:>10} {:>14} {:>14}".format("Synthetic", "PRG KB", "Sections", "Discovery (s)", "ms per KB"))
+		size = min(64, syntheticSize)
+		while size <= syntheticSize:
+			rom = synthesize(size)
+			with contextlib.redirect_stdout(io.StringIO()):
+				sectionCount = len(PRGROM(rom).codeSections)
+			discovery = measure(repeats, lambda: PRGROM(rom))
+			print("{:20} {:>8} {:>10} {:>14.3f} {:>14.3f}".format("synthetic", size, sectionCount, discovery, (discovery * 1000) / size))
+			size *= 2
@@ -2,6 +2,7 @@
 # Reference: https://wiki.nesdev.com/w/index.php/INES
 from MOS6502Instructions import *
 from NESMemory import NESMemory
+import bisect
 
 class PRGROMCodeSectionType(Enum):
     """Describes the type of code section (based off how it is called). Higher indexes override lower if multiple."""
@@ -33,7 +34,8 @@ class PRGROMCodeSection:
     def addRef(self, referenceType, referencedByOffset):
         """Adds a reference to the code section from the given offset, and changes code section type accordingly."""
         self.referencedBy.add(referencedByOffset)
-        self.sectionType = max(self.referenceType, referenceType) if self.referenceType != None else referenceType
+        if(self.referenceType == None or referenceType.value > self.referenceType.value):
+            self.referenceType = referenceType
         
     def getSize(self):
         """Obtains the size of the code section."""
@@ -65,6 +67,25 @@ class PRGROMCodeSection:
         # This indicates we may have overlapping instructions which we can handle separately.
         return None
     
+class PRGROMValueType(Enum):
+    """Describes what is known about a byte value during static analysis."""
+    CONSTANT = 0 # value
+    INDEX = 1 # (scale * symbol) + base, where symbol is an unknown byte
+    TABLE = 2 # the PRG-ROM byte at base + (scale * symbol), where symbol is an unknown byte
+    
+class PRGROMValue:
+    """Describes a byte value during static analysis of the code leading up to a runtime calculated jump."""
+    valueType = None
+    base = 0 # constant value, or base address/offset
+    symbol = None # identifies an unknown byte (values built from the same unknown byte share it)
+    scale = 1
+    
+    def __init__(self, valueType, base, symbol=None, scale=1):
+        self.valueType = valueType
+        self.base = base
+        self.symbol = symbol
+        self.scale = scale
+    
 class PRGROMDataSection:
     """Describes a data section in the PRG-ROM. Determined by sections which are not code sections."""
     address = 0 # address in memory
@@ -83,39 +104,60 @@ class PRGROMDataSection:
     
 class PRGROM:
     """Describes a PRG-ROM within an iNES ROM. Parses underlying code/data sections."""
+    COMPUTED_JUMP_DECODE_INSTRUCTIONS = 16 # instructions decoded to validate a jump table entry is code
     codeSections = {} # address : PRGROMCodeSection
     dataSections = {} # address : PRGROMDataSection
     interruptNMI, interruptReset, interruptIRQ = None, None, None
+    computedJumps = {} # address of an indirect JMP or RTS dispatch : list of statically resolved target addresses (empty if unresolved)
     size = 0
-    def __init__(self, rom):
-        """Initializes the appropriate members to begin parsing underlying structure."""
+    def __init__(self, rom, profile=None):
+        """Initializes the appropriate members to begin parsing underlying structure (with code an execution profile observed, if given)."""
         # Determine code sections
         self.size = len(rom.prgRom)
         self.codeSections = {}
+        self.__sectionAddresses = [] # code section addresses in ascending order (to find the code section encompassing an address)
         self.dataSections = {}
+        self.computedJumps = {}
         self.__findCodeSections(rom)
+        if(profile != None):
+            self.__findProfiledCodeSections(rom, profile)
+        self.__resolveComputedJumps(rom)
         self.__findDataSections(rom)
         
     def __findDataSections(self, rom):
         """Discovers underlying data sections (for use after code sections have been mapped)."""
-        # Find all places where code sections are not defined.
+        # Find all places where code sections are not defined (the gaps between code sections, in order).
         offset = 0
-        while offset < len(rom.prgRom):
-            address = NESMemory.offsetToPointer(offset)
-            if(address in self.codeSections):
-                # Skip over code section
-                offset += self.codeSections[address].getSize()
-            else:
-                # Determine length of data section
-                sectionStart = offset
-                sectionSize = 0
-                while sectionStart + sectionSize < len(rom.prgRom):
-                    sectionSize += 1
-                    if(NESMemory.offsetToPointer(sectionStart + sectionSize) in self.codeSections):
-                        break
-                dataSection = PRGROMDataSection(sectionStart, rom.prgRom[sectionStart:sectionStart+sectionSize])
-                self.dataSections[dataSection.address] = dataSection
-                offset += sectionSize
+        for address in self.__sectionAddresses:
+            codeSection = self.codeSections[address]
+            if(codeSection.offset < offset):
+                # This code section overlaps the one before it (which we skipped over)
+                continue
+            if(codeSection.offset > offset):
+                self.__addDataSection(rom, offset, codeSection.offset)
+            # Skip over code section
+            offset = codeSection.offset + codeSection.getSize()
+        if(offset < len(rom.prgRom)):
+            self.__addDataSection(rom, offset, len(rom.prgRom))
+    
+    def __addDataSection(self, rom, start, end):
+        """Adds a data section for the PRG-ROM between the given offsets."""
+        dataSection = PRGROMDataSection(start, rom.prgRom[start:end])
+        self.dataSections[dataSection.address] = dataSection
+    
+    def __addCodeSection(self, codeSection):
+        """Adds a code section, indexing it by its address."""
+        if(codeSection.address not in self.codeSections):
+            bisect.insort(self.__sectionAddresses, codeSection.address)
+        self.codeSections[codeSection.address] = codeSection
+    
+    def getCodeSectionAt(self, address):
+        """Obtains the code section encompassing the given address (the closest one beginning at or before it), or None if it isn't in a code section."""
+        index = bisect.bisect_right(self.__sectionAddresses, address) - 1
+        if(index < 0):
+            return None
+        codeSection = self.codeSections[self.__sectionAddresses[index]]
+        return codeSection if address < codeSection.address + codeSection.getSize() else None
     
     def __findCodeSections(self, rom):
         """Discovers underlying code sections."""
@@ -125,35 +167,42 @@ class PRGROM:
         self.interruptReset = (rom.prgRom[interruptVectorOffset+3] << 8) | rom.prgRom[interruptVectorOffset+2]
         self.interruptIRQ = (rom.prgRom[interruptVectorOffset+5] << 8) | rom.prgRom[interruptVectorOffset+4]
 
-        # Detect code sections recursively from here.
-        self.__findCodeSectionsRec(rom, self.interruptNMI, interruptVectorOffset, PRGROMCodeSectionType.INTERRUPT)
-        self.__findCodeSectionsRec(rom, self.interruptReset, interruptVectorOffset + 2, PRGROMCodeSectionType.INTERRUPT)
-        self.__findCodeSectionsRec(rom, self.interruptIRQ, interruptVectorOffset + 4, PRGROMCodeSectionType.INTERRUPT)
+        # Detect code sections from here.
+        self.__findCodeSectionsFrom(rom, self.interruptNMI, PRGROMCodeSectionType.INTERRUPT, interruptVectorOffset)
+        self.__findCodeSectionsFrom(rom, self.interruptReset, PRGROMCodeSectionType.INTERRUPT, interruptVectorOffset + 2)
+        self.__findCodeSectionsFrom(rom, self.interruptIRQ, PRGROMCodeSectionType.INTERRUPT, interruptVectorOffset + 4)
         
         
-    def __findCodeSectionsRec(self, rom, address, referenceType, referencedBy):
-        """Recursively discovers code sections, starting with the given reference information."""
-           
-        # Obtain our offset relative to PRG-ROM start.
-        offset = NESMemory.pointerToOffset(rom, address)
-        address = NESMemory.offsetToPointer(offset) # corrects memory mirrored addresses
+    def __findProfiledCodeSections(self, rom, profile):
+        """Discovers code sections at locations an execution profile observed being jumped to (indirect jump targets and dispatcher misses)."""
+        sectionCount = len(self.codeSections)
+        for address in profile.getCodeAddresses():
+            if(address not in self.codeSections):
+                referencedBy = [jumpAddress for jumpAddress in profile.indirectTargets if address in profile.indirectTargets[jumpAddress]]
+                self.__findCodeSectionsFrom(rom, address, PRGROMCodeSectionType.LOCATION, NESMemory.pointerToOffset(rom, referencedBy[0]) if len(referencedBy) > 0 else None)
+        print("Profile: {} code sections discovered from observed runtime calculated jump targets and dispatcher misses.".format(len(self.codeSections) - sectionCount))
         
-        #print("Entering: {}".format(hex(address)))
+    def __beginCodeSection(self, rom, offset, referenceType, referencedBy):
+        """
+        Adds the reference information to the code section at the given offset. 
+        Returns the code section if it must be parsed (it's new, or was split from one still being parsed), otherwise None.
+        """
+        # Obtain our address (offsets past the end of memory mirrored PRG-ROM are mirrored too).
+        if(NESMemory.isMirroredROM(rom)):
+            offset %= len(rom.prgRom)
+        address = NESMemory.offsetToPointer(offset)
         
         # If we have a code section for this address, update the reference and stop
         if(address in self.codeSections):
             self.codeSections[address].addRef(referenceType, referencedBy)
-            return
+            return None
         
         # Check if we have a code section encompassing this address
         splitCodeSection = None
-        for codeSection in self.codeSections.values():
-            if(address > codeSection.address and address < codeSection.address + codeSection.getSize()):
-                # Split the old code section (it's done), and continue by setting our current address/offset to the end of the new split code section.
-                splitCodeSection = codeSection.split(offset)
-                if(splitCodeSection != None):
-                    address = splitCodeSection.address
-                break
+        codeSection = self.getCodeSectionAt(address)
+        if(codeSection != None):
+            # Split the old code section (it's done), and continue by setting our current address/offset to the end of the new split code section.
+            splitCodeSection = codeSection.split(offset)
         
         # Either this is a new section or we encountered overlapping instructions.
         # We parse this as a new section until we detect an end.
@@ -161,45 +210,53 @@ class PRGROM:
         # (which we're okay with since adding advanced control flow logic for this would be difficult)
         codeSection = PRGROMCodeSection(offset) if splitCodeSection == None else splitCodeSection
         codeSection.addRef(referenceType, referencedBy)
-        self.codeSections[address] = codeSection
-
-        # Resume from where we left off.
-        offset = codeSection.offset + codeSection.getSize()
-        address = codeSection.address + codeSection.getSize()
+        self.__addCodeSection(codeSection)
+        return codeSection
+        
+    def __findCodeSectionsFrom(self, rom, address, referenceType, referencedBy):
+        """
+        Discovers code sections, starting with the given reference information.
+        Jump targets are parsed before the code section jumping to them continues (depth first), using a stack of code sections being parsed.
+        """
+        pending = [] # code sections being parsed, the one parsed last on top
+        codeSection = self.__beginCodeSection(rom, NESMemory.pointerToOffset(rom, address), referenceType, referencedBy)
+        if(codeSection != None):
+            pending.append(codeSection)
         
-        # Keep adding instructions while we arn't marked as done 
-        # (split, or reached an instruction that marks end of control flow for this block)
-        while offset < len(rom.prgRom) and not codeSection.done:
+        while len(pending) > 0:
+            codeSection = pending[-1]
+            
+            # If the last instruction we parsed is known to mark the end of a section, or our code section has now been split (done), stop.
+            if(codeSection.done or (len(codeSection.instructions) > 0 and codeSection.instructions[-1].definition.marksEndOfSection)):
+                codeSection.done = True
+                pending.pop()
+                continue
+            
+            # Resume from where we left off.
+            offset = codeSection.offset + codeSection.getSize()
+            address = codeSection.address + codeSection.getSize()
+            if(offset >= len(rom.prgRom)):
+                pending.pop()
+                continue
+            
             # If we're at the start of a code section and it's not this one, stop
             if(address in self.codeSections and self.codeSections.get(address) != codeSection):
                 codeSection.done = True
-                break
+                pending.pop()
+                continue
             
-            # Parse our instruction and increment offset
+            # Parse our instruction
             instruction = MOSInstruction(rom.prgRom, offset)
-            #print("@offset: {}".format(hex(NESMemory.offsetToPointer(offset))))
-            #print("@instr: {}".format(str(instruction)))
-            offset += instruction.definition.size
-            address += instruction.definition.size
             codeSection.addInstruction(instruction)
 
-            # Check our type which is used to determine code flow
-            instrType = type(instruction.definition)
-        
             # Check we have a jump
             jumpOffset = self.resolveJumpOffset(rom, instruction)
             if(jumpOffset != None):
-                # Obtain address and add it as a function (JSR jump) or generic code location.
-                jumpPointer = NESMemory.offsetToPointer(jumpOffset)
-                referenceType = PRGROMCodeSectionType.FUNCTION if instrType is MOSInstr_JSR else PRGROMCodeSectionType.LOCATION
-                self.__findCodeSectionsRec(rom, jumpPointer, referenceType, instruction.offset)
-
-            # If our instruction is known to mark the end of a section, or our code section has now been split (done), or we reached another code section, stop.
-            if(instruction.definition.marksEndOfSection):
-                codeSection.done = True
-                break
-                
-        return
+                # Add it as a function (JSR jump) or generic code location, to be parsed before we continue.
+                jumpReferenceType = PRGROMCodeSectionType.FUNCTION if type(instruction.definition) is MOSInstr_JSR else PRGROMCodeSectionType.LOCATION
+                jumpCodeSection = self.__beginCodeSection(rom, jumpOffset, jumpReferenceType, instruction.offset)
+                if(jumpCodeSection != None):
+                    pending.append(jumpCodeSection)
     
     def resolveJumpOffset(self, rom, instruction):
         """Resolves the offset of a jump instruction's concluding jump."""
@@ -212,7 +269,215 @@ class PRGROM:
                 else:
                     print("Warning: Absolute jump detected at address {} which jumps to an address outside of ROM memory at {}. If this is executed, it will cause an error.".format(hex(instruction.address, hex(instruction.operand))))
             elif(instruction.definition.mode == MOSAddressingMode.INDIRECT):
-                print("Warning: Runtime calculated jump detected at address {} using indirect address {}. This section cannot be guaranteed to have been mapped and may cause an error.".format(hex(instruction.address), hex(instruction.operand)))
+                # Indirect jumps are resolved (where possible) by __resolveComputedJumps.
+                return None
             else:
                 raise ValueError("Unexpected jump mode when scanning code sections.")
-        return None
\ No newline at end of file
+        return None
+    def hasUnresolvedJumps(self):
+        """Determines if any runtime calculated jump could not be resolved statically (so it may jump to any instruction)."""
+        return any(len(targets) == 0 for targets in self.computedJumps.values())
+    
+    def __isCodeOffset(self, offset):
+        """Determines if the given PRG-ROM offset lies within a discovered code section."""
+        return self.getCodeSectionAt(NESMemory.offsetToPointer(offset)) != None
+    
+    def __isDecodableCode(self, rom, offset):
+        """Determines if the code at the given offset decodes to valid instructions, up until its first end of section (or a known code section)."""
+        for x in range(0, self.COMPUTED_JUMP_DECODE_INSTRUCTIONS):
+            if(offset >= len(rom.prgRom) or not MOSInstrExists(rom.prgRom[offset])):
+                return False
+            definition = MOSInstrGet(rom.prgRom[offset])
+            if(offset + definition.size > len(rom.prgRom)):
+                return False
+            if(definition.marksEndOfSection or NESMemory.offsetToPointer(offset + definition.size) in self.codeSections):
+                return True
+            offset += definition.size
+        return True
+    
+    def __readTableByte(self, rom, address):
+        """Reads a byte of a jump table at the given address, or returns None if it can't be part of a table (outside of PRG-ROM or in code)."""
+        if(not NESMemory.isROMMemory(address)):
+            return None
+        offset = NESMemory.pointerToOffset(rom, address)
+        if(offset >= len(rom.prgRom) or self.__isCodeOffset(offset)):
+            return None
+        return rom.prgRom[offset]
+    
+    def __enumerateAddresses(self, rom, low, high, addend):
+        """
+        Obtains every code address the given low/high byte values can form (plus the given addend).
+        Tables are read entry by entry until an entry is invalid. Returns an empty list if the values are unknown.
+        """
+        if(low == None or high == None):
+            return []
+        tables = [value for value in [low, high] if value.valueType == PRGROMValueType.TABLE]
+        if(any(value.valueType == PRGROMValueType.INDEX for value in [low, high])):
+            return []
+        if(len(set([(value.symbol, value.scale) for value in tables])) > 1):
+            return []
+        
+        # Determine how many entries our table can have. Split tables are commonly stored low bytes first, then high bytes.
+        scale = tables[0].scale if len(tables) > 0 else 1
+        entryCount = 1 if len(tables) == 0 else 0x100 // scale
+        if(len(tables) == 2 and high.base > low.base and high.base - low.base >= scale):
+            entryCount = min(entryCount, (high.base - low.base) // scale)
+        
+        addresses = []
+        for x in range(0, entryCount):
+            entryBytes = [self.__readTableByte(rom, value.base + (value.scale * x)) if value.valueType == PRGROMValueType.TABLE else value.base for value in [low, high]]
+            if(None in entryBytes):
+                break
+            address = (((entryBytes[1] << 8) | entryBytes[0]) + addend) & 0xFFFF
+            if(not NESMemory.isROMMemory(address) or NESMemory.pointerToOffset(rom, address) >= len(rom.prgRom) or not self.__isDecodableCode(rom, NESMemory.pointerToOffset(rom, address))):
+                break
+            addresses.append(NESMemory.offsetToPointer(NESMemory.pointerToOffset(rom, address)))
+        return addresses
+    
+    def __analyzeComputedJump(self, rom, codeSection):
+        """
+        Determines the targets of the runtime calculated jump ending the given code section (an indirect JMP, or an RTS to an address 
+        pushed in the same code section), by following how the code section built the address.
+        Returns None if the code section doesn't end in one, otherwise a list of target addresses (empty if they can't be determined).
+        """
+        jump = codeSection.instructions[-1]
+        jumpType = type(jump.definition)
+        if(not (jumpType is MOSInstr_JMP and jump.definition.mode == MOSAddressingMode.INDIRECT) and jumpType is not MOSInstr_RTS):
+            return None
+        
+        # Follow every instruction leading up to the jump, tracking what we know about registers, memory we wrote, and bytes we pushed.
+        # Anything we can't follow becomes a new unknown byte (symbol).
+        symbols = [0]
+        def unknown():
+            symbols[0] += 1
+            return PRGROMValue(PRGROMValueType.INDEX, 0, symbols[0])
+        registers = { "A" : unknown(), "X" : unknown(), "Y" : unknown() }
+        memory = {}
+        stack = []
+        carryClear = False
+        for instruction in codeSection.instructions[:-1]:
+            instrType = type(instruction.definition)
+            mode = instruction.definition.mode
+            
+            # Determine the value this instruction reads (for loads, stores, and arithmetic we can follow)
+            value = None
+            if(mode == MOSAddressingMode.IMMEDIATE):
+                value = PRGROMValue(PRGROMValueType.CONSTANT, instruction.operand)
+            elif(mode == MOSAddressingMode.ABSOLUTE or mode == MOSAddressingMode.ZERO_PAGE):
+                if(NESMemory.isROMMemory(instruction.operand)):
+                    value = PRGROMValue(PRGROMValueType.CONSTANT, rom.prgRom[NESMemory.pointerToOffset(rom, instruction.operand)])
+                else:
+                    value = memory.get(instruction.operand, None)
+            elif(mode == MOSAddressingMode.ABSOLUTE_X or mode == MOSAddressingMode.ABSOLUTE_Y):
+                index = registers["X" if mode == MOSAddressingMode.ABSOLUTE_X else "Y"]
+                address = instruction.operand + index.base
+                if(NESMemory.isROMMemory(address) and index.valueType == PRGROMValueType.INDEX):
+                    value = PRGROMValue(PRGROMValueType.TABLE, address, index.symbol, index.scale)
+                elif(NESMemory.isROMMemory(address) and index.valueType == PRGROMValueType.CONSTANT):
+                    value = PRGROMValue(PRGROMValueType.CONSTANT, rom.prgRom[NESMemory.pointerToOffset(rom, address)])
+            if(value == None):
+                value = unknown()
+            
+            if(instrType in [MOSInstr_LDA, MOSInstr_LDX, MOSInstr_LDY]):
+                registers[instrType.name[2]] = value
+            elif(instrType in [MOSInstr_STA, MOSInstr_STX, MOSInstr_STY]):
+                if(mode == MOSAddressingMode.ABSOLUTE or mode == MOSAddressingMode.ZERO_PAGE):
+                    memory[instruction.operand] = registers[instrType.name[2]]
+                else:
+                    memory = {}
+            elif(instrType in [MOSInstr_TAX, MOSInstr_TAY, MOSInstr_TXA, MOSInstr_TYA]):
+                registers[instrType.name[2]] = registers[instrType.name[1]]
+            elif(instrType in [MOSInstr_INX, MOSInstr_INY, MOSInstr_DEX, MOSInstr_DEY]):
+                register = registers[instrType.name[2]]
+                step = 1 if instrType.name[0] == "I" else -1
+                if(register.valueType == PRGROMValueType.TABLE):
+                    registers[instrType.name[2]] = unknown()
+                else:
+                    registers[instrType.name[2]] = PRGROMValue(register.valueType, (register.base + step) & (0xFF if register.valueType == PRGROMValueType.CONSTANT else 0xFFFF), register.symbol, register.scale)
+            elif(instrType is MOSInstr_ASL and mode == MOSAddressingMode.ACCUMULATOR and registers["A"].valueType != PRGROMValueType.TABLE):
+                register = registers["A"]
+                if(register.valueType == PRGROMValueType.CONSTANT):
+                    registers["A"] = PRGROMValue(PRGROMValueType.CONSTANT, (register.base << 1) & 0xFF)
+                else:
+                    registers["A"] = PRGROMValue(PRGROMValueType.INDEX, register.base << 1, register.symbol, register.scale << 1)
+            elif(instrType is MOSInstr_ADC and mode == MOSAddressingMode.IMMEDIATE and carryClear and registers["A"].valueType != PRGROMValueType.TABLE):
+                register = registers["A"]
+                registers["A"] = PRGROMValue(register.valueType, (register.base + instruction.operand) & (0xFF if register.valueType == PRGROMValueType.CONSTANT else 0xFFFF), register.symbol, register.scale)
+            elif(instrType is MOSInstr_PHA):
+                stack.append(registers["A"])
+            elif(instrType is MOSInstr_PHP):
+                stack.append(unknown())
+            elif(instrType is MOSInstr_PLA):
+                registers["A"] = stack.pop() if len(stack) > 0 else unknown()
+            elif(instrType is MOSInstr_PLP):
+                if(len(stack) > 0):
+                    stack.pop()
+            elif(instrType is MOSInstr_TSX):
+                registers["X"] = unknown()
+            elif(instrType is MOSInstr_JSR):
+                # We can't follow what a subroutine changes.
+                registers = { "A" : unknown(), "X" : unknown(), "Y" : unknown() }
+                memory = {}
+            elif(instrType in [MOSInstr_AND, MOSInstr_ORA, MOSInstr_EOR, MOSInstr_ADC, MOSInstr_SBC] or 
+                 (instrType in [MOSInstr_ASL, MOSInstr_LSR, MOSInstr_ROL, MOSInstr_ROR] and mode == MOSAddressingMode.ACCUMULATOR)):
+                registers["A"] = unknown()
+            elif(instrType in [MOSInstr_ASL, MOSInstr_LSR, MOSInstr_ROL, MOSInstr_ROR, MOSInstr_INC, MOSInstr_DEC]):
+                if(mode == MOSAddressingMode.ABSOLUTE or mode == MOSAddressingMode.ZERO_PAGE):
+                    memory.pop(instruction.operand, None)
+                else:
+                    memory = {}
+            
+            # Track whether an addition is known to not add a carry.
+            if(instrType is MOSInstr_CLC):
+                carryClear = True
+            elif(instrType in [MOSInstr_SEC, MOSInstr_ADC, MOSInstr_SBC, MOSInstr_CMP, MOSInstr_CPX, MOSInstr_CPY, MOSInstr_ASL, MOSInstr_LSR, MOSInstr_ROL, MOSInstr_ROR, MOSInstr_PLP]):
+                carryClear = False
+                
+        if(jumpType is MOSInstr_RTS):
+            # An RTS which doesn't return to an address we pushed is a normal return. Otherwise it continues at the address + 1.
+            if(len(stack) < 2):
+                return None
+            return self.__enumerateAddresses(rom, stack[-1], stack[-2], 1)
+        
+        # Indirect jumps read their address from ROM, or memory we've written.
+        values = []
+        for address in [jump.operand, (jump.operand & 0xFF00) | ((jump.operand + 1) & 0xFF)]:
+            if(NESMemory.isROMMemory(address)):
+                values.append(PRGROMValue(PRGROMValueType.CONSTANT, rom.prgRom[NESMemory.pointerToOffset(rom, address)]))
+            else:
+                values.append(memory.get(address, None))
+        return self.__enumerateAddresses(rom, values[0], values[1], 0)
+    
+    def __resolveComputedJumps(self, rom):
+        """
+        Resolves the targets of runtime calculated jumps (indirect JMPs, and RTS dispatches which push an address to return to) 
+        where the code leading up to them builds the address from constants or PRG-ROM tables, and discovers them as code sections.
+        Repeats until no new code is discovered (which may contain further runtime calculated jumps).
+        """
+        resolved = {}
+        while(True):
+            discovered = False
+            for codeSection in list(self.codeSections.values()):
+                if(len(codeSection.instructions) == 0):
+                    continue
+                targets = self.__analyzeComputedJump(rom, codeSection)
+                if(targets == None):
+                    continue
+                jump = codeSection.instructions[-1]
+                resolved[jump.address] = len(targets) > 0
+                self.computedJumps[jump.address] = sorted(set(self.computedJumps.get(jump.address, [])) | set(targets))
+                for target in targets:
+                    if(target not in self.codeSections):
+                        discovered = True
+                        self.__findCodeSectionsFrom(rom, target, PRGROMCodeSectionType.LOCATION, jump.offset)
+            if(not discovered):
+                break
+            
+        # If a later split means we couldn't follow how a jump's address was built anymore, we can't be sure we know every target.
+        for address in resolved:
+            if(not resolved[address]):
+                self.computedJumps[address] = []
+                print("Warning: Runtime calculated jump detected at address {} which could not be resolved statically. Any instruction may be jumped to at runtime.".format(hex(address)))
+        targetCount = sum([len(targets) for targets in self.computedJumps.values()])
+        resolvedCount = len([address for address in self.computedJumps if len(self.computedJumps[address]) > 0])
+        print("Computed jumps: {} of {} runtime calculated jumps (indirect JMP or RTS dispatch) resolved statically to {} targets.".format(resolvedCount, len(self.computedJumps), targetCount))
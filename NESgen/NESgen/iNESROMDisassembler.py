@@ -1,12 +1,47 @@
 from MOS6502Instructions import *
 from NESMemory import NESMemory
 from PRGROM import *
+from ExecutionProfile import ExecutionProfile
+from ConstantPropagation import *
+from Liveness import *
+from KnownRoutines import *
 from dis import Instruction
+import io, os
 class iNESROMDisassembler:
     ALLOW_FUNCTION_NAME_OVERRIDES = True
     ALLOW_KNOWN_MEMORY_ACCESS_LABELS = True
     ALLOW_RUNTIME_LOCATIONS = True
+    PRUNE_RUNTIME_LOCATIONS = False
+    RUNTIME_LOCATION_TARGETS_PATH = None
     OUTPUT_FULL_PRGROM_DATA = False
+    ALLOW_LOOP_IDIOMS = True
+    ALLOW_KNOWN_ROUTINES = True
+    ALLOW_SUBROUTINE_FUNCTIONS = True
+    ALLOW_COMPUTED_GOTO_DISPATCH = True
+    ALLOW_REGISTER_PROMOTION = True
+    ALLOW_CONSTANT_FOLDING = True
+    ALLOW_PEEPHOLE_FUSION = True
+    ALLOW_SUBROUTINE_INLINING = True
+    ALLOW_DEAD_RESULT_REMOVAL = True
+    ALLOW_LOOP_STRUCTURING = True
+    ALLOW_LOOP_UNROLLING = True
+    USE_RETURN_STACK = False # JSR pushes its return address and RTS dispatches to it (all code is output in game_execute()), instead of calls.
+    MEMOIZE_SUBROUTINES = False # subroutines which only depend on registers and a few RAM addresses look their results up in a cache first.
+    SOURCE_SHARDS = 1 # C source files subroutine functions and data are split across (balanced by size, so they compile in parallel), the first holds game_execute().
+    SOURCE_SHARD_MARKER = "// NESgen source shard"
+    OUTPUT_BINARY_ROM_DATA = False # PRG-ROM and CHR-ROM data is written to binary files linked in by the assembler (.incbin), instead of C arrays.
+    GAME_SYMBOL_PREFIX = None # prefixes the game's symbols and registers it, so NESsys builds can link in multiple games (APPLICATION_MULTIPLE_GAMES).
+    GAME_SYMBOLS = ["game_execute", "mirroringType", "gameTLB", "gameTLBSize", "gameEntryMap", "gameIdiomLoops", "gameKnownRoutines", "gameMemoSubroutines",
+                    "gameUsesReturnStack", "prgRomData", "prgRomDataSize", "prgRomCode", "prgRomCodeData", "prgRomCodeSize", "chrRom", "chrRomSize"]
+    GAMES_LIST_NAME = "games_list.h"
+    LOOP_IDIOM_MAX_INSTRUCTIONS = 5
+    SUBROUTINE_JUMP_TABLE_MAX_SIZE = 0x1000
+    INLINE_MAX_INSTRUCTIONS = 12
+    LOOP_UNROLL_MAX_INSTRUCTIONS = 32
+    INSTRUMENT_PROFILING = False
+    PROFILE_PATH = None
+    PROFILE_BRANCH_BIAS = 0.9 # branches taken (or not taken) at least this often are hinted as likely (or unlikely).
+    PROFILE_BRANCH_MIN_SAMPLES = 16
     class IOOperationType(Enum):
         """Describes whether an IO operation is a read or write."""
         READ = 0
@@ -34,10 +69,46 @@ class iNESROMDisassembler:
                     labels.append("FUNCTION_" + hex(address)[2:])
                 else:
                     labels.append("LOCATION_" + hex(address)[2:])
-            elif(self.ALLOW_RUNTIME_LOCATIONS):
+            elif(address in self.__runtimeLocations):
                 labels.append("____runtimeloc_" + hex(address)[2:])
         return labels
     
+    def __FindRuntimeLocations(self, rom, prgRom):
+        """
+        Determines which instructions (other than code section starts) get a label, since a runtime calculated jump we couldn't resolve may jump to them.
+        When pruned, only plausible targets get one: words in data sections which point at an instruction (or the byte before one, for RTS dispatch tables),
+        and the addresses in our target list. Jumps to any other instruction are executed by the interpreter until they reach a label.
+        """
+        if(not self.ALLOW_RUNTIME_LOCATIONS or not prgRom.hasUnresolvedJumps()):
+            return set([])
+        instructionAddresses = set([instruction.address for section in prgRom.codeSections.values() for instruction in section.instructions if instruction.address != section.address])
+        if(not self.PRUNE_RUNTIME_LOCATIONS):
+            return instructionAddresses
+        
+        # Words in data (a pointer table, or a single pointer) which point at an instruction.
+        dataTargets = set([])
+        for dataSection in prgRom.dataSections.values():
+            for x in range(0, dataSection.getSize() - 1):
+                word = (dataSection.data[x + 1] << 8) | dataSection.data[x]
+                for address in [word, word + 1]:
+                    if(NESMemory.isROMMemory(address) and NESMemory.pointerToOffset(rom, address) < prgRom.size):
+                        dataTargets.add(NESMemory.offsetToPointer(NESMemory.pointerToOffset(rom, address)))
+        dataTargets &= instructionAddresses
+        
+        # Addresses we were told are jumped to (one hexadecimal address per line, # begins a comment).
+        listTargets = set([])
+        if(self.RUNTIME_LOCATION_TARGETS_PATH != None):
+            with open(self.RUNTIME_LOCATION_TARGETS_PATH, "r") as file:
+                for line in file:
+                    line = line.split("#")[0].strip()
+                    if(line != ""):
+                        listTargets.add(NESMemory.offsetToPointer(NESMemory.pointerToOffset(rom, int(line, 16))))
+        listTargets &= instructionAddresses
+        
+        runtimeLocations = dataTargets | listTargets
+        print("Runtime locations: {} of {} instructions labeled ({} pointed to by data, {} from the target list).".format(len(runtimeLocations), len(instructionAddresses), len(dataTargets), len(listTargets)))
+        return runtimeLocations
+    
     def __GetInstructionFunction(self, instructionOrDefinition):
         """Obtains an instruction function for it's environment given an instruction or instruction definition."""
         instrDefinition = instructionOrDefinition
@@ -45,6 +116,13 @@ class iNESROMDisassembler:
             instrDefinition = instrDefinition.definition
         return "MOSInstr_{}".format(instrDefinition.name)
     
+    def __GetInstructionFunctionName(self, instrType):
+        """Obtains the name generated code calls the instruction function for the given instruction type by (its overridden name, if allowed)."""
+        instrDefinition = next(instrDef for instrDef in MOSInstrAll() if type(instrDef) is instrType)
+        if(self.ALLOW_FUNCTION_NAME_OVERRIDES and instrDefinition.functionNameOverride != None):
+            return instrDefinition.functionNameOverride
+        return self.__GetInstructionFunction(instrDefinition)
+
     def __GetDataSectionLabel(self, address):
         """Returns a label (value name) for data section at the given address."""
         return "DATA_" + hex(address)[2:]
@@ -53,6 +131,77 @@ class iNESROMDisassembler:
         """Obtains a macro given a code section label name."""
         return "ID_" + label
 
+    def __GetIdiomExitLabel(self, address):
+        """Returns a label for the instruction following a loop idiom (where the loop exits to), or the RTS of a known routine."""
+        return "____idiomexit_" + hex(address)[2:]
+
+    def __GetIdiomAddresses(self):
+        """Returns the set of addresses where code executed in bulk starts or continues (loop idioms and known routines, and their exits)."""
+        return (set(self.__idiomLoops.keys()) | set([loop.exitAddress for loop in self.__idiomLoops.values()])
+                | set(self.__knownRoutines.keys()) | set([routine.exitAddress for routine in self.__knownRoutines.values()]))
+
+    def __GetFunctionName(self, address):
+        """Returns the C function name for the subroutine at the given address."""
+        return self.__GetGameSymbol("game_function_" + hex(address)[2:])
+
+    def __GetGameSymbol(self, name):
+        """Returns the C symbol for the given per-game name (prefixed, if other games may be linked into the same binary)."""
+        return name if self.GAME_SYMBOL_PREFIX == None else "{}_{}".format(self.GAME_SYMBOL_PREFIX, name)
+
+    def __GetCRegister(self, name):
+        """Obtains the C expression for the given register (A, X, Y or SP), a local variable if registers are promoted."""
+        return name if self.ALLOW_REGISTER_PROMOTION else "registers." + name
+
+    def __GetCSpillCode(self):
+        """Obtains C code which stores registers kept in local variables back, before code outside of the current C function can observe them."""
+        return "GAME_SPILL_REGISTERS(); " if self.ALLOW_REGISTER_PROMOTION else ""
+
+    def __GetCLoadCode(self):
+        """Obtains C code which loads registers kept in local variables again, after code outside of the current C function could've changed them."""
+        return " GAME_LOAD_REGISTERS();" if self.ALLOW_REGISTER_PROMOTION else ""
+
+    def __GetCRegisterDeclarations(self, body):
+        """Obtains the declarations of the local variables registers are kept in, within the C function made up of the given code sections."""
+        if(not self.ALLOW_REGISTER_PROMOTION):
+            return ""
+        source = "    BYTE A = registers.A, X = registers.X, Y = registers.Y, SP = registers.SP;\n"
+        slots = [address for address in sorted(self.__localStackSlots) if self.__localStackSlots[address][0] in body]
+        if(len(slots) > 0):
+            source += "    BYTE {}; // Values pushed and pulled again within a code section.\n".format(", ".join([self.__GetLocalStackSlot(address) for address in slots]))
+        return source
+
+    def __GetInlineLabel(self, callAddress, address):
+        """Returns the label of the given code section of a subroutine inlined at the JSR at the given address (or where it returns to, if None)."""
+        return "____inline_{}_{}".format(hex(callAddress)[2:], hex(address)[2:] if address != None else "return")
+
+    def __RemoveUnusedLabels(self, source, labels):
+        """Removes the given labels from the given C code if nothing in it jumps to them (the compiler warns about unused labels)."""
+        for label in labels:
+            if("goto {};".format(label) not in source and "&&{} ".format(label) not in source):
+                source = source.replace("{}:;\n".format(label), "", 1).replace("{}:\n".format(label), "", 1)
+        return source
+
+    def __GetLocalStackSlot(self, address):
+        """Returns the name of the local variable holding the value pushed by the PHA at the given address."""
+        return "pushed_" + hex(address)[2:]
+
+    def __GetCCallCode(self, rom, prgRom, address):
+        """Obtains a C call expression which executes code from the given code section address until it returns."""
+        label = self.__GetCodeSectionLabels(rom, prgRom, address)[0]
+        function = self.__GetFunctionName(address) if address in self.__functions else "game_execute"
+        return "{}({})".format(function, self.__GetCodeSectionLabelID(label))
+
+    def __GetCTransferCode(self, rom, prgRom, address, body):
+        """Obtains a C statement which continues execution at the given code section address, from within the C function made up of the given code sections."""
+        if(self.__inlineSite != None and address in self.__inlineSite[1]):
+            return "goto {};".format(self.__GetInlineLabel(self.__inlineSite[0], address))
+        if(address in body):
+            return "goto {};".format(self.__GetCodeSectionLabels(rom, prgRom, address)[0])
+        if(address not in prgRom.codeSections):
+            return "{}return game_execute({});".format(self.__GetCSpillCode(), hex(address))
+        # The code is in another C function, so we call it in place of this one (it returns where this one would have).
+        return "{}return {};".format(self.__GetCSpillCode(), self.__GetCCallCode(rom, prgRom, address))
+
     def __GetAddressMacroLabel(self, addr, operationType):
         """Obtains an label for a certain address in memory."""
         if(self.ALLOW_KNOWN_MEMORY_ACCESS_LABELS and operationType == self.IOOperationType.READ):
@@ -104,6 +253,7 @@ class iNESROMDisassembler:
         """Disassembles the given ROM to an .ASM-like format."""
         # Parse the PRG-ROM into it's respective code/data sections.
         prgRom = PRGROM(rom)
+        self.__runtimeLocations = self.__FindRuntimeLocations(rom, prgRom)
     
         # Print the base address portion of the .ASM file
         print(".org " + hex(NESMemory.PRG_ROM_START_ADDR))
@@ -141,32 +291,1012 @@ class iNESROMDisassembler:
     def DisassembleToC(self, rom, sourcePath, headerPath):
         """Disassembles the given ROM to C files for use with NESsys."""
         # Parse the PRG-ROM into it's respective code/data sections.
-        prgRom = PRGROM(rom)
-        # And generate the source and header file
-        header = self.__GenerateCHeader(rom, prgRom)
-        source = self.__GenerateCSource(rom, prgRom)
+        self.__profile = ExecutionProfile(rom, self.PROFILE_PATH) if self.PROFILE_PATH != None else None
+        prgRom = PRGROM(rom, self.__profile)
+        self.__runtimeLocations = self.__FindRuntimeLocations(rom, prgRom)
+        # Determine which C function code is output in, and recognize loops we can execute in bulk.
+        self.__FindFunctions(rom, prgRom)
+        self.__idiomLoops = self.__FindIdiomLoops(rom, prgRom) if self.ALLOW_LOOP_IDIOMS else {}
+        self.__knownRoutines = KnownRoutines(rom, prgRom).matches if self.ALLOW_KNOWN_ROUTINES else {}
+        self.__localStackSlots = self.__FindLocalStackSlots(rom, prgRom) if self.ALLOW_REGISTER_PROMOTION else {}
+        self.__localStackPulls = dict([(pull, push) for push, (sectionAddress, pull) in self.__localStackSlots.items()])
+        # Determine which register/flag/zero page values are known before each instruction (labels within code sections can be jumped to with any).
+        entryAddresses = self.__runtimeLocations | set([loop.exitAddress for loop in self.__idiomLoops.values()]) | set([routine.exitAddress for routine in self.__knownRoutines.values()])
+        self.__constants = ConstantPropagation(rom, prgRom, entryAddresses) if self.ALLOW_CONSTANT_FOLDING else None
+        # Determine which registers/flags each subroutine reads and writes, and which may be read after each instruction (loop idioms and known routines read them all).
+        self.__liveness = Liveness(rom, prgRom, set(self.__idiomLoops.keys()) | set(self.__knownRoutines.keys())) if self.ALLOW_DEAD_RESULT_REMOVAL else None
+        self.__fusions = self.__FindFusions(rom, prgRom) if self.ALLOW_PEEPHOLE_FUSION else {}
+        self.__inlineSubroutines, self.__tailCalls = self.__FindInlining(rom, prgRom) if self.ALLOW_SUBROUTINE_INLINING else ({}, {})
+        self.__inlineSite = None # (JSR address, subroutine code sections) while outputting an inlined subroutine
+        self.__returnSites = self.__FindReturnSites(rom, prgRom) if self.USE_RETURN_STACK else set([])
+        self.__memoSubroutines = self.__FindMemoSubroutines(rom, prgRom) if self.MEMOIZE_SUBROUTINES else {}
+        self.__memoSubroutine = None # MemoSubroutine of the C function being output, if it's memoized
+        self.__naturalLoops = self.__FindNaturalLoops(rom, prgRom) if self.ALLOW_LOOP_STRUCTURING else {}
+        self.__loopLatches = {} # branch address : how it's output (loop, merged, taken or exit), for loops in the C function being output
+        self.__loopMerged = False # if instructions are output without syncing (the loop iteration syncs once)
+        self.__loopPointers = {} # zero page pointer : local variable it's read into before the loop being output
+        # And generate the header and source file(s), writing them out as they're generated (binary ROM data is written next to the source).
+        self.__binaryPathRoot = os.path.splitext(sourcePath)[0]
+        self.__headerName = os.path.basename(headerPath)
+        with open(headerPath, "w") as fHeader:
+            fHeader.write(self.__GenerateCHeader(rom, prgRom))
+        sources = [open(self.__GetShardPath(sourcePath, shard), "w") for shard in range(0, self.SOURCE_SHARDS)]
+        try:
+            self.__WriteCSource(rom, prgRom, sources)
+        finally:
+            for fSource in sources:
+                fSource.close()
+        self.__RemoveStaleShards(sourcePath)
+        if(self.GAME_SYMBOL_PREFIX != None):
+            self.__RegisterGame(os.path.join(os.path.dirname(os.path.abspath(headerPath)), self.GAMES_LIST_NAME))
+        
+    class IdiomLoop:
+        """Describes a counted store/copy loop which the runtime can execute in bulk."""
+        def __init__(self, kind, index, decrement, compareValue, source, destination, iterationCycles, exitAddress, text):
+            self.kind = kind # fill, copy, PPU fill or PPU copy
+            self.index = index # X or Y register the loop counts with
+            self.decrement = decrement
+            self.compareValue = compareValue # None if the loop ends when the index reaches zero
+            self.source = source # (mode, address) or None for fills
+            self.destination = destination # (mode, address)
+            self.iterationCycles = iterationCycles
+            self.exitAddress = exitAddress # address of the instruction following the loop
+            self.text = text # ASM-like summary of the loop's instructions
+            self.arrayIndex = 0 # index into gameIdiomLoops
+
+    def __GetIdiomOperand(self, instruction, index):
+        """Obtains the (mode, address) a loop store/load accesses every iteration, or None if it can't be executed in bulk."""
+        mode = instruction.definition.mode
+        if(mode == MOSAddressingMode.ABSOLUTE and type(instruction.definition) is MOSInstr_STA and instruction.operand == 0x2007):
+            return ("IDIOM_OPERAND_PPUDATA", 0)
+        if((mode == MOSAddressingMode.ABSOLUTE_X and index == MOSRegisterType.X) or (mode == MOSAddressingMode.ABSOLUTE_Y and index == MOSRegisterType.Y)):
+            # Skip ranges which include hardware registers, since accessing them has side effects.
+            if(instruction.operand + 0xFF >= 0x2000 and instruction.operand < 0x4020):
+                return None
+            return ("IDIOM_OPERAND_ABSOLUTE", instruction.operand)
+        if((mode == MOSAddressingMode.ZERO_PAGE_X and index == MOSRegisterType.X) or (mode == MOSAddressingMode.ZERO_PAGE_Y and index == MOSRegisterType.Y)):
+            return ("IDIOM_OPERAND_ZERO_PAGE", instruction.operand)
+        if(mode == MOSAddressingMode.INDIRECT_Y and index == MOSRegisterType.Y):
+            return ("IDIOM_OPERAND_INDIRECT", instruction.operand)
+        return None
+
+    def __GetIdiomOperandInitializer(self, operand):
+        """Obtains a C struct initializer for a loop operand."""
+        return "{{ {}, {} }}".format(operand[0], hex(operand[1]))
+
+    def __FindIdiomLoop(self, rom, prgRom, codeSection, instructionAddresses):
+        """
+        Recognizes a counted store/copy loop at the start of the given code section:
+        [LDA source] / STA destination / INX|INY|DEX|DEY / [CPX|CPY #value] / BNE (to the start)
+        Returns a tuple (isCountedLoop, IdiomLoop or reason it was not recognized).
+        """
+        # The loop must branch back to its start within a few instructions, with no other control flow in it.
+        instructions = codeSection.instructions[:self.LOOP_IDIOM_MAX_INSTRUCTIONS]
+        branchIndex = next((x for x in range(0, len(instructions)) if instructions[x].definition.isJumpOrBranch), None)
+        if(branchIndex is None):
+            return (False, None)
+        branch = instructions[branchIndex]
+        if(branch.definition.mode != MOSAddressingMode.RELATIVE or NESMemory.offsetToPointer(prgRom.resolveJumpOffset(rom, branch)) != codeSection.address):
+            return (False, None)
         
-        # And save them accordingly.
-        fSource = open(sourcePath, "w")
-        fSource.write(source)
-        fSource.close()
+        # From here on, it's a short loop. Check it's one we can execute in bulk.
+        body = instructions[:branchIndex]
+        exitAddress = branch.address + branch.definition.size
+        if(type(branch.definition) is not MOSInstr_BNE):
+            return (True, "not counted by BNE")
+        if(exitAddress not in instructionAddresses):
+            return (True, "no code follows the loop")
         
-        fHeader = open(headerPath, "w")
-        fHeader.write(header)
-        fHeader.close()
+        # Check for a comparison the loop ends at, and the index step before it.
+        compareValue = None
+        if(len(body) > 0 and type(body[-1].definition) in {MOSInstr_CPX, MOSInstr_CPY}):
+            if(body[-1].definition.mode != MOSAddressingMode.IMMEDIATE):
+                return (True, "compares against memory")
+            compareValue = body[-1].operand
+            compareIndex = MOSRegisterType.X if type(body[-1].definition) is MOSInstr_CPX else MOSRegisterType.Y
+            body = body[:-1]
+        stepTypes = {
+            MOSInstr_INX : (MOSRegisterType.X, False),
+            MOSInstr_INY : (MOSRegisterType.Y, False),
+            MOSInstr_DEX : (MOSRegisterType.X, True),
+            MOSInstr_DEY : (MOSRegisterType.Y, True),
+        }
+        if(len(body) == 0 or type(body[-1].definition) not in stepTypes):
+            return (True, "no index step")
+        index, decrement = stepTypes[type(body[-1].definition)]
+        if(compareValue is not None and compareIndex != index):
+            return (True, "compares another register")
+        body = body[:-1]
         
-    def __GenerateCByteArray(self, data):
-        byteStr = ""
-        x = 0
-        while (x < len(data)):
-            if(x % 0x10 == 0):
-                byteStr += "\n\t"
-                    
-            byteStr += "0x{:02x}".format(data[x])
-            if(x != len(data) - 1):
-                byteStr += ", "
-            x += 1
-        return byteStr
+        # What remains must be a store, optionally preceded by the load of the value it stores.
+        if(len(body) == 0 or type(body[-1].definition) is not MOSInstr_STA):
+            return (True, "no store")
+        destination = self.__GetIdiomOperand(body[-1], index)
+        if(destination is None):
+            return (True, "unsupported store")
+        source = None
+        if(len(body) == 2):
+            if(type(body[0].definition) is not MOSInstr_LDA):
+                return (True, "unsupported instruction")
+            source = self.__GetIdiomOperand(body[0], index)
+            if(source is None or source[0] == "IDIOM_OPERAND_PPUDATA"):
+                return (True, "unsupported load")
+        elif(len(body) != 1):
+            return (True, "unsupported instruction")
+        
+        # Determine the kind of loop, and how long an iteration takes (the branch is taken).
+        kind = ("copy" if source is not None else "fill")
+        if(destination[0] == "IDIOM_OPERAND_PPUDATA"):
+            kind = "PPU " + kind
+        iterationCycles = sum(instruction.definition.cycles for instruction in instructions[:branchIndex + 1]) + 1
+        text = " / ".join([str(instruction).split(" ; ")[0] for instruction in instructions[:branchIndex]] + [branch.definition.name])
+        return (True, self.IdiomLoop(kind, index, decrement, compareValue, source, destination, iterationCycles, exitAddress, text))
+    
+    def __FindIdiomLoops(self, rom, prgRom):
+        """Recognizes loops which can be executed in bulk, and prints statistics on them. Returns a dictionary of loop start address : IdiomLoop."""
+        instructionAddresses = set([instruction.address for codeSection in prgRom.codeSections.values() for instruction in codeSection.instructions])
+        loops = {}
+        rejected = []
+        for address in sorted(prgRom.codeSections.keys()):
+            isCountedLoop, result = self.__FindIdiomLoop(rom, prgRom, prgRom.codeSections[address], instructionAddresses)
+            if(not isCountedLoop):
+                continue
+            if(type(result) is self.IdiomLoop):
+                result.arrayIndex = len(loops)
+                loops[address] = result
+            else:
+                rejected.append((address, result))
+        
+        # Print our recognition statistics.
+        kinds = ["fill", "copy", "PPU fill", "PPU copy"]
+        counts = ", ".join(["{}: {}".format(kind, len([loop for loop in loops.values() if loop.kind == kind])) for kind in kinds])
+        print("Loop idioms: recognized {} of {} short loops ({}).".format(len(loops), len(loops) + len(rejected), counts))
+        for address, loop in loops.items():
+            print("\t{}: {} ({}, {} cycles per iteration)".format(hex(address), loop.text, loop.kind, loop.iterationCycles))
+        for address, reason in rejected:
+            print("\t{}: not recognized, {}".format(hex(address), reason))
+        return loops
+    
+    def __MayWriteStackPage(self, instruction):
+        """Determines if the given instruction may write to the stack page (0x100-0x1FF, or a mirror of it)."""
+        if(type(instruction.definition) not in {MOSInstr_STA, MOSInstr_STX, MOSInstr_STY, MOSInstr_ASL, MOSInstr_DEC, MOSInstr_INC, MOSInstr_LSR, MOSInstr_ROL, MOSInstr_ROR}):
+            return False
+        mode = instruction.definition.mode
+        if(mode in {MOSAddressingMode.ACCUMULATOR, MOSAddressingMode.ZERO_PAGE, MOSAddressingMode.ZERO_PAGE_X, MOSAddressingMode.ZERO_PAGE_Y}):
+            return False
+        if(mode == MOSAddressingMode.ABSOLUTE):
+            addresses = [instruction.operand]
+        elif(mode == MOSAddressingMode.ABSOLUTE_X or mode == MOSAddressingMode.ABSOLUTE_Y):
+            addresses = range(instruction.operand, instruction.operand + 0x100)
+        else:
+            return True # Indirect addresses could be anywhere.
+        return any(address < 0x2000 and (address & 0x7FF) >> 8 == 1 for address in addresses)
+
+    def __FindLocalStackSlots(self, rom, prgRom):
+        """
+        Finds PHA/PLA pairs within a code section, where nothing between them can enter the section, move the stack pointer or write the stack page.
+        The PLA can use the value the PHA pushed from a local variable (the PHA still writes the stack, in case a branch between them leaves it there).
+        Returns a dictionary of PHA address : (code section address, PLA address).
+        """
+        slots = {}
+        stackTypes = {MOSInstr_PHA, MOSInstr_PHP, MOSInstr_PLA, MOSInstr_PLP, MOSInstr_TSX, MOSInstr_TXS, MOSInstr_JSR, MOSInstr_RTS, MOSInstr_RTI, MOSInstr_BRK}
+        idiomAddresses = self.__GetIdiomAddresses()
+        for sectionAddress, section in prgRom.codeSections.items():
+            for x in range(0, len(section.instructions)):
+                if(type(section.instructions[x].definition) is not MOSInstr_PHA):
+                    continue
+                for instruction in section.instructions[x + 1:]:
+                    if(len(self.__GetCodeSectionLabels(rom, prgRom, instruction.address)) > 0 or instruction.address in idiomAddresses):
+                        break
+                    if(type(instruction.definition) is MOSInstr_PLA):
+                        slots[section.instructions[x].address] = (sectionAddress, instruction.address)
+                        break
+                    if(type(instruction.definition) in stackTypes or self.__MayWriteStackPage(instruction)):
+                        break
+        return slots
+
+    class Fusion:
+        """Describes a sequence of instructions within a code section which is output as one fused C operation."""
+        def __init__(self, kind, instructions, text):
+            self.kind = kind # one of FUSION_KINDS
+            self.instructions = instructions
+            self.text = text # ASM-like summary of the instructions
+
+    FUSION_KINDS = ["16-bit add", "16-bit subtract", "count and branch", "compare and branch", "shift chain", "16-bit shift chain"]
+
+    def __IsFusionOperand(self, instruction, allowImmediate=False, allowAccumulator=False):
+        """Determines if the given instruction's operand can be used by a fused sequence: RAM or SRAM (no side effects or timing), or optionally an immediate/the accumulator."""
+        mode = instruction.definition.mode
+        if(mode == MOSAddressingMode.IMMEDIATE):
+            return allowImmediate
+        if(mode == MOSAddressingMode.ACCUMULATOR):
+            return allowAccumulator
+        if(mode == MOSAddressingMode.ZERO_PAGE or mode == MOSAddressingMode.ABSOLUTE):
+            return instruction.operand < 0x2000 or (instruction.operand >= 0x6000 and instruction.operand < 0x8000)
+        return False
+
+    def __GetFusionOperandLocation(self, instruction):
+        """Obtains what the given fused instruction's operand accesses (the accumulator, or an address with RAM mirrors resolved)."""
+        if(instruction.definition.mode == MOSAddressingMode.ACCUMULATOR):
+            return "A"
+        return instruction.operand & 0x7FF if instruction.operand < 0x2000 else instruction.operand
+
+    def __GetCFusionOperand(self, instruction):
+        """Obtains a C expression which reads the given fused instruction's operand."""
+        mode = instruction.definition.mode
+        if(mode == MOSAddressingMode.IMMEDIATE):
+            return hex(instruction.operand)
+        if(mode == MOSAddressingMode.ACCUMULATOR):
+            return self.__GetCRegister("A")
+        return "cpu_read8({})".format(hex(instruction.operand))
+
+    def __GetCFusionStore(self, instruction, value):
+        """Obtains a C statement which writes the given value to the given fused instruction's operand."""
+        if(instruction.definition.mode == MOSAddressingMode.ACCUMULATOR):
+            return "{} = {}".format(self.__GetCRegister("A"), value)
+        return "cpu_write8({}, {})".format(hex(instruction.operand), value)
+
+    def __FindFusion(self, instructions):
+        """
+        Recognizes a fusable sequence at the start of the given instructions:
+        CLC / LDA / ADC / STA / LDA / ADC / STA (or SEC and SBC)           16-bit add (subtract)
+        INX|INY|DEX|DEY / [CPX|CPY #value] / conditional branch           count and branch
+        CMP|CPX|CPY #value / conditional branch                           compare and branch
+        ASL A (or LSR A), repeated                                        shift chain
+        ASL low / ROL high (or LSR high / ROR low), repeated              16-bit shift chain
+        Returns a (kind, instruction count) tuple, or None.
+        """
+        types = [type(instruction.definition) for instruction in instructions]
+        branchTypes = {MOSInstr_BEQ, MOSInstr_BNE, MOSInstr_BCS, MOSInstr_BCC, MOSInstr_BMI, MOSInstr_BPL}
+        
+        # 16-bit add/subtract: the carry of the low byte's result is added to (or borrowed from) the high byte's.
+        for kind, carryType, operationType in [("16-bit add", MOSInstr_CLC, MOSInstr_ADC), ("16-bit subtract", MOSInstr_SEC, MOSInstr_SBC)]:
+            if(types[:7] == [carryType, MOSInstr_LDA, operationType, MOSInstr_STA, MOSInstr_LDA, operationType, MOSInstr_STA]):
+                if(all(self.__IsFusionOperand(instruction, allowImmediate=type(instruction.definition) is not MOSInstr_STA) for instruction in instructions[1:7])):
+                    return (kind, 7)
+        
+        # Count and branch: the index step, an optional comparison of the same index, and the branch testing it.
+        stepRegisters = { MOSInstr_INX : "X", MOSInstr_DEX : "X", MOSInstr_INY : "Y", MOSInstr_DEY : "Y" }
+        compareRegisters = { MOSInstr_CMP : "A", MOSInstr_CPX : "X", MOSInstr_CPY : "Y" }
+        if(len(types) >= 2 and types[0] in stepRegisters):
+            if(types[1] in branchTypes - {MOSInstr_BCS, MOSInstr_BCC}):
+                return ("count and branch", 2)
+            if(len(types) >= 3 and compareRegisters.get(types[1]) == stepRegisters[types[0]] and instructions[1].definition.mode == MOSAddressingMode.IMMEDIATE and types[2] in branchTypes):
+                return ("count and branch", 3)
+        
+        # Compare and branch: the comparison the branch tests.
+        if(len(types) >= 2 and types[0] in compareRegisters and instructions[0].definition.mode == MOSAddressingMode.IMMEDIATE and types[1] in branchTypes):
+            return ("compare and branch", 2)
+        
+        # Shift chains: the same shift of the accumulator, or shift/rotate pair of the same two operands (low and high byte), repeated.
+        for shiftType in [MOSInstr_ASL, MOSInstr_LSR]:
+            count = 0
+            while(count < min(len(instructions), 8) and types[count] is shiftType and instructions[count].definition.mode == MOSAddressingMode.ACCUMULATOR):
+                count += 1
+            if(count >= 2):
+                return ("shift chain", count)
+        for shiftType, rotateType in [(MOSInstr_ASL, MOSInstr_ROL), (MOSInstr_LSR, MOSInstr_ROR)]:
+            if(len(types) < 2 or types[0] is not shiftType or types[1] is not rotateType):
+                continue
+            shift, rotate = instructions[0], instructions[1]
+            if(not self.__IsFusionOperand(shift, allowAccumulator=True) or not self.__IsFusionOperand(rotate, allowAccumulator=True)):
+                continue
+            if(self.__GetFusionOperandLocation(shift) == self.__GetFusionOperandLocation(rotate)):
+                continue
+            count = 2
+            while(count + 1 < min(len(instructions), 30) and types[count] is shiftType and types[count + 1] is rotateType and 
+                  all(instructions[count + x].definition.mode == instructions[x].definition.mode and instructions[count + x].operand == instructions[x].operand for x in [0, 1])):
+                count += 2
+            return ("16-bit shift chain", count)
+        return None
+
+    def __FindFusions(self, rom, prgRom):
+        """
+        Recognizes sequences of instructions within code sections which are output as fused C operations (leaving the same registers, flags and memory),
+        and prints statistics on them. Only the first instruction of a sequence may have a label (or be the start/exit of a loop idiom), and branches
+        constant propagation determined the outcome of are left to it. Returns a dictionary of first instruction address : Fusion.
+        """
+        fusions = {}
+        idiomAddresses = self.__GetIdiomAddresses()
+        for sectionAddress in sorted(prgRom.codeSections.keys()):
+            instructions = prgRom.codeSections[sectionAddress].instructions
+            x = 0
+            while(x < len(instructions)):
+                # Limit the sequence to where another label would interrupt it.
+                end = x + 1
+                while(end < len(instructions) and len(self.__GetCodeSectionLabels(rom, prgRom, instructions[end].address)) == 0 and instructions[end].address not in idiomAddresses):
+                    end += 1
+                found = self.__FindFusion(instructions[x:end])
+                if(found != None and self.__constants != None):
+                    last = instructions[x + found[1] - 1]
+                    if(self.__constants.evaluate(self.__constants.getState(last.address), last).branchTaken != None):
+                        found = None
+                if(found == None):
+                    x += 1
+                    continue
+                kind, count = found
+                text = " / ".join([str(instruction).split(" ; ")[0] for instruction in instructions[x:x + count]])
+                fusions[instructions[x].address] = self.Fusion(kind, instructions[x:x + count], text)
+                x += count
+        
+        # Print our recognition statistics.
+        counts = ", ".join(["{}: {}".format(kind, len([fusion for fusion in fusions.values() if fusion.kind == kind])) for kind in self.FUSION_KINDS])
+        print("Peephole fusion: fused {} instruction sequences ({} instructions) into single operations ({}).".format(len(fusions), sum([len(fusion.instructions) for fusion in fusions.values()]), counts))
+        return fusions
+
+    def __GenerateCFusionCode(self, rom, prgRom, fusion, body):
+        """
+        Generates C code for the given fused sequence, within the C function made up of the given code sections. It syncs once, for all of its cycles,
+        so it's only executed if no interrupt would be handled between its instructions. Otherwise they're executed one at a time.
+        """
+        instructions = fusion.instructions
+        cycles = sum([instruction.definition.cycles for instruction in instructions])
+        registerA = self.__GetCRegister("A")
+        code = ""
+        compared = None # (register, value) a branch tests the difference of
+        if(fusion.kind == "16-bit add" or fusion.kind == "16-bit subtract"):
+            loadLow, low, storeLow, loadHigh, high, storeHigh = instructions[1:]
+            if(fusion.kind == "16-bit add"):
+                template = "{{ BYTE left = {}, right = {}; {}; cpu_set_flag(CPU_FLAG_CARRY, left + right > 0xFF); {} = MOSInstr_AddWithCarry({}, {}); {}; }}"
+                lowResult = "left + right"
+            else:
+                template = "{{ BYTE left = {}, right = {}; {}; cpu_set_flag(CPU_FLAG_CARRY, left >= right); {} = MOSInstr_SubtractWithBorrow({}, {}); {}; }}"
+                lowResult = "left - right"
+            code = template.format(self.__GetCFusionOperand(loadLow), self.__GetCFusionOperand(low), self.__GetCFusionStore(storeLow, lowResult), 
+                                   registerA, self.__GetCFusionOperand(loadHigh), self.__GetCFusionOperand(high), self.__GetCFusionStore(storeHigh, registerA))
+        elif(fusion.kind == "count and branch"):
+            instrType = type(instructions[0].definition)
+            register = self.__GetCRegister("X" if instrType in {MOSInstr_INX, MOSInstr_DEX} else "Y")
+            step = self.__GetInstructionFunctionName(MOSInstr_INC if instrType in {MOSInstr_INX, MOSInstr_INY} else MOSInstr_DEC)
+            code = "{0} = {1}({0});".format(register, step)
+            compared = (register, "0x0")
+            if(len(instructions) == 3):
+                compared = (register, hex(instructions[1].operand))
+                code += " MOSInstr_Compare({}, {});".format(*compared)
+        elif(fusion.kind == "compare and branch"):
+            register = self.__GetCRegister({ MOSInstr_CMP : "A", MOSInstr_CPX : "X", MOSInstr_CPY : "Y" }[type(instructions[0].definition)])
+            compared = (register, hex(instructions[0].operand))
+            code = "MOSInstr_Compare({}, {});".format(*compared)
+        elif(fusion.kind == "shift chain"):
+            function = "MOSInstr_ShiftLeftBy" if type(instructions[0].definition) is MOSInstr_ASL else "MOSInstr_ShiftRightBy"
+            code = "{0} = {1}({0}, {2});".format(registerA, function, len(instructions))
+        elif(fusion.kind == "16-bit shift chain"):
+            if(type(instructions[0].definition) is MOSInstr_ASL):
+                low, high, function = instructions[0], instructions[1], "MOSInstr_ShiftLeft16"
+            else:
+                high, low, function = instructions[0], instructions[1], "MOSInstr_ShiftRight16"
+            code = "{{ USHORT value = {}({} | ({} << 8), {}); {}; {}; }}".format(function, self.__GetCFusionOperand(low), self.__GetCFusionOperand(high), len(instructions) // 2,
+                                                                        self.__GetCFusionStore(low, "(BYTE)value"), self.__GetCFusionStore(high, "(BYTE)(value >> 8)"))
+        
+        # Branches test the register (or its difference from the value compared) directly, rather than the flags (which are still set).
+        branch = instructions[-1]
+        if(branch.definition.mode == MOSAddressingMode.RELATIVE):
+            register, value = compared
+            condition = {
+                MOSInstr_BEQ : "{0} == {1}",
+                MOSInstr_BNE : "{0} != {1}",
+                MOSInstr_BCS : "{0} >= {1}",
+                MOSInstr_BCC : "{0} < {1}",
+                MOSInstr_BMI : "((BYTE)({0} - {1}) & 0x80)",
+                MOSInstr_BPL : "!((BYTE)({0} - {1}) & 0x80)",
+            }[type(branch.definition)].format(register, value)
+            pointer = NESMemory.offsetToPointer(prgRom.resolveJumpOffset(rom, branch))
+            code += " if({}) {{ sync({}); {} }}".format(self.__GetCBranchCondition(branch, condition), cycles + 1, self.__GetCTransferCode(rom, prgRom, pointer, body))
+            cycles += 1
+        source = "\tif(cpu_is_uninterrupted({})) {{ {} sync({}); }} // {} (fused {})\n\telse\n\t{{\n".format(cycles, code, sum([instruction.definition.cycles for instruction in instructions]), fusion.text, fusion.kind)
+        for instruction in instructions:
+            source += self.__GenerateCInstructionCode(rom, prgRom, instruction, body)
+        return source + "\t}\n"
+
+    def __GetReturnLabel(self, address):
+        """Obtains the label of the given return site (the instruction following a JSR, which its return address dispatches to)."""
+        return "RETURN_" + hex(address)[2:]
+
+    def __FindReturnSites(self, rom, prgRom):
+        """
+        Determines the return sites RTSs dispatch to when JSRs push their return address (the instruction following every JSR not inlined).
+        Returns a set of return site addresses (return address + 1).
+        """
+        instructionAddresses = set([instruction.address for section in prgRom.codeSections.values() for instruction in section.instructions])
+        returnSites = set([])
+        for section in prgRom.codeSections.values():
+            for instruction in section.instructions:
+                if(type(instruction.definition) is MOSInstr_JSR and NESMemory.offsetToPointer(prgRom.resolveJumpOffset(rom, instruction)) not in self.__inlineSubroutines):
+                    if(instruction.address + instruction.definition.size in instructionAddresses):
+                        returnSites.add(instruction.address + instruction.definition.size)
+        return returnSites
+
+    def __GenerateCReturnDispatch(self, prgRom):
+        """
+        Generates the return table following the Return label in game_execute(), which RTSs dispatch their popped return address (+ 1) through.
+        Return sites are dispatched through a dense table where the compiler supports label addresses (computed goto), otherwise a switch.
+        Return addresses no JSR pushed (an address the game pushed itself) are dispatched through the jump table.
+        """
+        # Only RTSs jump to the Return label (a game which never returns from a subroutine would leave it unused).
+        hasReturn = any(type(instruction.definition) is MOSInstr_RTS for address in self.__executeBody for instruction in prgRom.codeSections[address].instructions)
+        source = "    Return:\n" if hasReturn else ""
+        returnSites = sorted(self.__returnSites)
+        if(len(returnSites) > 0):
+            baseAddress = returnSites[0]
+            size = returnSites[-1] - baseAddress + 1
+            if(self.ALLOW_COMPUTED_GOTO_DISPATCH):
+                source += "#if GAME_USE_COMPUTED_GOTO\n"
+                source += "    {\n"
+                source += "        static const INT returnTable[{}] =\n        {{\n".format(hex(size))
+                for address in returnSites:
+                    source += "            [{}] = &&{} - &&Jump,\n".format(hex(address - baseAddress), self.__GetReturnLabel(address))
+                source += "        };\n"
+                source += "        if((USHORT)(jumpAddress - {0}) < {1})\n            goto *(&&Jump + returnTable[(USHORT)(jumpAddress - {0})]);\n".format(hex(baseAddress), hex(size))
+                source += "    }\n"
+                source += "#else\n"
+            source += "    switch(jumpAddress)\n    {\n"
+            for address in returnSites:
+                source += "    case {}:\n        goto {};\n".format(hex(address), self.__GetReturnLabel(address))
+            source += "    }\n"
+            if(self.ALLOW_COMPUTED_GOTO_DISPATCH):
+                source += "#endif\n"
+        source += "    goto Jump;\n"
+        return source
+
+    def __FindInlineSubroutine(self, rom, prgRom, address):
+        """Determines if the subroutine at the given address can be inlined at its calls. Returns its code sections, or the reason it can't be."""
+        body = self.__GetReachableSections(rom, prgRom, [address], set([]))
+        instructions = [instruction for sectionAddress in body for instruction in prgRom.codeSections[sectionAddress].instructions]
+        idiomAddresses = self.__GetIdiomAddresses()
+        stackTypes = {MOSInstr_PHA, MOSInstr_PHP, MOSInstr_PLA, MOSInstr_PLP, MOSInstr_TSX, MOSInstr_TXS, MOSInstr_RTI, MOSInstr_BRK}
+        if(len(instructions) > self.INLINE_MAX_INSTRUCTIONS):
+            return "{} instructions".format(len(instructions))
+        for instruction in instructions:
+            instrType = type(instruction.definition)
+            if(instrType is MOSInstr_JSR):
+                return "calls another subroutine"
+            if(instrType in stackTypes or self.__MayWriteStackPage(instruction)):
+                return "uses the stack"
+            if(instruction.definition.mode == MOSAddressingMode.INDIRECT or instruction.address in prgRom.computedJumps):
+                return "has a runtime calculated jump"
+            if(instruction.address in idiomAddresses):
+                return "has a loop idiom or known routine"
+        if(not any(type(instruction.definition) is MOSInstr_RTS for instruction in instructions)):
+            return "never returns"
+        return body
+
+    def __FindInlining(self, rom, prgRom):
+        """
+        Determines which subroutines are small leaf subroutines (no calls, stack use or runtime calculated jumps), whose code is output at every JSR to them
+        instead of a call, and which JSRs are followed by an RTS (tail calls), so the code making the call can return straight after it.
+        Prints statistics on them. Returns a tuple (dictionary of inlined subroutine address : code sections, dictionary of tail call JSR address : RTS).
+        """
+        interruptAddresses = set([NESMemory.offsetToPointer(NESMemory.pointerToOffset(rom, pointer)) for pointer in [prgRom.interruptNMI, prgRom.interruptReset, prgRom.interruptIRQ]])
+        idiomAddresses = self.__GetIdiomAddresses()
+        calls = {} # subroutine address : JSR instructions calling it
+        tailCalls = {}
+        for section in prgRom.codeSections.values():
+            for x in range(0, len(section.instructions)):
+                instruction = section.instructions[x]
+                if(type(instruction.definition) is not MOSInstr_JSR):
+                    continue
+                calls.setdefault(NESMemory.offsetToPointer(prgRom.resolveJumpOffset(rom, instruction)), []).append(instruction)
+                # (With a return stack, the subroutine's RTS returns to the following RTS through the stack)
+                if(x + 1 < len(section.instructions) and not self.USE_RETURN_STACK):
+                    following = section.instructions[x + 1]
+                    if(type(following.definition) is MOSInstr_RTS and following.address not in prgRom.computedJumps and following.address not in idiomAddresses and len(self.__GetCodeSectionLabels(rom, prgRom, following.address)) == 0):
+                        tailCalls[instruction.address] = following
+        
+        subroutines = {}
+        rejected = []
+        for address in sorted(calls.keys()):
+            if(address in interruptAddresses):
+                continue
+            result = self.__FindInlineSubroutine(rom, prgRom, address)
+            if(type(result) is set):
+                subroutines[address] = result
+            else:
+                rejected.append((address, result))
+        # Calls to inlined subroutines are output as the subroutine instead.
+        for address in subroutines:
+            for instruction in calls[address]:
+                tailCalls.pop(instruction.address, None)
+        
+        # Print our statistics, and the code size impact (instructions output at calls, in place of the JSR).
+        inlinedCalls = sum([len(calls[address]) for address in subroutines])
+        inlinedInstructions = sum([len(calls[address]) * len(prgRom.codeSections[sectionAddress].instructions) for address in subroutines for sectionAddress in subroutines[address]])
+        print("Subroutine inlining: {} of {} subroutines inlined at {} calls ({} instructions output in place of the calls, {} more than before), {} tail calls (JSR / RTS) return straight after the call.".format(
+            len(subroutines), len(subroutines) + len(rejected), inlinedCalls, inlinedInstructions, inlinedInstructions - inlinedCalls, len(tailCalls)))
+        for address, body in subroutines.items():
+            print("\t{}: inlined at {} calls ({} instructions)".format(hex(address), len(calls[address]), sum([len(prgRom.codeSections[sectionAddress].instructions) for sectionAddress in body])))
+        for address, reason in rejected:
+            print("\t{}: not inlined, {}".format(hex(address), reason))
+        return (subroutines, tailCalls)
+
+    class MemoSubroutine:
+        """Describes a subroutine whose results only depend on the registers, flags and RAM addresses it reads, which can be cached by them."""
+        def __init__(self, address, inputMask, inputs, outputMask, outputs):
+            self.address = address
+            self.inputMask = inputMask # Liveness mask of the registers/flags read (or not written on every path)
+            self.inputs = inputs # RAM addresses read (or not written on every path)
+            self.outputMask = outputMask # Liveness mask of the registers/flags written
+            self.outputs = outputs # RAM addresses written
+            self.arrayIndex = 0 # index into gameMemoSubroutines
+
+        def getText(self):
+            """Obtains a summary of the subroutine's inputs and outputs."""
+            return "reads {}; writes {}".format(*[", ".join(Liveness.getNames(mask) + [hex(address) for address in addresses]) or "nothing"
+                for mask, addresses in [(self.inputMask, self.inputs), (self.outputMask, self.outputs)]])
+
+    MEMO_MAX_ADDRESSES = 4
+    MEMO_READ_TYPES = {MOSInstr_LDA, MOSInstr_LDX, MOSInstr_LDY, MOSInstr_ADC, MOSInstr_SBC, MOSInstr_AND, MOSInstr_ORA, MOSInstr_EOR, MOSInstr_CMP, MOSInstr_CPX, MOSInstr_CPY, MOSInstr_BIT}
+    MEMO_MODIFY_TYPES = {MOSInstr_ASL, MOSInstr_LSR, MOSInstr_ROL, MOSInstr_ROR, MOSInstr_INC, MOSInstr_DEC}
+
+    def __GetMemoAccess(self, instruction):
+        """
+        Determines the memory the given instruction accesses, for memoization. Returns a tuple (RAM address read or None, RAM address written or None),
+        or the reason it can't be memoized (PRG-ROM reads are constant, so they aren't accesses).
+        """
+        mode = instruction.definition.mode
+        instrType = type(instruction.definition)
+        if(instruction.definition.isJumpOrBranch or mode in {MOSAddressingMode.IMPLIED, MOSAddressingMode.IMMEDIATE, MOSAddressingMode.ACCUMULATOR}):
+            return (None, None)
+        reads = instrType in self.MEMO_READ_TYPES or instrType in self.MEMO_MODIFY_TYPES
+        writes = instrType not in self.MEMO_READ_TYPES
+        if(mode == MOSAddressingMode.ZERO_PAGE or mode == MOSAddressingMode.ABSOLUTE):
+            if(instruction.operand < 0x2000 and (instruction.operand & 0x7FF) >> 8 != 1):
+                address = instruction.operand & 0x7FF
+                return (address if reads else None, address if writes else None)
+            if(instruction.operand >= NESMemory.PRG_ROM_FIRST_BANK_ADDR and not writes):
+                return (None, None)
+            return "accesses IO, SRAM or the stack page"
+        if((mode == MOSAddressingMode.ABSOLUTE_X or mode == MOSAddressingMode.ABSOLUTE_Y) and instruction.operand >= NESMemory.PRG_ROM_FIRST_BANK_ADDR and instruction.operand + 0xFF <= 0xFFFF and not writes):
+            return (None, None)
+        return "accesses RAM through an index or pointer"
+
+    def __GetMemoWrittenBefore(self, rom, prgRom, address, instructions):
+        """
+        Determines the RAM addresses written along every path from the given subroutine address to each of the given instructions.
+        Returns a dictionary of instruction address : set of RAM addresses, or None if a path leaves the given instructions.
+        """
+        written = {address : frozenset()} # instruction address : RAM addresses written along every path to it
+        pending = [address]
+        while(len(pending) > 0):
+            instruction = instructions[pending.pop()]
+            access = self.__GetMemoAccess(instruction)
+            after = written[instruction.address] | (frozenset([access[1]]) if access[1] is not None else frozenset())
+            instrType = type(instruction.definition)
+            successors = []
+            if(instruction.definition.mode == MOSAddressingMode.RELATIVE or instrType is MOSInstr_JMP):
+                successors.append(NESMemory.offsetToPointer(prgRom.resolveJumpOffset(rom, instruction)))
+            if(instrType is not MOSInstr_JMP and instrType is not MOSInstr_RTS):
+                successors.append(instruction.address + instruction.definition.size)
+            for successor in successors:
+                if(successor not in instructions):
+                    return None
+                merged = written[successor] & after if successor in written else after
+                if(successor not in written or merged != written[successor]):
+                    written[successor] = merged
+                    pending.append(successor)
+        return written
+
+    def __FindMemoSubroutine(self, rom, prgRom, address, liveness):
+        """Determines if the subroutine at the given address can be memoized. Returns a MemoSubroutine, or the reason it can't be."""
+        body = self.__GetReachableSections(rom, prgRom, [address], set([]))
+        if(not body <= self.__functions[address]):
+            return "shares code with another function"
+        if(address in self.__inlineSubroutines):
+            return "is inlined"
+        if(address in self.__knownRoutines):
+            return "is a known routine"
+        summary = liveness.getSummaries().get(address)
+        if(summary is None or not summary.understood):
+            return "may not return to its caller"
+        instructions = dict([(instruction.address, instruction) for sectionAddress in body for instruction in prgRom.codeSections[sectionAddress].instructions])
+        stateTypes = {MOSInstr_PHA, MOSInstr_PHP, MOSInstr_PLA, MOSInstr_PLP, MOSInstr_TSX, MOSInstr_TXS, MOSInstr_RTI, MOSInstr_BRK, MOSInstr_CLI, MOSInstr_SEI, MOSInstr_CLD, MOSInstr_SED}
+        writes = set([])
+        for instruction in instructions.values():
+            instrType = type(instruction.definition)
+            if(instrType is MOSInstr_JSR):
+                return "calls another subroutine"
+            if(instrType in stateTypes):
+                return "uses the stack or interrupt/decimal flags"
+            if(instruction.definition.mode == MOSAddressingMode.INDIRECT or instruction.address in prgRom.computedJumps):
+                return "has a runtime calculated jump"
+            access = self.__GetMemoAccess(instruction)
+            if(type(access) is str):
+                return access
+            writes |= set([access[1]]) - set([None])
+        written = self.__GetMemoWrittenBefore(rom, prgRom, address, instructions)
+        if(written is None):
+            return "leaves its code"
+        # RAM is read from the value the subroutine was called with, unless it was written along every path to the read.
+        reads = set([])
+        for instructionAddress, before in written.items():
+            read = self.__GetMemoAccess(instructions[instructionAddress])[0]
+            if(read is not None and read not in before):
+                reads.add(read)
+        returns = [written[instructionAddress] for instructionAddress in written if type(instructions[instructionAddress].definition) is MOSInstr_RTS]
+        mustWrites = frozenset.intersection(*returns) if len(returns) > 0 else frozenset()
+        # Registers, flags and RAM which aren't written on every path keep the value they were called with on the others, so they're inputs too.
+        inputs = sorted(reads | (writes - mustWrites))
+        if(len(inputs) > self.MEMO_MAX_ADDRESSES or len(writes) > self.MEMO_MAX_ADDRESSES):
+            return "accesses {} RAM addresses".format(len(reads | writes))
+        return self.MemoSubroutine(address, summary.reads | (summary.writes & ~summary.mustWrites), inputs, summary.writes, sorted(writes))
+
+    def __FindMemoSubroutines(self, rom, prgRom):
+        """
+        Determines which subroutines only depend on (and change) their registers, flags and a few RAM addresses, so their results can be cached
+        by them, and prints statistics on them. Returns a dictionary of subroutine address : MemoSubroutine.
+        """
+        liveness = self.__liveness if self.__liveness != None else Liveness(rom, prgRom, set(self.__idiomLoops.keys()) | set(self.__knownRoutines.keys()))
+        subroutines = {}
+        rejected = []
+        for address in sorted(self.__functions.keys()):
+            result = self.__FindMemoSubroutine(rom, prgRom, address, liveness)
+            if(type(result) is self.MemoSubroutine):
+                result.arrayIndex = len(subroutines)
+                subroutines[address] = result
+            else:
+                rejected.append((address, result))
+
+        # Print our statistics.
+        print("Memoization: {} of {} subroutines memoized.".format(len(subroutines), len(subroutines) + len(rejected)))
+        for address, subroutine in subroutines.items():
+            print("\t{}: memoized ({})".format(hex(address), subroutine.getText()))
+        for address, reason in rejected:
+            print("\t{}: not memoized, {}".format(hex(address), reason))
+        return subroutines
+
+    def __GetMemoRegisterMask(self, mask):
+        """Obtains the MEMO_REGISTER_* mask of the registers in the given Liveness mask."""
+        return sum([bit for name, bit in [("A", 0x01), ("X", 0x02), ("Y", 0x04)] if mask & Liveness.getMask(name)])
+
+    def __GetMemoFlagMask(self, mask):
+        """Obtains the processor status mask of the flags in the given Liveness mask."""
+        return sum([1 << flag for name, flag in [("C", 0), ("Z", 1), ("V", 6), ("N", 7)] if mask & Liveness.getMask(name)])
+
+    def __GenerateCInlineCode(self, rom, prgRom, instruction, address):
+        """Generates C code for the subroutine at the given address, inlined at the given JSR (it returns by continuing after the JSR)."""
+        body = self.__inlineSubroutines[address]
+        self.__inlineSite = (instruction.address, body)
+        source = ""
+        sectionAddresses = [address] + sorted(body - set([address]))
+        for x in range(0, len(sectionAddresses)):
+            section = prgRom.codeSections[sectionAddresses[x]]
+            source += "{}:\n".format(self.__GetInlineLabel(instruction.address, section.address))
+            if(self.INSTRUMENT_PROFILING):
+                source += "\tprofile_block({});\n".format(hex(section.address))
+            skipUntil = None
+            for sectionInstruction in section.instructions:
+                if(skipUntil != None and sectionInstruction.address < skipUntil):
+                    continue
+                if(sectionInstruction.address in self.__fusions):
+                    fusion = self.__fusions[sectionInstruction.address]
+                    source += self.__GenerateCFusionCode(rom, prgRom, fusion, body)
+                    skipUntil = fusion.instructions[-1].address + 1
+                else:
+                    source += self.__GenerateCInstructionCode(rom, prgRom, sectionInstruction, body)
+            if(len(section.instructions) > 0 and not section.instructions[-1].definition.marksEndOfSection):
+                nextAddress = section.address + section.getSize()
+                if(x + 1 >= len(sectionAddresses) or sectionAddresses[x + 1] != nextAddress):
+                    source += "\t{}\n".format(self.__GetCTransferCode(rom, prgRom, nextAddress, body))
+        source += "{}:;\n".format(self.__GetInlineLabel(instruction.address, None))
+        self.__inlineSite = None
+        # Only the labels branched to within the inlined code are needed (it's entered at the top, and most code sections are fallen into).
+        return self.__RemoveUnusedLabels(source, [self.__GetInlineLabel(instruction.address, sectionAddress) for sectionAddress in sectionAddresses + [None]])
+
+    class NaturalLoop:
+        """Describes a natural loop: code sections which branch back to a code section dominating them (which every path into the loop goes through)."""
+        def __init__(self, header):
+            self.header = header # code section address the loop begins at
+            self.latches = {} # code section address : (last) conditional branch in it going back to the header
+            self.sections = set([header])
+            self.iterationCycles = None # cycles per iteration (taking the back-edge), for loops of a single code section
+            self.merged = False # if an iteration can sync once, when it can't be interrupted (only RAM is accessed)
+            self.pointers = [] # zero page pointers read once before the loop (nothing in or interrupting the loop writes them)
+            self.tripCount = None # iterations, if known and small enough to unroll
+
+    def __FindDominators(self, rom, prgRom):
+        """
+        Determines the immediate dominator of every code section reachable from the code sections entered other ways than a branch or jump we follow
+        (whose immediate dominator is None). Returns a dictionary of code section address : immediate dominator.
+        """
+        instructionsByOffset = dict([(instruction.offset, instruction) for section in prgRom.codeSections.values() for instruction in section.instructions])
+        def isFollowed(referencedBy):
+            instruction = instructionsByOffset.get(referencedBy)
+            return instruction != None and (instruction.definition.mode == MOSAddressingMode.RELATIVE or (type(instruction.definition) is MOSInstr_JMP and instruction.definition.mode == MOSAddressingMode.ABSOLUTE))
+        computedTargets = set([target for targets in prgRom.computedJumps.values() for target in targets])
+        successors = { None : [] }
+        predecessors = dict([(address, []) for address in prgRom.codeSections])
+        for address, section in prgRom.codeSections.items():
+            successors[address] = [successor for successor in self.__GetSectionSuccessors(rom, prgRom, section) if successor in prgRom.codeSections]
+            for successor in successors[address]:
+                predecessors[successor].append(address)
+        for address, section in prgRom.codeSections.items():
+            if(address in computedTargets or section.referenceType != PRGROMCodeSectionType.LOCATION or len(predecessors[address]) == 0 or any(not isFollowed(referencedBy) for referencedBy in section.referencedBy)):
+                successors[None].append(address)
+                predecessors[address].append(None)
+
+        # Order code sections by their depth first postorder from the entered ones, then find dominators until none change (Cooper, Harvey & Kennedy).
+        postorder = []
+        visited = set([None])
+        stack = [(None, iter(sorted(successors[None])))]
+        while(len(stack) > 0):
+            address, remaining = stack[-1]
+            successor = next(remaining, -1)
+            if(successor == -1):
+                postorder.append(address)
+                stack.pop()
+            elif(successor not in visited):
+                visited.add(successor)
+                stack.append((successor, iter(successors[successor])))
+        index = dict([(address, x) for x, address in enumerate(postorder)])
+        dominators = { None : None }
+        def intersect(a, b):
+            while(a != b):
+                while(index[a] < index[b]):
+                    a = dominators[a]
+                while(index[b] < index[a]):
+                    b = dominators[b]
+            return a
+        changed = True
+        while(changed):
+            changed = False
+            for address in reversed(postorder[:-1]):
+                processed = [predecessor for predecessor in predecessors[address] if predecessor in dominators]
+                dominator = processed[0]
+                for predecessor in processed[1:]:
+                    dominator = intersect(predecessor, dominator)
+                if(dominators.get(address, -1) != dominator):
+                    dominators[address] = dominator
+                    changed = True
+        del dominators[None]
+        return dominators
+
+    def __GetLoopCounter(self, instructions):
+        """
+        Recognizes how the given loop instructions count, ending with: INX|INY|DEX|DEY / [CPX|CPY #value] / BNE|BEQ|BPL|BMI (or BCC|BCS after a compare).
+        Returns a tuple (register, step, compare value or None, branch type), or None if they don't count that way.
+        """
+        branchType = type(instructions[-1].definition)
+        compare = instructions[-2] if len(instructions) >= 2 and type(instructions[-2].definition) in {MOSInstr_CPX, MOSInstr_CPY} else None
+        if(compare != None and compare.definition.mode != MOSAddressingMode.IMMEDIATE):
+            return None
+        step = instructions[-3 if compare != None else -2] if len(instructions) >= (3 if compare != None else 2) else None
+        steps = { MOSInstr_INX : ("X", 1), MOSInstr_DEX : ("X", -1), MOSInstr_INY : ("Y", 1), MOSInstr_DEY : ("Y", -1) }
+        if(step == None or type(step.definition) not in steps):
+            return None
+        register, amount = steps[type(step.definition)]
+        if(compare != None and (type(compare.definition) is MOSInstr_CPX) != (register == "X")):
+            return None
+        if(branchType not in ({MOSInstr_BNE, MOSInstr_BEQ, MOSInstr_BCC, MOSInstr_BCS} if compare != None else {MOSInstr_BNE, MOSInstr_BEQ, MOSInstr_BPL, MOSInstr_BMI})):
+            return None
+        # Nothing else in the loop may change the counter.
+        writers = { "X" : {MOSInstr_LDX, MOSInstr_TAX, MOSInstr_TSX, MOSInstr_INX, MOSInstr_DEX}, "Y" : {MOSInstr_LDY, MOSInstr_TAY, MOSInstr_INY, MOSInstr_DEY} }[register]
+        if(any(type(instruction.definition) in writers for instruction in instructions if instruction is not step)):
+            return None
+        return (register, amount, compare.operand if compare != None else None, branchType)
+
+    def __GetLoopTripCount(self, rom, prgRom, section, counter):
+        """Determines how many times the given single code section loop iterates, from its counter's known value on entry (None if not known)."""
+        if(self.__constants == None or prgRom.hasUnresolvedJumps() or section.referenceType != PRGROMCodeSectionType.LOCATION or len(section.referencedBy) != 1):
+            return None
+        # The loop is only entered from the code section before it (the branch back is its only reference).
+        previous = next((other for other in prgRom.codeSections.values() if other.address + other.getSize() == section.address), None)
+        if(previous == None or len(previous.instructions) == 0 or previous.instructions[-1].definition.marksEndOfSection):
+            return None
+        state = self.__constants.getState(previous.instructions[-1].address)
+        if(state == None):
+            return None
+        known = self.__constants.evaluate(state, previous.instructions[-1])
+        register, amount, compareValue, branchType = counter
+        value = known.registers[register] if register in known.registers else state.get(register)
+        if(value == None):
+            return None
+        for tripCount in range(1, 0x101):
+            value = (value + amount) & 0xFF
+            compared = compareValue if compareValue != None else 0
+            taken = {
+                MOSInstr_BNE : value != compared,
+                MOSInstr_BEQ : value == compared,
+                MOSInstr_BCC : value < compared,
+                MOSInstr_BCS : value >= compared,
+                MOSInstr_BPL : value < 0x80,
+                MOSInstr_BMI : value >= 0x80,
+            }[branchType]
+            if(not taken):
+                return tripCount
+        return None
+
+    def __GetLoopInstructions(self, prgRom, loop):
+        """Obtains the instructions of the given loop of a single code section (the rest of the code section follows the loop)."""
+        instructions = prgRom.codeSections[loop.header].instructions
+        return instructions[:instructions.index(loop.latches[loop.header]) + 1]
+
+    def __AnalyzeLoopSection(self, rom, prgRom, loop, interruptWrites):
+        """Determines how the given loop of a single code section can be output: its cycles per iteration, if it can be merged, unrolled, or hoist pointers."""
+        section = prgRom.codeSections[loop.header]
+        instructions = self.__GetLoopInstructions(prgRom, loop)
+        loop.iterationCycles = sum([instruction.definition.cycles for instruction in instructions]) + 1
+        hasBranches = any(instruction.definition.isJumpOrBranch for instruction in instructions[:-1])
+        # Instructions which only access RAM, so nothing else (the PPU, APU or interrupts) can tell the iteration synced once.
+        unmergedTypes = {MOSInstr_JSR, MOSInstr_RTS, MOSInstr_RTI, MOSInstr_BRK, MOSInstr_JMP, MOSInstr_CLI, MOSInstr_SEI, MOSInstr_PLP}
+        def accessesRAM(instruction):
+            mode = instruction.definition.mode
+            if(mode in {MOSAddressingMode.IMPLIED, MOSAddressingMode.ACCUMULATOR, MOSAddressingMode.IMMEDIATE, MOSAddressingMode.ZERO_PAGE, MOSAddressingMode.ZERO_PAGE_X, MOSAddressingMode.ZERO_PAGE_Y}):
+                return True
+            if(mode == MOSAddressingMode.ABSOLUTE):
+                return instruction.operand < 0x2000 or (instruction.operand >= 0x6000 and instruction.operand < 0x8000)
+            if(mode in {MOSAddressingMode.ABSOLUTE_X, MOSAddressingMode.ABSOLUTE_Y}):
+                return instruction.operand + 0xFF < 0x2000 or (instruction.operand >= 0x6000 and instruction.operand + 0xFF < 0x8000)
+            return False
+        loop.merged = not hasBranches and all(type(instruction.definition) not in unmergedTypes and accessesRAM(instruction) for instruction in instructions[:-1])
+        # Pointers nothing in the loop (or an interrupt) writes, in loops only entered at their start.
+        hasLabels = any(len(self.__GetCodeSectionLabels(rom, prgRom, instruction.address)) > 0 for instruction in instructions[1:])
+        if(not hasLabels and not any(type(instruction.definition) is MOSInstr_JSR for instruction in instructions)):
+            written = set(interruptWrites)
+            for instruction in instructions:
+                written |= ConstantPropagation.getPossibleWrites(instruction)
+            pointers = set([instruction.operand for instruction in instructions if instruction.definition.mode == MOSAddressingMode.INDIRECT_Y])
+            loop.pointers = sorted([pointer for pointer in pointers if pointer < 0xFF and pointer not in written and pointer + 1 not in written])
+        # Counted loops iterating a known number of times can be unrolled.
+        counter = self.__GetLoopCounter(instructions)
+        if(self.ALLOW_LOOP_UNROLLING and counter != None and not hasBranches and not hasLabels and not any(type(instruction.definition) is MOSInstr_JSR for instruction in instructions)):
+            tripCount = self.__GetLoopTripCount(rom, prgRom, section, counter)
+            if(tripCount != None and tripCount * len(instructions) <= self.LOOP_UNROLL_MAX_INSTRUCTIONS):
+                loop.tripCount = tripCount
+
+    def __FindNaturalLoops(self, rom, prgRom):
+        """
+        Finds the natural loops in the code section CFG (a branch back to a code section which dominates it), which are output as do/while loops.
+        Prints statistics on them. Returns a dictionary of header code section address : NaturalLoop.
+        """
+        dominators = self.__FindDominators(rom, prgRom)
+        def dominates(header, address):
+            while(address != None):
+                if(address == header):
+                    return True
+                address = dominators[address]
+            return False
+        predecessors = {}
+        for address, section in prgRom.codeSections.items():
+            for successor in self.__GetSectionSuccessors(rom, prgRom, section):
+                predecessors.setdefault(successor, set([])).add(address)
+
+        loops = {}
+        for address in sorted(dominators.keys()):
+            section = prgRom.codeSections[address]
+            for instruction in section.instructions:
+                if(not instruction.definition.isJumpOrBranch or type(instruction.definition) is MOSInstr_JSR or instruction.definition.mode == MOSAddressingMode.INDIRECT):
+                    continue
+                header = NESMemory.offsetToPointer(prgRom.resolveJumpOffset(rom, instruction))
+                if(header not in dominators or not dominates(header, address)):
+                    continue
+                # The loop is made up of every code section which reaches the back-edge without passing the header.
+                loop = loops.setdefault(header, self.NaturalLoop(header))
+                if(type(instruction.definition) is not MOSInstr_JMP):
+                    loop.latches[address] = instruction
+                pending = [address]
+                while(len(pending) > 0):
+                    member = pending.pop()
+                    if(member in loop.sections):
+                        continue
+                    loop.sections.add(member)
+                    pending.extend(predecessors.get(member, []))
+        # Loops a recognized idiom executes in bulk keep their form (as do those starting a known routine).
+        for header in list(loops.keys()):
+            if(header in self.__idiomLoops or header in self.__knownRoutines or len(loops[header].latches) == 0):
+                del loops[header]
+
+        interruptWrites = ConstantPropagation.findInterruptWrites(rom, prgRom)
+        for loop in loops.values():
+            if(loop.sections == set([loop.header]) and loop.header in loop.latches):
+                self.__AnalyzeLoopSection(rom, prgRom, loop, interruptWrites)
+        singleCount = len([loop for loop in loops.values() if loop.iterationCycles != None])
+        print("Natural loops: found {} loops with a conditional back-edge ({} of a single code section: {} sync once per iteration when uninterrupted, {} hoist pointers, {} unrolled).".format(
+            len(loops), singleCount, len([loop for loop in loops.values() if loop.merged]), len([loop for loop in loops.values() if len(loop.pointers) > 0]), len([loop for loop in loops.values() if loop.tripCount != None])))
+        return loops
+
+    def __GetStructuredLoops(self, rom, prgRom, body, sectionAddresses):
+        """
+        Determines which natural loops in the given C function are output as do/while loops, given the order its code sections are output in:
+        loops whose code sections are output together, up to a conditional branch back to the header, and nest within each other.
+        Returns a dictionary of header code section address : (NaturalLoop, latch code section address).
+        """
+        position = dict([(address, x) for x, address in enumerate(sectionAddresses)])
+        candidates = []
+        for header, loop in self.__naturalLoops.items():
+            if(header not in position or not loop.sections <= body):
+                continue
+            latch = max(loop.latches.keys(), key=lambda address: position[address])
+            branch = loop.latches[latch]
+            first, last = (position[header], header), (position[latch], branch.address)
+            if(last < first or set(sectionAddresses[first[0]:last[0] + 1]) != loop.sections):
+                continue
+            known = self.__constants.evaluate(self.__constants.getState(branch.address), branch) if self.__constants != None else ConstantPropagationResult()
+            if(known.branchTaken != None or branch.address in prgRom.computedJumps):
+                continue
+            candidates.append((first, last, loop, latch))
+        # Outer loops first, skipping loops which would overlap one without nesting in it.
+        structured = {}
+        ranges = []
+        for first, last, loop, latch in sorted(candidates, key=lambda candidate: (candidate[0][0] - candidate[1][0], candidate[0], candidate[1])):
+            if(any(first <= otherLast and otherFirst <= last and not (otherFirst <= first and last <= otherLast) for otherFirst, otherLast in ranges)):
+                continue
+            ranges.append((first, last))
+            structured[loop.header] = (loop, latch)
+        return structured
+
+    def __GetCLoopPointerName(self, loop, pointer):
+        """Obtains the name of the local variable the given structured loop reads the given zero page pointer into."""
+        return "loopPointer_{}_{:02x}".format(hex(loop.header)[2:], pointer)
+
+    def __GetCLoopDeclarations(self, structured):
+        """Obtains the C declarations of the local variables the given structured loops use (declared where the function begins)."""
+        source = ""
+        for loop, latch in sorted(structured.values(), key=lambda value: value[0].header):
+            if(loop.tripCount == None):
+                source += "\tBOOL loopTaken_{};\n".format(hex(loop.header)[2:])
+                for pointer in loop.pointers:
+                    source += "\tUSHORT {};\n".format(self.__GetCLoopPointerName(loop, pointer))
+        return source
+
+    def __GetCLoopHeader(self, loop):
+        """Obtains the C code beginning the given structured loop: its hoisted pointers, and the start of the do/while."""
+        source = ""
+        self.__loopPointers = {}
+        for pointer in loop.pointers:
+            self.__loopPointers[pointer] = self.__GetCLoopPointerName(loop, pointer)
+            source += "\t{} = cpu_read16({}); // Pointer read once (nothing in or interrupting the loop writes it)\n".format(self.__loopPointers[pointer], hex(pointer))
+        if(loop.iterationCycles != None):
+            source += "\tdo // Loop ({} cycles per iteration)\n\t{{\n".format(loop.iterationCycles)
+        else:
+            source += "\tdo // Loop ({} code sections)\n\t{{\n".format(len(loop.sections))
+        return source
+
+    def __GenerateCMergedLoopCode(self, rom, prgRom, loop, body):
+        """Generates C code for an iteration of the given single code section loop which syncs once, if no interrupt can occur during it."""
+        latch = loop.latches[loop.header]
+        source = "\tif(cpu_is_uninterrupted({})) // Only RAM is accessed, so the iteration syncs once\n\t{{\n".format(loop.iterationCycles)
+        self.__loopMerged = True
+        self.__loopLatches[latch.address] = ("merged", loop)
+        for instruction in self.__GetLoopInstructions(prgRom, loop):
+            source += self.__GenerateCInstructionCode(rom, prgRom, instruction, body)
+        self.__loopMerged = False
+        self.__loopLatches[latch.address] = ("loop", loop)
+        return source + "\t}\n"
+
+    def __GetCLoopLatchCode(self, instruction, description):
+        """Obtains C code for the given branch back of a structured loop, returning a tuple of (code, sync code, description)."""
+        mode, loop = self.__loopLatches[instruction.address]
+        cycles = instruction.definition.cycles
+        taken = "loopTaken_" + hex(loop.header)[2:]
+        if(mode == "taken"):
+            return ("sync({});".format(cycles + 1), "", description + " (taken, unrolled)")
+        if(mode == "exit"):
+            return ("sync({});".format(cycles), "", description + " (not taken, unrolled)")
+        code = "{} = {};".format(taken, self.__GetCBranchCondition(instruction, self.__GetCFlagCondition(type(instruction.definition))))
+        if(mode == "merged"):
+            return (code, "sync({0} ? {1} : {2});".format(taken, loop.iterationCycles, loop.iterationCycles - 1), description + " (loop iteration)")
+        return (code, "sync({0} ? {1} : {2});".format(taken, cycles + 1, cycles), description + " (loop)")
+
+    def __WriteCByteArray(self, output, data):
+        """Writes the given bytes as the elements of a C array (sixteen to a line)."""
+        for x in range(0, len(data), 0x10):
+            output.write("\n\t" + ", ".join(["0x{:02x}".format(value) for value in data[x:x + 0x10]]))
+            if(x + 0x10 < len(data)):
+                output.write(", ")
+    
+    def __WriteCDataArray(self, output, name, data):
+        """
+        Writes a read-only C array with the given name holding the given bytes. If we output binary ROM data, the bytes are written to a binary
+        file named after the source file instead, which the assembler links in (so the C compiler never parses them).
+        """
+        if(self.OUTPUT_BINARY_ROM_DATA):
+            path = "{}_{}.bin".format(self.__binaryPathRoot, name)
+            with open(path, "wb") as file:
+                file.write(bytes(data))
+            output.write("GAME_INCBIN({}, \"{}\");\n".format(name, os.path.basename(path)))
+        else:
+            output.write("const BYTE {}[] = {{".format(name))
+            self.__WriteCByteArray(output, data)
+            output.write("\n};\n")
     
     def __GenerateCHeader(self, rom, prgRom):
         """Creates a header for a NES ROM to disassemble."""
@@ -178,13 +1308,34 @@ class iNESROMDisassembler:
 #include "memory.h"
 #include "instructions.h"
 #include "ppu.h"
+#include "idioms.h"
+#include "hle.h"
+#include "memo.h"
+#include "interpreter.h"
+#include "profile.h"
+"""
+        if(self.GAME_SYMBOL_PREFIX != None):
+            header += """#include "games.h"
 
 // ---------------------------------
+// Symbols
+// ---------------------------------
+// Prefixed so other games can be linked into the same NESsys binary (their headers are never included together).
+"""
+            for name in self.GAME_SYMBOLS:
+                header += "#define {0:30}{1}\n".format(name, self.__GetGameSymbol(name))
+        header += """
+// ---------------------------------
 // Objects/Structures
 // ---------------------------------
 enum MIRRORINGTYPE mirroringType;
 extern struct TLBEntry gameTLB[];
 UINT gameTLBSize;
+extern BYTE gameEntryMap[];
+extern struct IDIOMLOOP gameIdiomLoops[];
+extern struct HLEROUTINE gameKnownRoutines[];
+extern struct MEMOSUBROUTINE gameMemoSubroutines[];
+BOOL gameUsesReturnStack;
 
 // ---------------------------------
 // Function IDs (used for interrupt/JSR locations).
@@ -210,68 +1361,323 @@ UINT gameTLBSize;
                 instructionTypes.add(type(instrDef))
                 if(instrDef.functionNameOverride != None):
                     header += "#define {0:30}{1}\n".format(instrDef.functionNameOverride, self.__GetInstructionFunction(instrDef))
-        header += """
+        if(self.ALLOW_REGISTER_PROMOTION):
+            header += """
+// Registers are kept in local variables (A, X, Y, SP) by each function, and only stored back to the registers structure (spilled)
+// where code outside of the function can observe them: interrupts, calls, returns, loop idioms, known routines and memoization. They're loaded again afterwards.
+#define GAME_SPILL_REGISTERS()    { registers.A = A; registers.X = X; registers.Y = Y; registers.SP = SP; }
+#define GAME_LOAD_REGISTERS()     { A = registers.A; X = registers.X; Y = registers.Y; SP = registers.SP; }
+#define sync(interval)            if(cpu_sync_hardware(interval)) { GAME_SPILL_REGISTERS(); if(cpu_sync_interrupts()) { return TRUE; } GAME_LOAD_REGISTERS(); }
+#define idiom(loop, exitLabel)    { GAME_SPILL_REGISTERS(); UINT idiomCycles = idiom_execute_loop(loop); if(idiomCycles != 0) { GAME_LOAD_REGISTERS(); sync(idiomCycles); goto exitLabel; } }
+#define hle(routine, exitLabel)   { GAME_SPILL_REGISTERS(); UINT hleCycles = hle_execute_routine(routine); if(hleCycles != 0) { GAME_LOAD_REGISTERS(); sync(hleCycles); goto exitLabel; } }
+#define memoize(subroutine)       { GAME_SPILL_REGISTERS(); UINT memoCycles = memo_lookup(subroutine); if(memoCycles != 0) { GAME_LOAD_REGISTERS(); sync(memoCycles); return FALSE; } }
+"""
+        else:
+            header += """
 #define sync(interval)            if(cpu_sync(interval)) { return TRUE; }
+#define idiom(loop, exitLabel)    { UINT idiomCycles = idiom_execute_loop(loop); if(idiomCycles != 0) { sync(idiomCycles); goto exitLabel; } }
+#define hle(routine, exitLabel)   { UINT hleCycles = hle_execute_routine(routine); if(hleCycles != 0) { sync(hleCycles); goto exitLabel; } }
+#define memoize(subroutine)       { UINT memoCycles = memo_lookup(subroutine); if(memoCycles != 0) { sync(memoCycles); return FALSE; } }
+"""
+        if(self.OUTPUT_BINARY_ROM_DATA):
+            header += """
+// ROM data is linked in from binary files by the assembler, as read-only data (the PRG-ROM and CHR-ROM pages of the executable are shared
+// between processes running it, and never copied). Requires an assembler supporting .incbin (GCC/Clang). The files are named without a
+// directory, so the assembler must search the source directory (-Wa,-I<directory>, which NESsys's CMakeLists.txt passes).
+#ifdef __APPLE__
+#define GAME_INCBIN_SECTION       "__TEXT,__const"
+#define GAME_INCBIN_SYMBOL(name)  "_" #name
+#else
+#define GAME_INCBIN_SECTION       ".rodata"
+#define GAME_INCBIN_SYMBOL(name)  #name
+#endif
+#define GAME_INCBIN(name, path)   __asm__(".pushsection " GAME_INCBIN_SECTION "\\n.globl " GAME_INCBIN_SYMBOL(name) "\\n.balign 16\\n" GAME_INCBIN_SYMBOL(name) ":\\n.incbin \\"" path "\\"\\n.popsection\\n"); extern const BYTE name[]
+"""
+        if(self.ALLOW_CONSTANT_FOLDING):
+            header += """
+// Sets the processor status flags in the mask to the given values, for instructions whose results constant propagation determined.
+#define GAME_SET_FLAGS(mask, flags)  registers.P = (registers.P & ~(mask)) | (flags)
+"""
+        header += """
+// Jump tables are dense arrays of label addresses where the compiler supports them (GCC/Clang), switches otherwise.
+#ifndef GAME_USE_COMPUTED_GOTO
+#ifdef __GNUC__
+#define GAME_USE_COMPUTED_GOTO    TRUE
+#else
+#define GAME_USE_COMPUTED_GOTO    FALSE
+#endif
+#endif
+
+// Hints from an execution profile (branches which almost always go one way, code which wasn't executed), where the compiler supports them.
+#ifdef __GNUC__
+#define GAME_LIKELY(condition)    __builtin_expect(!!(condition), 1)
+#define GAME_UNLIKELY(condition)  __builtin_expect(!!(condition), 0)
+#define GAME_COLD                 __attribute__((cold))
+#else
+#define GAME_LIKELY(condition)    (condition)
+#define GAME_UNLIKELY(condition)  (condition)
+#define GAME_COLD
+#endif
+#if defined(__GNUC__) && !defined(__clang__)
+#define GAME_COLD_LABEL           __attribute__((cold, unused))
+#else
+#define GAME_COLD_LABEL
+#endif
+
+// Records an execution profile (written on exit) if the game was generated with -g.
+#define GAME_PROFILING            """ + ("TRUE" if self.INSTRUMENT_PROFILING else "FALSE") + """
 
 // ---------------------------------
 // Functions
 // ---------------------------------
 BOOL game_execute(USHORT jumpAddress);
-
+"""
+        # Subroutine functions split across shards are called between them.
+        if(self.SOURCE_SHARDS > 1):
+            for address in sorted(self.__functions.keys()):
+                header += "{}BOOL {}(USHORT jumpAddress);\n".format(self.__GetCFunctionAttributes(address), self.__GetFunctionName(address))
+        header += """
 // ---------------------------------
 // Data
 // ---------------------------------
-extern BYTE prgRomData[];
+extern const BYTE prgRomData[];
 UINT prgRomDataSize;
-extern BYTE chrRom[];
+extern const BYTE* prgRomCode;
+""" + ("extern const BYTE prgRomCodeData[]; // Referenced by the game descriptor, which may be in another shard.\n" if self.SOURCE_SHARDS > 1 and not self.OUTPUT_FULL_PRGROM_DATA else "") + """UINT prgRomCodeSize;
+extern const BYTE chrRom[];
 UINT chrRomSize;
 
 #endif /* GAME_H_ */
 """
         return header
     
-    def __GenerateCInstructionCode(self, rom, prgRom, instruction):
-        """Generates C code for a given instruction."""
+    def __GetCProfileIndirectCode(self, instruction):
+        """Obtains C code which records the target of the given runtime calculated jump (held in jumpAddress), if we're instrumenting for profiling."""
+        return "profile_indirect({}, jumpAddress); ".format(hex(instruction.address)) if self.INSTRUMENT_PROFILING else ""
+
+    def __GetCRegisterInstructionCode(self, instruction, argument, code):
+        """
+        Obtains C code for the given instruction with registers kept in local variables, given its argument (the value it uses, or the address it stores to)
+        and its code otherwise. Instructions which only use memory or flags keep their code.
+        """
+        instrType = type(instruction.definition)
+        if(instrType is MOSInstr_PHA and instruction.address in self.__localStackSlots):
+            return "{} = A; stack[SP--] = A".format(self.__GetLocalStackSlot(instruction.address))
+        if(instrType is MOSInstr_PLA and instruction.address in self.__localStackPulls):
+            return "A = MOSInstr_Load({}); SP++".format(self.__GetLocalStackSlot(self.__localStackPulls[instruction.address]))
+        increment = self.__GetInstructionFunctionName(MOSInstr_INC)
+        decrement = self.__GetInstructionFunctionName(MOSInstr_DEC)
+        template = {
+            MOSInstr_ADC : "A = MOSInstr_AddWithCarry(A, {})",
+            MOSInstr_SBC : "A = MOSInstr_SubtractWithBorrow(A, {})",
+            MOSInstr_AND : "A = MOSInstr_Load(A & {})",
+            MOSInstr_ORA : "A = MOSInstr_Load(A | {})",
+            MOSInstr_EOR : "A = MOSInstr_Load(A ^ {})",
+            MOSInstr_BIT : "MOSInstr_Test(A, {})",
+            MOSInstr_CMP : "MOSInstr_Compare(A, {})",
+            MOSInstr_CPX : "MOSInstr_Compare(X, {})",
+            MOSInstr_CPY : "MOSInstr_Compare(Y, {})",
+            MOSInstr_LDA : "A = MOSInstr_Load({})",
+            MOSInstr_LDX : "X = MOSInstr_Load({})",
+            MOSInstr_LDY : "Y = MOSInstr_Load({})",
+            MOSInstr_STA : "cpu_write8({}, A)",
+            MOSInstr_STX : "cpu_write8({}, X)",
+            MOSInstr_STY : "cpu_write8({}, Y)",
+            MOSInstr_INX : "X = " + increment + "(X)",
+            MOSInstr_INY : "Y = " + increment + "(Y)",
+            MOSInstr_DEX : "X = " + decrement + "(X)",
+            MOSInstr_DEY : "Y = " + decrement + "(Y)",
+            MOSInstr_TAX : "X = MOSInstr_Load(A)",
+            MOSInstr_TAY : "Y = MOSInstr_Load(A)",
+            MOSInstr_TXA : "A = MOSInstr_Load(X)",
+            MOSInstr_TYA : "A = MOSInstr_Load(Y)",
+            MOSInstr_TSX : "X = MOSInstr_Load(SP)",
+            MOSInstr_TXS : "SP = X",
+            MOSInstr_PHA : "stack[SP--] = A",
+            MOSInstr_PHP : "stack[SP--] = registers.P",
+            MOSInstr_PLA : "A = MOSInstr_Load(stack[++SP])",
+            MOSInstr_PLP : "cpu_set_flags(stack[++SP])",
+        }.get(instrType)
+        return template.format(argument) if template != None else code
+
+    def __GetCFlagCondition(self, instrType):
+        """Obtains the C condition the given type of conditional branch tests the flags with."""
+        return {
+            MOSInstr_BCC : "!cpu_get_flag(CPU_FLAG_CARRY)",
+            MOSInstr_BCS : "cpu_get_flag(CPU_FLAG_CARRY)",
+            MOSInstr_BEQ : "cpu_get_flag(CPU_FLAG_ZERO)",
+            MOSInstr_BMI : "cpu_get_flag(CPU_FLAG_SIGN)",
+            MOSInstr_BNE : "!cpu_get_flag(CPU_FLAG_ZERO)",
+            MOSInstr_BPL : "!cpu_get_flag(CPU_FLAG_SIGN)",
+            MOSInstr_BVC : "!cpu_get_flag(CPU_FLAG_OVERFLOW)",
+            MOSInstr_BVS : "cpu_get_flag(CPU_FLAG_OVERFLOW)",
+        }[instrType]
+
+    def __GetCBranchCondition(self, instruction, condition):
+        """Obtains the C condition for the given conditional branch, recording its outcome if we're instrumenting for profiling and hinted by the profile."""
+        if(self.INSTRUMENT_PROFILING):
+            condition = "profile_branch({}, {})".format(hex(instruction.address), condition)
+        # Hint branches the profile saw almost always go one way.
+        bias = self.__profile.getBranchBias(instruction.address, self.PROFILE_BRANCH_MIN_SAMPLES) if self.__profile != None else None
+        if(bias != None and bias >= self.PROFILE_BRANCH_BIAS):
+            condition = "GAME_LIKELY({})".format(condition)
+            self.__biasedBranches.add(instruction.address)
+        elif(bias != None and bias <= 1 - self.PROFILE_BRANCH_BIAS):
+            condition = "GAME_UNLIKELY({})".format(condition)
+            self.__biasedBranches.add(instruction.address)
+        return condition
+
+    def __GetCFoldedInstructionCode(self, instruction, known):
+        """
+        Obtains C code which sets the results of the given instruction directly, given what constant propagation knows about it
+        (or None if any result isn't known, or it has nothing to simplify).
+        """
+        if(known.write != None and (known.write[0] == None or known.write[1] == None)):
+            return None
+        if(None in known.registers.values() or None in known.flags.values()):
+            return None
+        if(known.write == None and len(known.registers) == 0 and (len(known.flags) == 0 or instruction.definition.mode == MOSAddressingMode.IMPLIED)):
+            return None
+        statements = ["{} = {}".format(self.__GetCRegister(name), hex(value)) for name, value in sorted(known.registers.items())]
+        if(known.write != None):
+            statements.append("cpu_write8({}, {})".format(self.__GetAddressMacroLabel(known.write[0], self.IOOperationType.WRITE), hex(known.write[1])))
+        if(len(known.flags) > 0):
+            mask = sum([1 << ConstantPropagation.FLAG_BITS[name] for name in known.flags])
+            flags = sum([1 << ConstantPropagation.FLAG_BITS[name] for name, value in known.flags.items() if value])
+            statements.append("GAME_SET_FLAGS({}, {})".format(hex(mask), hex(flags)))
+        return "; ".join(statements)
+
+    def __GetCLiveInstructionCode(self, instruction, argument, code):
+        """
+        Obtains C code for the given instruction which only computes the registers/flags that may be read after it, given its argument and its code
+        otherwise. Returns None if none of them are read (and reading its operand has no side effects), so the instruction doesn't need to execute.
+        """
+        effects = self.__liveness.getEffects(instruction) if self.__liveness != None else None
+        if(effects == None or instruction.definition.isJumpOrBranch or instruction.address in self.__localStackSlots or instruction.address in self.__localStackPulls):
+            return code
+        instrType = type(instruction.definition)
+        mode = instruction.definition.mode
+        defined = effects[1]
+        live = self.__liveness.getLiveAfter(instruction.address) & defined
+        # Instructions which only change registers/flags, reading RAM at most.
+        pureTypes = {MOSInstr_ADC, MOSInstr_SBC, MOSInstr_AND, MOSInstr_ORA, MOSInstr_EOR, MOSInstr_BIT, MOSInstr_CMP, MOSInstr_CPX, MOSInstr_CPY, MOSInstr_CLC, MOSInstr_SEC, MOSInstr_CLV,
+                     MOSInstr_INX, MOSInstr_INY, MOSInstr_DEX, MOSInstr_DEY, MOSInstr_LDA, MOSInstr_LDX, MOSInstr_LDY, MOSInstr_TAX, MOSInstr_TAY, MOSInstr_TXA, MOSInstr_TYA, MOSInstr_TSX}
+        if(mode == MOSAddressingMode.ACCUMULATOR):
+            pureTypes |= {MOSInstr_ASL, MOSInstr_LSR, MOSInstr_ROL, MOSInstr_ROR}
+        if(mode in {MOSAddressingMode.ABSOLUTE, MOSAddressingMode.ABSOLUTE_X, MOSAddressingMode.ABSOLUTE_Y}):
+            pureOperand = instruction.operand + (0xFF if mode != MOSAddressingMode.ABSOLUTE else 0) < 0x2000
+        else:
+            pureOperand = mode not in {MOSAddressingMode.INDIRECT_X, MOSAddressingMode.INDIRECT_Y}
+        if(live == 0 and instrType in pureTypes and pureOperand):
+            self.__unusedInstructions.add(instruction.address)
+            return None
+
+        # Instructions which only set the zero and sign flags besides their register can skip them.
+        if(live & Liveness.getMask("Z N") != 0):
+            return code
+        registerA, registerX, registerY, registerSP = self.__GetCRegister("A"), self.__GetCRegister("X"), self.__GetCRegister("Y"), self.__GetCRegister("SP")
+        template = {
+            MOSInstr_AND : registerA + " &= {}",
+            MOSInstr_ORA : registerA + " |= {}",
+            MOSInstr_EOR : registerA + " ^= {}",
+            MOSInstr_LDA : registerA + " = {}",
+            MOSInstr_LDX : registerX + " = {}",
+            MOSInstr_LDY : registerY + " = {}",
+            MOSInstr_INX : registerX + "++",
+            MOSInstr_INY : registerY + "++",
+            MOSInstr_DEX : registerX + "--",
+            MOSInstr_DEY : registerY + "--",
+            MOSInstr_TAX : registerX + " = " + registerA,
+            MOSInstr_TAY : registerY + " = " + registerA,
+            MOSInstr_TXA : registerA + " = " + registerX,
+            MOSInstr_TYA : registerA + " = " + registerY,
+            MOSInstr_TSX : registerX + " = " + registerSP,
+        }.get(instrType)
+        if(template == None):
+            return code
+        self.__unusedFlags.add(instruction.address)
+        return template.format(argument)
+
+    def __GenerateCInstructionCode(self, rom, prgRom, instruction, body):
+        """Generates C code for a given instruction, within the C function made up of the given code sections."""
         code = ""
         instrType = type(instruction.definition)
-        syncStr = "sync({});".format(instruction.definition.cycles) # cpu_sync calls our interrupts, rendering, etc.
+        description = instruction.definition.description
+        syncStr = "sync({});".format(instruction.definition.cycles) if not self.__loopMerged else "" # cpu_sync calls our interrupts, rendering, etc.
+        # What constant propagation knows about the values this instruction uses (nothing if disabled).
+        known = self.__constants.evaluate(self.__constants.getState(instruction.address), instruction) if self.__constants != None else ConstantPropagationResult()
         # Special cases: { MOSInstr_BCC, MOSInstr_BCS, MOSInstr_BEQ, MOSInstr_BMI, MOSInstr_BNE, MOSInstr_BPL, MOSInstr_BVC, MOSInstr_BVS, MOSInstr_JMP, MOSInstr_JSR, MOSInstr_RTI, MOSInstr_RTS }
         # Also need to check cases where
         if(instrType is MOSInstr_RTI):
-            code = "{} return TRUE;".format(syncStr)
+            code = "{} {}return TRUE;".format(syncStr, self.__GetCSpillCode())
+            syncStr = ""
+        elif(instrType is MOSInstr_RTS and instruction.address in prgRom.computedJumps):
+            # This RTS returns to an address pushed to dispatch (the address + 1), so it's handled like an indirect jump.
+            pop = "stack[++SP]" if self.ALLOW_REGISTER_PROMOTION else "cpu_stack_pop()"
+            code = "{0}\n\tjumpAddress = {1}; jumpAddress |= {1} << 8; jumpAddress++; {2}goto Jump;".format(syncStr, pop, self.__GetCProfileIndirectCode(instruction))
+            syncStr = ""
+        elif(instrType is MOSInstr_RTS and self.__inlineSite != None):
+            # An inlined subroutine returns by continuing after the JSR it was inlined at.
+            code = "{} goto {};".format(syncStr, self.__GetInlineLabel(self.__inlineSite[0], None))
+            syncStr = ""
+        elif(instrType is MOSInstr_RTS and self.USE_RETURN_STACK):
+            # This RTS returns to the address on the stack (the address + 1), usually following the JSR which pushed it.
+            pop = "stack[++SP]" if self.ALLOW_REGISTER_PROMOTION else "cpu_stack_pop()"
+            code = "{0}\n\tjumpAddress = {1}; jumpAddress |= {1} << 8; jumpAddress++; goto Return;".format(syncStr, pop)
+            syncStr = ""
+        elif(instrType is MOSInstr_RTS and self.__memoSubroutine != None):
+            # A memoized subroutine returning after its lookup missed stores its results.
+            code = "{} {}memo_store(&gameMemoSubroutines[{}]); return FALSE;".format(syncStr, self.__GetCSpillCode(), self.__memoSubroutine.arrayIndex)
             syncStr = ""
         elif(instrType is MOSInstr_RTS):
-            code = "{} return FALSE;".format(syncStr)
+            code = "{} {}return FALSE;".format(syncStr, self.__GetCSpillCode())
             syncStr = ""
+        elif(instruction.address in self.__loopLatches and self.__inlineSite == None):
+            # The branch back of a structured loop decides if it iterates again.
+            code, syncStr, description = self.__GetCLoopLatchCode(instruction, description)
         elif(instruction.definition.isJumpOrBranch):
             # If it's not an indirect jump, it will be relative or absolute so we know where we'll jump to and can use an appropriate label.
             if(instruction.definition.mode != MOSAddressingMode.INDIRECT):
                 pointer = NESMemory.offsetToPointer(prgRom.resolveJumpOffset(rom, instruction))
-                label = self.__GetCodeSectionLabels(rom, prgRom, pointer)[0]
                 if(instrType is MOSInstr_JMP):
-                    code = "{}\n\tgoto {};".format(syncStr, label) # TODO: INDIRECT JMP
+                    code = "{}\n\t{}".format(syncStr, self.__GetCTransferCode(rom, prgRom, pointer, body))
+                    syncStr = ""
+                elif(instrType is MOSInstr_JSR and pointer in self.__inlineSubroutines):
+                    return "\t{} // {} (inlined subroutine at {})\n{}".format(syncStr, description, hex(pointer), self.__GenerateCInlineCode(rom, prgRom, instruction, pointer))
+                elif(instrType is MOSInstr_JSR and instruction.address in self.__tailCalls):
+                    # The RTS following this JSR returns where the subroutine returns to, so we return straight after the call (registers stay in the registers structure).
+                    code = "{} {}if({}) return TRUE; return cpu_sync({});".format(syncStr, self.__GetCSpillCode(), self.__GetCCallCode(rom, prgRom, pointer), self.__tailCalls[instruction.address].definition.cycles)
+                    description += " (tail call, with the following RTS)"
+                    syncStr = ""
+                elif(instrType is MOSInstr_JSR and self.USE_RETURN_STACK):
+                    # The return address (the JSR's last byte) is pushed for the subroutine's RTS to return through.
+                    returnAddress = instruction.address + instruction.definition.size - 1
+                    push = "stack[SP--] = {};" if self.ALLOW_REGISTER_PROMOTION else "cpu_stack_push({});"
+                    code = "{} {} {}\n\t{}".format(push.format(hex(returnAddress >> 8)), push.format(hex(returnAddress & 0xFF)), syncStr, self.__GetCTransferCode(rom, prgRom, pointer, body))
                     syncStr = ""
                 elif(instrType is MOSInstr_JSR):
-                    macroID = self.__GetCodeSectionLabelID(label)
-                    code = "{} if(game_execute({})) return TRUE;".format(syncStr, macroID)
+                    code = "{} {}if({}) return TRUE;{}".format(syncStr, self.__GetCSpillCode(), self.__GetCCallCode(rom, prgRom, pointer), self.__GetCLoadCode())
                     syncStr = ""
+                elif(known.branchTaken == True):
+                    # The flag this branch tests is known, so it's always taken (with its additional cycle).
+                    code = "sync({}); {}".format(instruction.definition.cycles + 1, self.__GetCTransferCode(rom, prgRom, pointer, body))
+                    description += " (always taken)"
+                    syncStr = ""
+                    self.__alwaysTakenBranches.add(instruction.address)
+                elif(known.branchTaken == False):
+                    # Or it's never taken, and only takes its cycles.
+                    code = syncStr
+                    description += " (never taken)"
+                    syncStr = ""
+                    self.__neverTakenBranches.add(instruction.address)
                 else:
                     # It must be a conditional branch, figure out our condition
-                    condition = {
-                        MOSInstr_BCC : "!cpu_get_flag(CPU_FLAG_CARRY)",
-                        MOSInstr_BCS : "cpu_get_flag(CPU_FLAG_CARRY)",
-                        MOSInstr_BEQ : "cpu_get_flag(CPU_FLAG_ZERO)",
-                        MOSInstr_BMI : "cpu_get_flag(CPU_FLAG_SIGN)",
-                        MOSInstr_BNE : "!cpu_get_flag(CPU_FLAG_ZERO)",
-                        MOSInstr_BPL : "!cpu_get_flag(CPU_FLAG_SIGN)",
-                        MOSInstr_BVC : "!cpu_get_flag(CPU_FLAG_OVERFLOW)",
-                        MOSInstr_BVS : "cpu_get_flag(CPU_FLAG_OVERFLOW)",
-                    }[instrType]
+                    condition = self.__GetCFlagCondition(instrType)
                     # If we branch we add an additional cycle, otherwise we don't.
-                    code = "if({}) {{ {} goto {}; }}".format(condition, "sync({});".format(instruction.definition.cycles + 1), label)
+                    code = "if({}) {{ {} {} }}".format(self.__GetCBranchCondition(instruction, condition), "sync({});".format(instruction.definition.cycles + 1), self.__GetCTransferCode(rom, prgRom, pointer, body))
             else:
                 # The only indirect jump is the JMP instruction. This will not have a label, and requires special code.
-                code = "{}\n\tjumpAddress = cpu_read16({}); goto Jump;".format(syncStr, hex(instruction.operand))
+                code = "{}\n\tjumpAddress = cpu_read16({}); {}goto Jump;".format(syncStr, hex(instruction.operand), self.__GetCProfileIndirectCode(instruction))
                 syncStr = ""
         else:
             # Obtain our instruction function name.
@@ -281,162 +1687,580 @@ UINT chrRomSize;
                 instrFuncName = self.__GetInstructionFunction(instruction.definition)
             code = "{}({{}})".format(instrFuncName)
             mode = instruction.definition.mode
+            operand = instruction.operand
+            # Indexed and indirect addresses which are known are accessed like absolute ones.
+            if(known.address != None and mode != MOSAddressingMode.ZERO_PAGE and mode != MOSAddressingMode.ABSOLUTE):
+                mode, operand = MOSAddressingMode.ABSOLUTE, known.address
+                self.__resolvedAddresses.add(instruction.address)
             storesBack = instrType in {MOSInstr_ASL, MOSInstr_DEC, MOSInstr_INC, MOSInstr_LSR, MOSInstr_ROL, MOSInstr_ROR}
             
             isStoreInstruction = instrType in {MOSInstr_STA, MOSInstr_STX, MOSInstr_STY}
             usesValue = not isStoreInstruction
             argument = ""
+            registerA, registerX, registerY = self.__GetCRegister("A"), self.__GetCRegister("X"), self.__GetCRegister("Y")
             if(mode == MOSAddressingMode.ABSOLUTE or mode == MOSAddressingMode.ZERO_PAGE):
                 if(isStoreInstruction):
-                    argument = self.__GetAddressMacroLabel(instruction.operand, self.IOOperationType.WRITE)
+                    argument = self.__GetAddressMacroLabel(operand, self.IOOperationType.WRITE)
                 else:
-                    argument = self.__GetAddressMacroLabel(instruction.operand, self.IOOperationType.READ)
-                if(usesValue): argument = "cpu_read8({})".format(argument)
+                    argument = self.__GetAddressMacroLabel(operand, self.IOOperationType.READ)
+                if(usesValue and known.value != None):
+                    # The value read is known (zero page memory), so we use it rather than reading it.
+                    argument = hex(known.value)
+                    self.__resolvedOperands.add(instruction.address)
+                elif(usesValue): argument = "cpu_read8({})".format(argument)
                 code = code.format(argument)
-                if(storesBack): code = "cpu_write8({}, {})".format(self.__GetAddressMacroLabel(instruction.operand, self.IOOperationType.WRITE), code)
+                if(storesBack): code = "cpu_write8({}, {})".format(self.__GetAddressMacroLabel(operand, self.IOOperationType.WRITE), code)
             elif(mode == MOSAddressingMode.ZERO_PAGE_X):
-                argument = "(registers.X + {}) & 0xFF".format(hex(instruction.operand))
+                argument = "({} + {}) & 0xFF".format(registerX, hex(instruction.operand))
                 if(usesValue): argument = "cpu_read8({})".format(argument)
                 code = code.format(argument) # TODO: Check page crossing boundary
-                if(storesBack): code = "cpu_write8((registers.X + {}) & 0xFF, {})".format(hex(instruction.operand), code)
+                if(storesBack): code = "cpu_write8(({} + {}) & 0xFF, {})".format(registerX, hex(instruction.operand), code)
             elif(mode == MOSAddressingMode.ABSOLUTE_X):
-                argument = "registers.X + {}".format(hex(instruction.operand))
+                argument = "{} + {}".format(registerX, hex(instruction.operand))
                 if(usesValue): argument = "cpu_read8({})".format(argument)
                 code = code.format(argument) # TODO: Check page crossing boundary
-                if(storesBack): code = "cpu_write8(registers.X + {}, {})".format(hex(instruction.operand), code)
+                if(storesBack): code = "cpu_write8({} + {}, {})".format(registerX, hex(instruction.operand), code)
             elif(mode == MOSAddressingMode.ZERO_PAGE_Y):
-                argument = "(registers.Y + {}) & 0xFF".format(hex(instruction.operand))
+                argument = "({} + {}) & 0xFF".format(registerY, hex(instruction.operand))
                 if(usesValue): argument = "cpu_read8({})".format(argument)
                 code = code.format(argument) # TODO: Check page crossing boundary
-                if(storesBack): code = "cpu_write8((registers.Y + {}) & 0xFF, {})".format(hex(instruction.operand), code)
+                if(storesBack): code = "cpu_write8(({} + {}) & 0xFF, {})".format(registerY, hex(instruction.operand), code)
             elif(mode == MOSAddressingMode.ABSOLUTE_Y):
-                argument = "registers.Y + {}".format(hex(instruction.operand))
+                argument = "{} + {}".format(registerY, hex(instruction.operand))
                 if(usesValue): argument = "cpu_read8({})".format(argument)
                 code = code.format(argument) # TODO: Check page crossing boundary
-                if(storesBack): code = "cpu_write8(registers.Y + {}, {})".format(hex(instruction.operand), code)
+                if(storesBack): code = "cpu_write8({} + {}, {})".format(registerY, hex(instruction.operand), code)
             elif(mode == MOSAddressingMode.ACCUMULATOR):
-                argument = "registers.A"
+                argument = registerA
                 code = code.format(argument)
-                if(storesBack): code = "registers.A = {}".format(code)
+                if(storesBack): code = "{} = {}".format(registerA, code)
             elif(mode == MOSAddressingMode.IMMEDIATE):
                 argument = hex(instruction.operand)
                 code = code.format(argument)
                 if(storesBack): raise ValueError("Cannot store back to an immediate value.")
             elif(mode == MOSAddressingMode.INDIRECT_X):
-                argument = "cpu_read16((registers.X + {}) & 0xFF)".format(hex(instruction.operand))
+                argument = "cpu_read16(({} + {}) & 0xFF)".format(registerX, hex(instruction.operand))
                 if(usesValue): argument = "cpu_read8({})".format(argument)
                 code = code.format(argument) # TODO: Check page crossing boundary
-                if(storesBack): code = "cpu_write8(cpu_read16((registers.X + {}) & 0xFF), {})".format(hex(instruction.operand), code)
+                if(storesBack): code = "cpu_write8(cpu_read16(({} + {}) & 0xFF), {})".format(registerX, hex(instruction.operand), code)
             elif(mode == MOSAddressingMode.INDIRECT_Y):
-                argument = "registers.Y + cpu_read16({})".format(hex(instruction.operand))
+                pointer = self.__loopPointers.get(instruction.operand, "cpu_read16({})".format(hex(instruction.operand)))
+                argument = "{} + {}".format(registerY, pointer)
                 if(usesValue): argument = "cpu_read8({})".format(argument)
                 code = code.format(argument)
-                if(storesBack): code = "cpu_write8(registers.Y + cpu_read16({}), {})".format(hex(instruction.operand), code)
+                if(storesBack): code = "cpu_write8({} + {}, {})".format(registerY, pointer, code)
             else:
                 code = code.format(argument)
+            # Instructions using registers kept in local variables use them directly (or pass them to a function which takes them).
+            if(self.ALLOW_REGISTER_PROMOTION):
+                code = self.__GetCRegisterInstructionCode(instruction, argument, code)
+            # Instructions whose results are never read only take their cycles, or skip computing flags which are never read.
+            liveCode = self.__GetCLiveInstructionCode(instruction, argument, code)
+            if(liveCode == None and syncStr == ""):
+                return "\t// {} (result unused)\n".format(description)
+            if(liveCode == None):
+                code = syncStr[:-1]
+                description += " (result unused)"
+                syncStr = ""
+                self.__resolvedOperands.discard(instruction.address)
+            else:
+                code = liveCode
+            # Instructions whose results are all known only set them.
+            foldedCode = self.__GetCFoldedInstructionCode(instruction, known) if liveCode != None else None
+            if(foldedCode != None):
+                code = foldedCode
+                self.__resolvedOperands.discard(instruction.address)
+                self.__unusedFlags.discard(instruction.address)
+                self.__foldedInstructions.add(instruction.address)
 
             # IMPLIED has no operands, RELATIVE + INDIRECT are only used by jumps which are specially handled elsewhere.
             code += ";"
         if(code != ""):
-            code = "\t{} // {}\n".format(code, instruction.definition.description);
+            code = "\t{} // {}\n".format(code, description);
             if(syncStr != ""):
                 code += "\t" + syncStr + "\n"
                 
         return code
-    def __GenerateCSource(self, rom, prgRom):
-        """Disassembles the given ROM to C Source for use with NESsys."""
-        source = """
+    def __WriteCFunctionCode(self, rom, prgRom, output, body, entryAddress=None, prologue=""):
+        """
+        Writes C code for the given code sections (from lower to higher addresses, or hot to cold with a profile), which make up a C function.
+        If an entry address is given, its code section is output first (where the function begins executing). The prologue is output
+        after the function's local variable declarations, before its code sections.
+        """
+        idiomExitAddresses = set([loop.exitAddress for loop in self.__idiomLoops.values()]) | set([routine.exitAddress for routine in self.__knownRoutines.values()])
+        sectionAddresses = sorted(body)
+        if(self.__profile != None):
+            sectionAddresses = sorted(body, key=lambda address: (-self.__profile.getBlockCount(address), address))
+        if(entryAddress != None):
+            sectionAddresses.remove(entryAddress)
+            sectionAddresses.insert(0, entryAddress)
+        hasHotCode = self.__profile != None and any(self.__profile.getBlockCount(address) > 0 for address in body)
+        # Natural loops output together are output as do/while loops, ending with their branch back.
+        structured = self.__GetStructuredLoops(rom, prgRom, body, sectionAddresses)
+        closing = dict([(loop.latches[latch].address, loop) for loop, latch in structured.values() if loop.tripCount == None])
+        self.__loopLatches = dict([(loop.latches[latch].address, ("loop", loop)) for loop, latch in structured.values()])
+        self.__structuredLoopCount += len(structured)
+        output.write(self.__GetCLoopDeclarations(structured))
+        output.write(prologue)
+        for x in range(0, len(sectionAddresses)):
+            section = prgRom.codeSections[sectionAddresses[x]]
+            loop = structured[section.address][0] if section.address in structured else None
+            # Loops iterating a known number of times are output once per iteration (followed by the rest of their code section).
+            instructions = [(instruction, 0) for instruction in section.instructions]
+            if(loop != None and loop.tripCount != None):
+                loopInstructions = self.__GetLoopInstructions(prgRom, loop)
+                instructions = [(instruction, copy) for copy in range(0, loop.tripCount) for instruction in loopInstructions] + instructions[len(loopInstructions):]
+            # Now for each instruction (skipping those fused into the sequence before them, or the RTS of a tail call)...
+            skipUntil = None
+            for instruction, copy in instructions:
+                if(instruction.address == section.address):
+                    skipUntil = None
+                if(skipUntil != None and instruction.address < skipUntil):
+                    continue
+                # Output all goto labels first for this address
+                labels = self.__GetCodeSectionLabels(rom, prgRom, instruction.address) if copy == 0 else []
+                if(instruction.address in self.__returnSites and copy == 0 and self.__inlineSite == None):
+                    labels = labels + [self.__GetReturnLabel(instruction.address)]
+                for label in labels:
+                    output.write("{}:\n".format(label))
+                if(instruction.address == section.address):
+                    # Code the profile never saw executed (in a function which was) is moved out of the way of the code which was.
+                    if(copy == 0 and hasHotCode and self.__profile.getBlockCount(section.address) == 0):
+                        output.write("____cold_{}: GAME_COLD_LABEL;\n".format(hex(section.address)[2:]))
+                        self.__coldSectionCount += 1
+                    if(loop != None and loop.tripCount != None):
+                        output.write("\t// Loop iteration {} of {} (unrolled)\n".format(copy + 1, loop.tripCount))
+                    elif(loop != None):
+                        output.write(self.__GetCLoopHeader(loop))
+                    if(self.INSTRUMENT_PROFILING):
+                        output.write("\tprofile_block({});\n".format(hex(section.address)))
+                    # Iterations which can't be interrupted only sync once.
+                    if(loop != None and loop.tripCount == None and loop.merged):
+                        output.write(self.__GenerateCMergedLoopCode(rom, prgRom, loop, body) + "\telse\n\t{\n")
+                if(loop != None and loop.tripCount != None and instruction is loop.latches[section.address]):
+                    self.__loopLatches[instruction.address] = ("taken" if copy + 1 < loop.tripCount else "exit", loop)
+                # If a recognized loop or known routine exits here, or starts here, output its exit label or bulk/native execution.
+                if(instruction.address in idiomExitAddresses and copy == 0):
+                    output.write("{}:\n".format(self.__GetIdiomExitLabel(instruction.address)))
+                if(instruction.address in self.__idiomLoops):
+                    idiomLoop = self.__idiomLoops[instruction.address]
+                    if(idiomLoop.exitAddress < section.address + section.getSize() or idiomLoop.exitAddress in body):
+                        output.write("\tidiom(&gameIdiomLoops[{}], {}); // {} loop: {}\n".format(idiomLoop.arrayIndex, self.__GetIdiomExitLabel(idiomLoop.exitAddress), idiomLoop.kind[0].upper() + idiomLoop.kind[1:], idiomLoop.text))
+                if(instruction.address in self.__knownRoutines and copy == 0):
+                    knownRoutine = self.__knownRoutines[instruction.address]
+                    if(any(address <= knownRoutine.exitAddress < address + prgRom.codeSections[address].getSize() for address in body)):
+                        output.write("\thle(&gameKnownRoutines[{}], {}); // Known routine, {}: {}\n".format(knownRoutine.arrayIndex, self.__GetIdiomExitLabel(knownRoutine.exitAddress), knownRoutine.routine.name, knownRoutine.text))
+                # And output out the instruction code (or the fused sequence it begins, unless it includes a loop's branch back).
+                fusion = self.__fusions.get(instruction.address)
+                if(fusion != None and not any(fused.address in self.__loopLatches for fused in fusion.instructions)):
+                    output.write(self.__GenerateCFusionCode(rom, prgRom, fusion, body))
+                    skipUntil = fusion.instructions[-1].address + 1
+                else:
+                    output.write(self.__GenerateCInstructionCode(rom, prgRom, instruction, body))
+                    # A tail call includes the RTS following it.
+                    if(instruction.address in self.__tailCalls):
+                        skipUntil = self.__tailCalls[instruction.address].address + 1
+                # A structured loop ends with its branch back.
+                if(instruction.address in closing):
+                    if(closing[instruction.address].merged):
+                        output.write("\t}\n")
+                    output.write("\t}} while(loopTaken_{});\n".format(hex(closing[instruction.address].header)[2:]))
+                    self.__loopPointers = {}
+            # If this section continues into one we don't output right after it (it's in another function), continue there explicitly.
+            if(len(section.instructions) > 0 and not section.instructions[-1].definition.marksEndOfSection):
+                nextAddress = section.address + section.getSize()
+                if(x + 1 >= len(sectionAddresses) or sectionAddresses[x + 1] != nextAddress):
+                    output.write("\t{}\n".format(self.__GetCTransferCode(rom, prgRom, nextAddress, body)))
+        self.__loopLatches = {}
+
+    def __GetCJumpEntries(self, rom, prgRom, body, entrySections):
+        """
+        Obtains the jump table entries (address, case value, code section address) for the given code sections, 
+        within the C function made up of the given body code sections.
+        """
+        entries = []
+        # First we add common (known) jumps just in case our compiler puts these sequentially.
+        for address in entrySections:
+            label = self.__GetCodeSectionLabels(rom, prgRom, address)[0]
+            entries.append((address, self.__GetCodeSectionLabelID(label), address))
+                
+        # Second we add all runtime locations just in case our game calculates a jump offset we couldn't resolve.
+        if(len(self.__runtimeLocations) > 0):
+            for address in prgRom.codeSections:
+                if(address not in entrySections and address not in body):
+                    continue
+                # Now for each location in our section (each instruction) which has a label.
+                for instruction in prgRom.codeSections[address].instructions:
+                    if instruction.address not in self.__runtimeLocations:
+                        continue
+                    entries.append((instruction.address, hex(instruction.address), address))
+        return entries
+
+    def __GetDelegateLabel(self, address):
+        """Returns a label in game_execute() which continues execution in the subroutine function at the given address."""
+        return "____delegate_" + hex(address)[2:]
+
+    def __GenerateCJumpCases(self, rom, prgRom, body, entries, includeMirrors):
+        """
+        Generates the cases of a jump table switch for the given jump table entries, within the C function made up of the given body code sections.
+        Entries to code sections in another function continue execution in that function.
+        """
+        source = ""
+        for (address, caseValue, sectionAddress) in entries:
+            source += "\tcase {}:\n".format(caseValue)
+            # If our ROM is only one bank in size, it's mirrored onto the second bank as well, so we maintain support for this.
+            if(includeMirrors and NESMemory.isMirroredROM(rom)):
+                source += "\tcase {}:\n".format(hex((address - NESMemory.PRG_ROM_FIRST_BANK_ADDR) + NESMemory.PRG_ROM_SECOND_BANK_ADDR))
+            if(sectionAddress in body):
+                source += "\t\tgoto {};\n".format(self.__GetCodeSectionLabels(rom, prgRom, address)[0])
+            else:
+                source += "\t\t{}return {}({});\n".format(self.__GetCSpillCode(), self.__GetFunctionName(self.__sectionOwners[sectionAddress]), caseValue)
+        return source
+
+    def __GenerateCJumpTable(self, rom, prgRom, body, entries, baseAddress, size):
+        """
+        Generates a dense jump table of label offsets (relative to JumpDefault) for the given jump table entries, 
+        indexed by address - baseAddress, within the C function made up of the given body code sections.
+        Entries to code sections in another function go to that function's delegate label.
+        """
+        source = "        static const INT jumpTable[{}] =\n        {{\n".format(hex(size))
+        for (address, caseValue, sectionAddress) in sorted(entries):
+            if(sectionAddress in body):
+                label = self.__GetCodeSectionLabels(rom, prgRom, address)[0]
+            else:
+                label = self.__GetDelegateLabel(self.__sectionOwners[sectionAddress])
+            source += "            [{}] = &&{} - &&JumpDefault,\n".format(hex(address - baseAddress), label)
+        source += "        };\n"
+        return source
+
+    def __GenerateCJumpDispatch(self, rom, prgRom, body, entries, baseAddress, size, defaultCode):
+        """
+        Generates the jump table following the Jump label, within the C function made up of the given body code sections.
+        Where the compiler supports label addresses (computed goto), addresses from baseAddress to baseAddress + size are dispatched
+        with a single indexed jump through a dense table, otherwise with a switch. Addresses without an entry execute the default code.
+        """
+        isExecute = body is self.__executeBody
+        isMirrored = isExecute and NESMemory.isMirroredROM(rom)
+        useTable = self.ALLOW_COMPUTED_GOTO_DISPATCH and len(entries) > 0 and size <= (0x8000 if isExecute else self.SUBROUTINE_JUMP_TABLE_MAX_SIZE)
+        self.__jumpEntryCount += len(entries)
+        source = "    Jump:\n"
+        if(useTable):
+            self.__denseJumpEntryCount += len(entries)
+            source += "#if GAME_USE_COMPUTED_GOTO\n"
+            source += "    {\n"
+            source += self.__GenerateCJumpTable(rom, prgRom, body, entries, baseAddress, size)
+            if(isExecute):
+                source += "        if(jumpAddress >= {})\n        {{\n".format(hex(baseAddress))
+                if(isMirrored):
+                    source += "            jumpAddress &= {}; // Our ROM is mirrored onto the second bank.\n".format(hex(0xFFFF - (NESMemory.PRG_ROM_SECOND_BANK_ADDR - NESMemory.PRG_ROM_FIRST_BANK_ADDR)))
+                source += "            goto *(&&JumpDefault + jumpTable[jumpAddress - {}]);\n        }}\n".format(hex(baseAddress))
+            else:
+                source += "        if((USHORT)(jumpAddress - {0}) < {1})\n            goto *(&&JumpDefault + jumpTable[(USHORT)(jumpAddress - {0})]);\n".format(hex(baseAddress), hex(size))
+            source += "    }\n"
+            source += "#else\n"
+        if(len(entries) > 0):
+            source += "    switch(jumpAddress)\n    {\n"
+            source += self.__GenerateCJumpCases(rom, prgRom, body, entries, isMirrored)
+            source += "    }\n"
+        if(useTable):
+            source += "#endif\n"
+        source += "    JumpDefault:\n"
+        source += defaultCode
+        
+        # Locations in subroutines are executed by calling the subroutine's function, which we need labels for in our dense table.
+        delegates = sorted(set([self.__sectionOwners[sectionAddress] for (address, caseValue, sectionAddress) in entries if sectionAddress not in body]))
+        if(useTable and len(delegates) > 0):
+            source += "#if GAME_USE_COMPUTED_GOTO\n"
+            for delegate in delegates:
+                source += "    {}:\n        {}return {}(jumpAddress);\n".format(self.__GetDelegateLabel(delegate), self.__GetCSpillCode(), self.__GetFunctionName(delegate))
+            source += "#endif\n"
+        return source
+
+    def __GetCFunctionAttributes(self, address):
+        """Obtains the attributes of the C function for the subroutine at the given address (cold if the profile never saw it called)."""
+        if(self.__profile != None and self.__profile.getBlockCount(address) == 0):
+            return "GAME_COLD "
+        return ""
+
+    def __WriteCSubroutineFunction(self, rom, prgRom, functionOutput, address):
+        """Writes a C function for the subroutine at the given address."""
+        output = io.StringIO()
+        body = self.__functions[address]
+        label = self.__GetCodeSectionLabels(rom, prgRom, address)[0]
+        entrySections = [sectionAddress for sectionAddress in prgRom.codeSections if sectionAddress in body and sectionAddress != address]
+        entries = self.__GetCJumpEntries(rom, prgRom, body, entrySections)
+        hasIndirectJump = any(instruction.address in prgRom.computedJumps for sectionAddress in body for instruction in prgRom.codeSections[sectionAddress].instructions)
+        
+        # Describe what the subroutine reads, writes and preserves, if we know.
+        summary = self.__liveness.getSummaries().get(address) if self.__liveness != None else None
+        description = ""
+        if(summary != None and summary.understood):
+            names = [", ".join(Liveness.getNames(mask)) or "nothing" for mask in [summary.reads, summary.writes, Liveness.ALL & ~summary.writes]]
+            description = "\n * Reads {}; writes {}; preserves {}.".format(*names)
+        output.write("""
+/*
+ * Subroutine at {}.{}
+ */
+{}{}BOOL {}(USHORT jumpAddress)
+{{
+""".format(hex(address), description, self.__GetCFunctionLinkage(), self.__GetCFunctionAttributes(address), self.__GetFunctionName(address)))
+        output.write(self.__GetCRegisterDeclarations(body))
+        # Calls begin at the start of the subroutine, runtime calculated (indirect) jumps into it use its own jump table.
+        prologue = ""
+        if(len(entries) > 0 or hasIndirectJump):
+            prologue += """	if(jumpAddress != {})
+		goto Jump;
+
+""".format(self.__GetCodeSectionLabelID(label))
+        # Memoized subroutines look their results up when called (jumps within them don't).
+        self.__memoSubroutine = self.__memoSubroutines.get(address)
+        if(self.__memoSubroutine != None):
+            prologue += "\tmemoize(&gameMemoSubroutines[{}]); // {}\n".format(self.__memoSubroutine.arrayIndex, self.__memoSubroutine.getText())
+        self.__WriteCFunctionCode(rom, prgRom, output, body, address, prologue)
+        self.__memoSubroutine = None
+        if(len(entries) > 0 or hasIndirectJump):
+            baseAddress = min([entry[0] for entry in entries]) if len(entries) > 0 else address
+            size = (max([entry[0] for entry in entries]) + 1 - baseAddress) if len(entries) > 0 else 0
+            output.write("""
+    // Jump table for locations in this subroutine. Anything else is executed by game_execute().
+""")
+            output.write(self.__GenerateCJumpDispatch(rom, prgRom, body, entries, baseAddress, size, "        {}return game_execute(jumpAddress);\n".format(self.__GetCSpillCode())))
+        output.write("""
+    {}return FALSE;
+}}
+""".format(self.__GetCSpillCode()))
+        # Calls enter at the top of the function, so its own labels are only needed if it branches back to its start.
+        functionOutput.write(self.__RemoveUnusedLabels(output.getvalue(), self.__GetCodeSectionLabels(rom, prgRom, address)))
+
+    def __GetReachableSections(self, rom, prgRom, addresses, stopAddresses):
+        """Obtains the set of code section addresses reachable from the given ones without a call (JSR), or passing the stop addresses."""
+        reachable = set([])
+        pending = list(addresses)
+        while(len(pending) > 0):
+            address = pending.pop()
+            if(address in reachable or address not in prgRom.codeSections):
+                continue
+            reachable.add(address)
+            
+            pending.extend([successor for successor in self.__GetSectionSuccessors(rom, prgRom, prgRom.codeSections[address]) if successor not in stopAddresses])
+        return reachable
+
+    def __GetSectionSuccessors(self, rom, prgRom, section):
+        """Obtains the addresses the given code section continues at without a call: branch and absolute jump targets, and the section following it."""
+        successors = []
+        for instruction in section.instructions:
+            if(instruction.definition.isJumpOrBranch and type(instruction.definition) is not MOSInstr_JSR and instruction.definition.mode != MOSAddressingMode.INDIRECT):
+                jumpOffset = prgRom.resolveJumpOffset(rom, instruction)
+                if(jumpOffset != None):
+                    successors.append(NESMemory.offsetToPointer(jumpOffset))
+            # Runtime calculated jumps we resolved statically continue in their targets.
+            successors.extend(prgRom.computedJumps.get(instruction.address, []))
+        if(len(section.instructions) > 0 and not section.instructions[-1].definition.marksEndOfSection):
+            successors.append(section.address + section.getSize())
+        return successors
+    
+    def __FindFunctions(self, rom, prgRom):
+        """
+        Determines which C function each code section is output in. 
+        Subroutines (JSR targets) get their own function, made up of all code reachable from them without a call.
+        Interrupts and any remaining code are output in game_execute().
+        (Code reachable from multiple subroutines is output in each of them)
+        """
+        interruptAddresses = set([NESMemory.offsetToPointer(NESMemory.pointerToOffset(rom, pointer)) for pointer in [prgRom.interruptNMI, prgRom.interruptReset, prgRom.interruptIRQ]])
+        subroutineAddresses = []
+        if(self.ALLOW_SUBROUTINE_FUNCTIONS and not self.USE_RETURN_STACK):
+            subroutineAddresses = [address for address in sorted(prgRom.codeSections.keys()) if prgRom.codeSections[address].referenceType == PRGROMCodeSectionType.FUNCTION and address not in interruptAddresses]
+        stopAddresses = set(subroutineAddresses) | interruptAddresses
+        
+        # Determine every subroutine's code, and which function executes code sections game_execute() doesn't contain.
+        self.__functions = {}
+        self.__sectionOwners = {}
+        for address in subroutineAddresses:
+            self.__functions[address] = self.__GetReachableSections(rom, prgRom, [address], stopAddresses - set([address]))
+            for sectionAddress in self.__functions[address]:
+                self.__sectionOwners.setdefault(sectionAddress, address)
+        executeAddresses = [address for address in prgRom.codeSections if address in interruptAddresses or address not in self.__sectionOwners]
+        self.__executeBody = self.__GetReachableSections(rom, prgRom, executeAddresses, set(subroutineAddresses))
+        
+        if(self.ALLOW_SUBROUTINE_FUNCTIONS and not self.USE_RETURN_STACK):
+            duplicated = sum([len(body) for body in self.__functions.values()]) + len(self.__executeBody) - len(prgRom.codeSections)
+            print("Subroutine functions: {} subroutines output as their own function, {} of {} code sections remain in game_execute() ({} output more than once).".format(len(self.__functions), len(self.__executeBody), len(prgRom.codeSections), duplicated))
+
+    def __BeginCUnit(self, outputs, units):
+        """
+        Obtains the output for the next subroutine function or block of data. If split across shards, it's buffered as a unit
+        (to be balanced across shards by size once all are output), otherwise it's written to the only output directly.
+        """
+        if(len(outputs) <= 1):
+            return outputs[0]
+        units.append(io.StringIO())
+        return units[-1]
+
+    def __WriteCShards(self, outputs, units, executeSize):
+        """
+        Writes the given units (subroutine functions and blocks of data) to the shards, balancing the size of the C code in each (largest units first).
+        The first shard holds game_execute(), so it only receives units once the others are as large. Units keep their order within a shard.
+        """
+        shardSizes = [executeSize] + ([0] * (len(outputs) - 1))
+        unitShards = [0] * len(units)
+        for index in sorted(range(0, len(units)), key=lambda index: (-len(units[index].getvalue()), index)):
+            shard = shardSizes.index(min(shardSizes))
+            unitShards[index] = shard
+            shardSizes[shard] += len(units[index].getvalue())
+        for index in range(0, len(units)):
+            outputs[unitShards[index]].write(units[index].getvalue())
+        for output in outputs:
+            output.write("\n#endif")
+        print("Shards: {} C source files, holding {} bytes of C code and data (game_execute() is in the first).".format(len(outputs), ", ".join([str(size) for size in shardSizes])))
+
+    def __GetShardPath(self, sourcePath, shard):
+        """Obtains the path of the given C source file shard (the first is the source path given, the rest are numbered after it)."""
+        if(shard == 0):
+            return sourcePath
+        root, extension = os.path.splitext(sourcePath)
+        return "{}_{}{}".format(root, shard, extension)
+
+    def __RemoveStaleShards(self, sourcePath):
+        """Removes C source file shards a previous run output more of (which would define their functions again when compiled together)."""
+        shard = max(self.SOURCE_SHARDS, 1)
+        while(os.path.isfile(self.__GetShardPath(sourcePath, shard))):
+            path = self.__GetShardPath(sourcePath, shard)
+            with open(path, "r") as file:
+                if(not file.readline().startswith(self.SOURCE_SHARD_MARKER)):
+                    break
+            os.remove(path)
+            print("Shards: removed {}, output by a previous run with more shards.".format(path))
+            shard += 1
+
+    def __RegisterGame(self, listPath):
+        """Adds our game to the list of games generated into the header's directory, which NESsys builds containing multiple games link in."""
+        names = set([])
+        if(os.path.exists(listPath)):
+            with open(listPath, "r") as file:
+                for line in file:
+                    if(line.startswith("GAME_REGISTER(")):
+                        names.add(line[len("GAME_REGISTER("):line.index(")")])
+        names.add(self.GAME_SYMBOL_PREFIX)
+        with open(listPath, "w") as file:
+            file.write("// NESgen games list: games generated with -G into this directory, linked into NESsys builds containing multiple games.\n")
+            for name in sorted(names):
+                file.write("GAME_REGISTER({})\n".format(name))
+        print("Games: registered {} in {} ({} games).".format(self.GAME_SYMBOL_PREFIX, listPath, len(names)))
+
+    def __GetCFunctionLinkage(self):
+        """Obtains the storage class of subroutine functions (static, unless they're split across C source files and called between them)."""
+        return "static " if self.SOURCE_SHARDS <= 1 else ""
+
+    def __WriteCSource(self, rom, prgRom, outputs):
+        """
+        Disassembles the given ROM to C Source for use with NESsys, writing it to the given outputs as it's generated.
+        game_execute() is written to the first output, subroutine functions and data are balanced across all of them (if there's more than one).
+        """
+        units = []
+        for shard in range(1, len(outputs)):
+            outputs[shard].write("""{} {} of {}: subroutine functions and data (game_execute() is in the first).
+#include "{}"
+
+#if !APPLICATION_USE_TEMPLATE
+""".format(self.SOURCE_SHARD_MARKER, shard + 1, len(outputs), self.__headerName))
+        output = outputs[0]
+        output.write("""
 #include <stdio.h>
-#include "game.h"
+#include "{}"
 
 #if !APPLICATION_USE_TEMPLATE
 // ---------------------------------
 // Functions
 // ---------------------------------
-BOOL game_execute(USHORT jumpAddress)
+""".format(self.__headerName))
+        self.__jumpEntryCount = 0
+        self.__denseJumpEntryCount = 0
+        self.__biasedBranches = set([])
+        self.__coldSectionCount = 0
+        self.__foldedInstructions = set([])
+        self.__resolvedOperands = set([])
+        self.__resolvedAddresses = set([])
+        self.__alwaysTakenBranches = set([])
+        self.__neverTakenBranches = set([])
+        self.__unusedInstructions = set([])
+        self.__unusedFlags = set([])
+        self.__structuredLoopCount = 0
+        # Declare our subroutine functions first, so any function can call them (they're declared in the header if split across shards).
+        if(len(outputs) <= 1):
+            for address in sorted(self.__functions.keys()):
+                output.write("static {}BOOL {}(USHORT jumpAddress);\n".format(self.__GetCFunctionAttributes(address), self.__GetFunctionName(address)))
+        output.write("""BOOL game_execute(USHORT jumpAddress)
 { 
-    // Go to our jump table first to find out where to execute.
+""" + self.__GetCRegisterDeclarations(self.__executeBody) + """    // Go to our jump table first to find out where to execute.
     // We do this to display game code first and hide the bloated jump table for later.
     goto Jump;
     
     // Game code follows...
-"""
+""")
         # Generate our program code (from lower to higher addresses)
-        for sectionAddress in sorted(prgRom.codeSections.keys()):
-            # Now for each instruction...
-            for instruction in prgRom.codeSections[sectionAddress].instructions:
-                # Output all goto labels first for this address
-                labels = self.__GetCodeSectionLabels(rom, prgRom, instruction.address)
-                for label in labels:
-                    source += "{}:\n".format(label)
-                # And output out the instruction code.
-                source += self.__GenerateCInstructionCode(rom, prgRom, instruction)
+        self.__WriteCFunctionCode(rom, prgRom, output, self.__executeBody)
         # Close up our function
-        source += """
+        output.write("""
         
-    // Switch table for functions here first.
+    // Jump table for functions here first.
     // This jumps to the appropriate code location based off a given address.
     // Absolute jumps jump directly, runtime calculated (indirect) jumps use this table.
     // Anything that calls this function obviously also uses this to begin in the correct location since goto's are local.
     // NOTE: We can only put one case per address even though there may be multiple labels at a given address.
-    Jump:
-    switch(jumpAddress)
-    {
-"""
-        # Print our goto switch table..
-        
-        # First we print common (known) jumps just in case our compiler puts these sequentially.
-        for address in prgRom.codeSections:
-                # Print our goto case
-                label = self.__GetCodeSectionLabels(rom, prgRom, address)[0]
-                source += "\tcase {}:\n".format(self.__GetCodeSectionLabelID(label))
-                # If our ROM is only one bank in size, it's mirrored onto the second bank as well, so we maintain support for this.
-                if(NESMemory.isMirroredROM(rom)):
-                    source += "\tcase {}:\n".format(hex((address - NESMemory.PRG_ROM_FIRST_BANK_ADDR) + NESMemory.PRG_ROM_SECOND_BANK_ADDR))
-                source += "\t\tgoto {};\n".format(label)
-                
-        # Second we print all runtime locations just in case our game calculates a jump offset.
-        if(self.ALLOW_RUNTIME_LOCATIONS):
-            for address in prgRom.codeSections:
-                # Now for each location in our section (each instruction)
-                for instruction in prgRom.codeSections[address].instructions:
-                    # Verify we haven't already printed this (first instruction of a code section)
-                    if address == instruction.address:
-                        continue
-                    # Print our goto case
-                    label = self.__GetCodeSectionLabels(rom, prgRom, instruction.address)[0]
-                    source += "\tcase {}:\n".format(hex(instruction.address))
-                    # If our ROM is only one bank in size, it's mirrored onto the second bank as well, so we maintain support for this.
-                    if(NESMemory.isMirroredROM(rom)):
-                        source += "\tcase {}:\n".format(hex((instruction.address - NESMemory.PRG_ROM_FIRST_BANK_ADDR) + NESMemory.PRG_ROM_SECOND_BANK_ADDR))
-                    source += "\t\tgoto {};\n".format(label)
-        # Finally, print our default case (error)
-        source += "\tdefault:\n"
-        source += "\t\terror(\"{}\", jumpAddress);\n".format("Attempted to jump to an non-executable location 0x%04x. This location may have been calculated at runtime and not supported by the compiler, the ROM may be faulty, or improper emulation of some component has caused undesirable runtime effects.")
-        source += """
-    }
-
-
-    return FALSE;
-}
-
+    // (Locations in subroutines are executed by calling the subroutine's function)
+""")
+        # Print our jump table, with our default case (locations without a label are interpreted until they reach one).
+        size = NESMemory.PRG_ROM_SECOND_BANK_ADDR - NESMemory.PRG_ROM_FIRST_BANK_ADDR if NESMemory.isMirroredROM(rom) else 0x10000 - NESMemory.PRG_ROM_FIRST_BANK_ADDR
+        entries = self.__GetCJumpEntries(rom, prgRom, self.__executeBody, list(prgRom.codeSections.keys()))
+        self.__executeEntries = entries
+        output.write(self.__GenerateCJumpDispatch(rom, prgRom, self.__executeBody, entries, NESMemory.PRG_ROM_FIRST_BANK_ADDR, size, "        {}return interpreter_execute(jumpAddress);\n".format(self.__GetCSpillCode())))
+        if(self.USE_RETURN_STACK):
+            output.write(self.__GenerateCReturnDispatch(prgRom))
+        output.write("""}
+""")
+        executeSize = output.tell()
+        # Output our subroutine functions.
+        for address in sorted(self.__functions.keys()):
+            self.__WriteCSubroutineFunction(rom, prgRom, self.__BeginCUnit(outputs, units), address)
+        if(self.ALLOW_COMPUTED_GOTO_DISPATCH):
+            print("Jump tables: {} of {} jump table entries dispatched through dense (computed goto) tables.".format(self.__denseJumpEntryCount, self.__jumpEntryCount))
+        if(self.ALLOW_REGISTER_PROMOTION):
+            print("Registers: kept in local variables in {} C functions, {} PHA/PLA pairs pass their value through a local variable.".format(len(self.__functions) + 1, len(self.__localStackSlots)))
+        if(self.ALLOW_CONSTANT_FOLDING):
+            deadBranchCount = len(self.__alwaysTakenBranches) + len(self.__neverTakenBranches)
+            print("Constants: {} instructions folded, {} operands and {} addresses resolved from known values, {} dead branches removed ({} always taken, {} never taken).".format(len(self.__foldedInstructions), len(self.__resolvedOperands), len(self.__resolvedAddresses), deadBranchCount, len(self.__alwaysTakenBranches), len(self.__neverTakenBranches)))
+        if(self.USE_RETURN_STACK):
+            print("Return stack: JSRs push their return address, RTSs dispatch to {} return sites ({}).".format(len(self.__returnSites), "dense table" if self.ALLOW_COMPUTED_GOTO_DISPATCH else "switch"))
+        if(self.ALLOW_LOOP_STRUCTURING):
+            print("Structured loops: {} natural loops output as do/while loops (or unrolled).".format(self.__structuredLoopCount))
+        if(self.__liveness != None):
+            summaries = self.__liveness.getSummaries()
+            understoodCount = len([summary for summary in summaries.values() if summary.understood])
+            print("Liveness: {} of {} subroutines summarized (the rest may not return to their caller), {} instructions with unused results removed, {} instructions skip computing unused flags.".format(understoodCount, len(summaries), len(self.__unusedInstructions), len(self.__unusedFlags)))
+        if(self.__profile != None):
+            executedCount = len([address for address in prgRom.codeSections if self.__profile.getBlockCount(address) > 0])
+            coldFunctionCount = len([address for address in self.__functions if self.__profile.getBlockCount(address) == 0])
+            print("Profile: {} of {} code sections executed (output hot to cold), {} branches hinted, {} cold code sections and {} cold subroutine functions.".format(executedCount, len(prgRom.codeSections), len(self.__biasedBranches), self.__coldSectionCount, coldFunctionCount))
+        # Output our data (each block is self-contained, so it can be output in any shard).
+        output = self.__BeginCUnit(outputs, units)
+        output.write("""
 // ---------------------------------
 // Data
 // ---------------------------------
 /*
  * Describes the layout of the nametables and which should be mirrored.
  */
-enum MIRRORINGTYPE mirroringType = """ 
+enum MIRRORINGTYPE mirroringType = """)
         # Add our PPU mirroring type.
-        source += "{};".format(rom.mirroring.name)
-        source += """
+        output.write("{};".format(rom.mirroring.name))
+        output.write("""
 /*
  * Translation Lookaside Buffer
  * Used for address lookups to map virtual PRG-ROM address spaces to system memory.
  */
 struct TLBEntry gameTLB[] =
 {
-"""
+""")
         # Define our sections our data will be present relative to PRG-ROM start (0x8000)
         prgRomLocations = [0] 
         
@@ -447,7 +2271,7 @@ struct TLBEntry gameTLB[] =
         # Determine if we're outputting all PRG-ROM data or just determined data sections.
         if(self.OUTPUT_FULL_PRGROM_DATA):
             for prgRomLocation in prgRomLocations:
-                source += "\t{{  {}, {}, {} }},\n".format(hex(NESMemory.PRG_ROM_START_ADDR + prgRomLocation), hex(NESMemory.PRG_ROM_START_ADDR + prgRomLocation + len(rom.prgRom)), "prgRomData")
+                output.write("\t{{  {}, {}, {} }},\n".format(hex(NESMemory.PRG_ROM_START_ADDR + prgRomLocation), hex(NESMemory.PRG_ROM_START_ADDR + prgRomLocation + len(rom.prgRom)), "(BYTE*)prgRomData"))
         else:
             # Loop for each data section and output it
             for prgRomLocation in prgRomLocations:
@@ -455,39 +2279,137 @@ struct TLBEntry gameTLB[] =
                 for address, dataSection in prgRom.dataSections.items():
                     startAddr = prgRomLocation + address
                     endAddr = startAddr + dataSection.getSize()
-                    resolvedLocation = "(prgRomData + {})".format(hex(prgRomDataOffset))
+                    resolvedLocation = "(BYTE*)(prgRomData + {})".format(hex(prgRomDataOffset))
                     prgRomDataOffset += dataSection.getSize()
-                    source += "\t{{ {}, {}, {} }},\n".format(hex(startAddr), hex(endAddr), resolvedLocation)
-        source += """
+                    output.write("\t{{ {}, {}, {} }},\n".format(hex(startAddr), hex(endAddr), resolvedLocation))
+        output.write("""
 };
 UINT gameTLBSize = sizeof(gameTLB) / sizeof(struct TLBEntry);
+""")
+        tlbSize = len(prgRomLocations) * (1 if self.OUTPUT_FULL_PRGROM_DATA else len(prgRom.dataSections))
+        output.write("BOOL gameUsesReturnStack = {}; // JSRs push their return address and RTSs dispatch to it (the interpreter does the same).\n".format("TRUE" if self.USE_RETURN_STACK else "FALSE"))
+        output = self.__BeginCUnit(outputs, units)
+        output.write("""
+/*
+ * Entry Map
+ * One bit per PRG-ROM address (from 0x8000), set if game_execute() has a label for it. The interpreter returns to compiled code at these.
+ */
+BYTE gameEntryMap[] = {""")
+        entryMap = [0] * ((0x10000 - NESMemory.PRG_ROM_START_ADDR) // 8)
+        for (address, caseValue, sectionAddress) in self.__executeEntries:
+            mirrors = [address, (address - NESMemory.PRG_ROM_FIRST_BANK_ADDR) + NESMemory.PRG_ROM_SECOND_BANK_ADDR] if NESMemory.isMirroredROM(rom) else [address]
+            for mirror in mirrors:
+                index = mirror - NESMemory.PRG_ROM_START_ADDR
+                entryMap[index // 8] |= 1 << (index % 8)
+        self.__WriteCByteArray(output, entryMap)
+        output.write("""
+};
 
-"""
+""")
+        # Output the loops we recognized, for the runtime to execute in bulk.
+        if(len(self.__idiomLoops) > 0):
+            output = self.__BeginCUnit(outputs, units)
+            output.write("""/*
+ * Recognized loop idioms
+ * Counted store/copy loops which can be executed in bulk, indexed by the idiom() calls at their starting location.
+ */
+struct IDIOMLOOP gameIdiomLoops[] =
+{
+""")
+            for address, loop in self.__idiomLoops.items():
+                output.write("\t{{ {}, {}, {}, {}, {}, {}, {}, {} }}, // {}: {}\n".format(
+                    "IDIOM_COPY" if loop.source is not None else "IDIOM_FILL",
+                    "IDIOM_INDEX_X" if loop.index == MOSRegisterType.X else "IDIOM_INDEX_Y",
+                    "TRUE" if loop.decrement else "FALSE",
+                    "TRUE" if loop.compareValue is not None else "FALSE",
+                    hex(loop.compareValue if loop.compareValue is not None else 0),
+                    self.__GetIdiomOperandInitializer(loop.source if loop.source is not None else ("IDIOM_OPERAND_NONE", 0)),
+                    self.__GetIdiomOperandInitializer(loop.destination),
+                    loop.iterationCycles, hex(address), loop.text))
+            output.write("};\n\n")
+
+        # Output the known routines we recognized, for the runtime to execute natively.
+        if(len(self.__knownRoutines) > 0):
+            output = self.__BeginCUnit(outputs, units)
+            output.write("""/*
+ * Known routines
+ * Subroutines recognized as routines the runtime implements natively, indexed by the hle() calls at their starting location.
+ */
+struct HLEROUTINE gameKnownRoutines[] =
+{
+""")
+            for address, knownRoutine in self.__knownRoutines.items():
+                output.write("\t{{ {}, {{ {} }} }}, // {}: {} ({})\n".format(knownRoutine.routine.routineType, ", ".join([hex(value) for name, value in knownRoutine.operands]), hex(address), knownRoutine.routine.name, knownRoutine.text))
+            output.write("};\n\n")
+
+        # Output the subroutines we memoize, for the runtime to cache their results in (and report on).
+        if(len(self.__memoSubroutines) > 0):
+            output = self.__BeginCUnit(outputs, units)
+            output.write("""/*
+ * Memoized subroutines
+ * Subroutines whose results are cached by the registers, flags and RAM they read, indexed by the memoize() calls at their start.
+ */
+struct MEMOSUBROUTINE gameMemoSubroutines[] =
+{
+""")
+            for address, subroutine in self.__memoSubroutines.items():
+                output.write("\t{{ {}, {}, {}, {}, {{ {} }}, {}, {}, {}, {{ {} }} }}, // {}\n".format(hex(address),
+                    hex(self.__GetMemoRegisterMask(subroutine.inputMask)), hex(self.__GetMemoFlagMask(subroutine.inputMask)), len(subroutine.inputs), ", ".join([hex(input) for input in subroutine.inputs]),
+                    hex(self.__GetMemoRegisterMask(subroutine.outputMask)), hex(self.__GetMemoFlagMask(subroutine.outputMask)), len(subroutine.outputs), ", ".join([hex(address) for address in subroutine.outputs]),
+                    subroutine.getText()))
+            output.write("};\n")
+            if(self.GAME_SYMBOL_PREFIX == None):
+                output.write("struct MEMOSUBROUTINE* memoSubroutines = gameMemoSubroutines;\n")
+                output.write("UINT memoSubroutineCount = sizeof(gameMemoSubroutines) / sizeof(struct MEMOSUBROUTINE);\n")
+            output.write("\n")
 
         # PRG-ROM (Data):
         # We're aiming to output all data sections as a singular data array since data sections are not analyzed further
         # and are likely even further segmented than our current scheme (segmented by code sections). 
         # Since no further analysis is done, we store them in one location to keep it clean and map to them.
-        source += "BYTE prgRomData[] = {"
-        
-        # Determine if we're outputting all PRG-ROM data or just determined data sections.
-        if(self.OUTPUT_FULL_PRGROM_DATA):
-            source += self.__GenerateCByteArray(rom.prgRom)
-        else:
+        prgRomData = rom.prgRom
+        if(not self.OUTPUT_FULL_PRGROM_DATA):
             prgRomData = []
             for address, dataSection in prgRom.dataSections.items():
                 prgRomData.extend(dataSection.data)
-            source += self.__GenerateCByteArray(prgRomData)
-            
-        source += "\n};\n\n"
-        source += """UINT prgRomDataSize = sizeof(prgRomData);
-"""
+        output = self.__BeginCUnit(outputs, units)
+        self.__WriteCDataArray(output, "prgRomData", prgRomData)
+        output.write("UINT prgRomDataSize = {};\n".format(hex(len(prgRomData))))
+        
+        # PRG-ROM (Code): The interpreter decodes any code the compiled code doesn't have a label for from here.
+        if(self.OUTPUT_FULL_PRGROM_DATA):
+            output.write("const BYTE* prgRomCode = prgRomData;\n")
+        else:
+            output = self.__BeginCUnit(outputs, units)
+            self.__WriteCDataArray(output, "prgRomCodeData", rom.prgRom)
+            output.write("const BYTE* prgRomCode = prgRomCodeData;\n")
+        output.write("UINT prgRomCodeSize = {};\n".format(hex(len(rom.prgRom))))
         
         # CHR-ROM:
-        source += "BYTE chrRom[] = {"
-        source += self.__GenerateCByteArray(rom.chrRom)
-        source += "\n};\n"
-        source += """UINT chrRomSize = sizeof(chrRom);
-
-#endif"""
-        return source
\ No newline at end of file
+        output = self.__BeginCUnit(outputs, units)
+        self.__WriteCDataArray(output, "chrRom", rom.chrRom)
+        output.write("UINT chrRomSize = {};\n".format(hex(len(rom.chrRom))))
+        
+        # Registration (for NESsys builds containing multiple games, which select this one by name).
+        if(self.GAME_SYMBOL_PREFIX != None):
+            output = self.__BeginCUnit(outputs, units)
+            output.write("""
+/*
+ * Game Descriptor
+ * Describes this game to NESsys builds containing multiple games (APPLICATION_MULTIPLE_GAMES), which select it by name.
+ */
+struct GAMEDESCRIPTOR {}_game =
+{{
+	"{}", game_execute, ID_FUNCTION_RESET, ID_FUNCTION_NMI, ID_FUNCTION_IRQ, {},
+	gameTLB, {}, gameEntryMap, {},
+	{}, GAME_PROFILING,
+	{}, {}, chrRom, {}
+}};
+""".format(self.GAME_SYMBOL_PREFIX, self.GAME_SYMBOL_PREFIX, rom.mirroring.name, tlbSize, "TRUE" if self.USE_RETURN_STACK else "FALSE",
+                "gameMemoSubroutines, {}".format(len(self.__memoSubroutines)) if len(self.__memoSubroutines) > 0 else "NULL, 0",
+                "prgRomData" if self.OUTPUT_FULL_PRGROM_DATA else "prgRomCodeData", hex(len(rom.prgRom)), hex(len(rom.chrRom))))
+        if(len(outputs) > 1):
+            self.__WriteCShards(outputs, units, executeSize)
+        else:
+            output.write("""
+#endif""")
\ No newline at end of file
@@ -16,7 +16,11 @@
 #include "input.h"
 #include "memory.h"
 #include "ppu.h"
+#include "interpreter.h"
+#include "profile.h"
+#include "memo.h"
 #include "tests.h"
+#include "benchmark.h"
 
 enum CTXMENU_CPUOPTIONS { CTXMENU_RESUME, CTXMENU_PAUSE, CTXMENU_RESTART };
 enum CTXMENU_SPEEDOPTIONS { CTXMENU_SPEED1, CTXMENU_SPEED2, CTXMENU_SPEED5, CTXMENU_SPEED100 };
@@ -71,6 +75,14 @@ void game_display(void)
 	snprintf(overlayStr, sizeof(overlayStr), "FPS: %i", framesPerSecond);
 	WriteStringAbs(0, 24, overlayStr, GLUT_BITMAP_HELVETICA_12);
 
+	// Show how much of the game runs in the interpreter (code the compiler didn't discover), if any does.
+	if(interpreterCycles > 0)
+	{
+		glColor3ub(255, 255, 0);
+		snprintf(overlayStr, sizeof(overlayStr), "Interpreted: %.1f%%", ((double)interpreterCycles / cpuCyclesTotal) * 100);
+		WriteStringAbs(0, 36, overlayStr, GLUT_BITMAP_HELVETICA_12);
+	}
+
 	glFlush(); // Force changes
 }
 /*
@@ -88,6 +100,7 @@ void game_start(void)
 		// Initialize hardware.
 		cpu_init();
 		ppu_init();
+		interpreter_init();
 		framesPerSecond = 60;
 
 		// Enter the game's main entry point (reset interrupt handler).
@@ -119,6 +132,13 @@ void window_resize(int w, int h)
  */
 void window_closing(void)
 {
+	// Write our execution profile, if the game records one.
+	if(GAME_PROFILING && !profile_write(APPLICATION_PROFILE_PATH))
+		console_log("Failed to write execution profile to %s.\n", APPLICATION_PROFILE_PATH);
+
+	// Report how well memoized subroutines were cached, if the game has any.
+	memo_report();
+
 	// Exit the application, killing all threads.
 	exit(EXIT_SUCCESS);
 }
@@ -202,6 +222,17 @@ int main(int argc, char **argv)
 	console_log("You may encounter unexpected behavior.\n");
 	console_log("---------------------------\n");
 
+#if APPLICATION_MULTIPLE_GAMES
+	// Select the game to run by the name given (the first game linked in, if none is).
+	if(!games_select(argc > 1 ? argv[1] : NULL))
+	{
+		console_log("Unknown game: %s\n", argc > 1 ? argv[1] : "(none linked in)");
+		games_print();
+		exit(EXIT_FAILURE);
+	}
+	console_log("Running %s.\n", selectedGame->name);
+#endif
+
 	// If we're in testing mode, run the appropriate tests.
 	if(APPLICATION_TESTING_MODE)
 	{
@@ -209,6 +240,13 @@ int main(int argc, char **argv)
 		exit(EXIT_SUCCESS);
 	}
 
+	// If we're in benchmark mode, run the benchmarks.
+	if(APPLICATION_BENCHMARK_MODE)
+	{
+		benchmark_all();
+		exit(EXIT_SUCCESS);
+	}
+
 	// Set up the GUI for the game.
 	glutInit(&argc, argv);
 	glutCreateWindow(APPLICATION_WINDOW_TEXT);
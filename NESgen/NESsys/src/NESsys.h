@@ -12,11 +12,16 @@
 #define APPLICATION_DEBUGLOG		TRUE
 #define APPLICATION_USE_TEMPLATE	FALSE
 #define APPLICATION_TESTING_MODE	FALSE
+#define APPLICATION_BENCHMARK_MODE	FALSE
+#ifndef APPLICATION_MULTIPLE_GAMES
+#define APPLICATION_MULTIPLE_GAMES	FALSE // links in every game generated with -G (see games.h), selected by name on the command line.
+#endif
 
 // ---------------------------------
 // Settings
 // ---------------------------------
 #define APPLICATION_DEFAULT_GAME_SPEED				1.0f
+#define APPLICATION_PROFILE_PATH					"NESsys.profile" // written on exit by games generated with -g (see NESgen.py -P)
 
 // ---------------------------------
 // Declarations
@@ -0,0 +1,283 @@
+#include "NESsys.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "cpu.h"
+#include "memory.h"
+#include "ppu.h"
+#include "benchmark.h"
+#include "game_base.h"
+
+/*
+ * Fills the PPU with deterministic pseudo-random nametables, palettes and sprites so every renderer draws a busy scene.
+ */
+void benchmark_ppu_setup_scene()
+{
+	UINT seed = 0x1234567;
+	BYTE* nameTableData = (BYTE*)physicalNameTables;
+	for(UINT i = 0; i < sizeof(physicalNameTables); i++)
+	{
+		seed = (seed * 1103515245) + 12345;
+		nameTableData[i] = (BYTE)(seed >> 16);
+	}
+	BYTE* oamData = (BYTE*)objectAttributeMemory;
+	for(UINT i = 0; i < sizeof(objectAttributeMemory); i++)
+	{
+		seed = (seed * 1103515245) + 12345;
+		oamData[i] = (BYTE)(seed >> 16);
+	}
+	for(UINT i = 0; i < 4; i++)
+	{
+		for(UINT j = 0; j < 3; j++)
+		{
+			backgroundColorPalette[i].paletteColorIndex[j] = (BYTE)((i * 3) + j + 1);
+			spriteColorPalette[i].paletteColorIndex[j] = (BYTE)((i * 3) + j + 0x11);
+		}
+	}
+	ppu_invalidate_tile_cache();
+}
+/*
+ * Measures the time (in milliseconds) to draw all visible scanlines of BENCHMARK_FRAME_COUNT frames with the given renderers.
+ */
+ULONGLONG benchmark_ppu_draw_frames(SpriteScanlineRenderer drawSprites, BackgroundScanlineRenderer drawBackground)
+{
+	TIMEDATA start, end;
+	get_time(&start);
+	for(UINT frame = 0; frame < BENCHMARK_FRAME_COUNT; frame++)
+	{
+		for(currentScanline = 0; currentScanline < RESOLUTION_HEIGHT; currentScanline++)
+		{
+			if(drawBackground)
+				drawBackground();
+			if(drawSprites)
+			{
+				drawSprites(1);
+				drawSprites(0);
+			}
+		}
+	}
+	get_time(&end);
+	currentScanline = 0;
+	return get_time_difference(&start, &end);
+}
+/*
+ * Measures the generic and specialized renderers in alternating runs, keeping the best time of each
+ * (so clock scaling and cache warmup affect both equally).
+ */
+void benchmark_ppu_compare(SpriteScanlineRenderer genericSprites, BackgroundScanlineRenderer genericBackground,
+		SpriteScanlineRenderer specializedSprites, BackgroundScanlineRenderer specializedBackground,
+		ULONGLONG* genericTime, ULONGLONG* specializedTime)
+{
+	*genericTime = *specializedTime = (ULONGLONG)-1;
+	for(UINT i = 0; i < BENCHMARK_REPEAT_COUNT; i++)
+	{
+		ULONGLONG time = benchmark_ppu_draw_frames(genericSprites, genericBackground);
+		*genericTime = min(*genericTime, time);
+		time = benchmark_ppu_draw_frames(specializedSprites, specializedBackground);
+		*specializedTime = min(*specializedTime, time);
+	}
+}
+/*
+ * Compares every specialized scanline renderer variant against the generic renderer in the same PPU state.
+ */
+void benchmark_ppu_renderers()
+{
+	benchmark_ppu_setup_scene();
+	console_log("Scanline renderers (best of %i runs, %i frames each):\n", BENCHMARK_REPEAT_COUNT, BENCHMARK_FRAME_COUNT);
+
+	for(UINT doubleSpriteHeight = 0; doubleSpriteHeight < 2; doubleSpriteHeight++)
+	{
+		for(UINT clipLeft = 0; clipLeft < 2; clipLeft++)
+		{
+			for(UINT greyscale = 0; greyscale < 2; greyscale++)
+			{
+				ppuCtrl.doubleSpriteHeight = doubleSpriteHeight;
+				ppuMask.showSpritesLeft = !clipLeft;
+				ppuMask.greyscale = greyscale;
+				ULONGLONG genericTime, specializedTime;
+				benchmark_ppu_compare(ppu_draw_sprites_generic, NULL, spriteScanlineRenderers[doubleSpriteHeight][clipLeft][greyscale], NULL,
+						&genericTime, &specializedTime);
+				console_log("  sprites    (8x%i, clip %i, grey %i): generic %llums, specialized %llums\n",
+						doubleSpriteHeight ? 16 : 8, clipLeft, greyscale, genericTime, specializedTime);
+			}
+		}
+	}
+	tileCacheHits = tileCacheMisses = tileCacheEvictions = 0;
+	for(UINT aligned = 0; aligned < 2; aligned++)
+	{
+		for(UINT greyscale = 0; greyscale < 2; greyscale++)
+		{
+			scanlineOriginAddr = 2;
+			ppuRegisters.x = aligned ? 0 : 5;
+			ppuMask.greyscale = greyscale;
+			ULONGLONG genericTime, specializedTime;
+			benchmark_ppu_compare(NULL, ppu_draw_background_generic, NULL, backgroundScanlineRenderers[aligned][greyscale],
+					&genericTime, &specializedTime);
+			console_log("  background (aligned %i, grey %i):    generic %llums, specialized %llums\n",
+					aligned, greyscale, genericTime, specializedTime);
+		}
+	}
+
+	console_log("  tile cache: %llu hits, %llu misses, %llu evictions\n", tileCacheHits, tileCacheMisses, tileCacheEvictions);
+
+	// Restore our PPU state.
+	ppu_init();
+}
+/*
+ * Compares OAM DMA and PPUDATA uploads through individual register accesses against the block transfers.
+ */
+void benchmark_ppu_transfers()
+{
+	TIMEDATA start, end;
+	BYTE data[0x400];
+	memset(data, 0x24, sizeof(data));
+	console_log("PPU transfers (%i frames each):\n", BENCHMARK_FRAME_COUNT * 10);
+
+	// OAM DMA, byte by byte through CPU memory reads as before, versus a block copy.
+	get_time(&start);
+	for(UINT frame = 0; frame < BENCHMARK_FRAME_COUNT * 10; frame++)
+	{
+		BYTE* dataArray = (BYTE*)objectAttributeMemory;
+		for(USHORT i = 0; i < MEMORY_PAGE_SIZE; i++)
+			dataArray[i] = cpu_read8(0x200 + i);
+	}
+	get_time(&end);
+	ULONGLONG byteTime = get_time_difference(&start, &end);
+	get_time(&start);
+	for(UINT frame = 0; frame < BENCHMARK_FRAME_COUNT * 10; frame++)
+		ppu_oam_dma(0x02);
+	get_time(&end);
+	console_log("  OAM DMA:               bytes %llums, block %llums\n", byteTime, get_time_difference(&start, &end));
+
+	// A full nametable upload through PPUDATA.
+	get_time(&start);
+	for(UINT frame = 0; frame < BENCHMARK_FRAME_COUNT * 10; frame++)
+	{
+		ppuRegisters.v = 0x2000;
+		for(UINT i = 0; i < sizeof(data); i++)
+			cpu_write8(PPUDATA_REGISTER, data[i]);
+	}
+	get_time(&end);
+	byteTime = get_time_difference(&start, &end);
+	get_time(&start);
+	for(UINT frame = 0; frame < BENCHMARK_FRAME_COUNT * 10; frame++)
+	{
+		ppuRegisters.v = 0x2000;
+		ppu_write_data_block(data, sizeof(data));
+	}
+	get_time(&end);
+	console_log("  PPUDATA (1KB):         bytes %llums, block %llums\n", byteTime, get_time_difference(&start, &end));
+
+	// Restore our CPU/PPU state.
+	cpu_init();
+	ppu_init();
+}
+/*
+ * Requests an IRQ, stopping the interrupt handler which is syncing.
+ */
+void benchmark_cpu_stop_interrupt()
+{
+	onCpuSync = NULL;
+	interrupts.requestedIRQ = TRUE;
+}
+/*
+ * Syncs and calls itself like compiled subroutines do, until the given depth where it stops the interrupt handler.
+ * Returns TRUE if the interrupt handler should stop (through every subroutine, unless it was switched away from).
+ */
+__attribute__((noinline)) BOOL benchmark_cpu_subroutine(UINT depth)
+{
+	if(depth == 0)
+		interrupts.requestedIRQ = TRUE;
+	if(cpu_sync(6))
+		return TRUE;
+	if(benchmark_cpu_subroutine(depth - 1))
+		return TRUE;
+	return cpu_sync(6);
+}
+/*
+ * Calls BENCHMARK_INTERRUPT_DEPTH subroutines from the interrupt handler which is syncing, stopping it in the deepest.
+ */
+void benchmark_cpu_stop_interrupt_deep()
+{
+	onCpuSync = NULL;
+	benchmark_cpu_subroutine(BENCHMARK_INTERRUPT_DEPTH);
+}
+/*
+ * Measures the time (in milliseconds) to execute the interrupt handler at the given function ID BENCHMARK_INTERRUPT_COUNT times,
+ * with the given event at its first sync (which may stop it).
+ */
+ULONGLONG benchmark_cpu_execute_interrupts(USHORT functionID, GenericEvent event)
+{
+	TIMEDATA start, end;
+	get_time(&start);
+	for(UINT i = 0; i < BENCHMARK_INTERRUPT_COUNT; i++)
+	{
+		onCpuSync = event;
+		interrupts.current = INTERRUPT_NMI;
+		cpu_execute_interrupt(functionID);
+		interrupts.current = INTERRUPT_RESET;
+		interrupts.requestedIRQ = FALSE;
+		registers.SP = 0xFF; // (the handler's pushes, left by stopping it, are discarded)
+	}
+	get_time(&end);
+	onCpuSync = NULL;
+	return get_time_difference(&start, &end);
+}
+/*
+ * Compares the latency of interrupt handlers called from the code they interrupt, against those executing in their own context:
+ * entering a handler which returns, and entering a handler which is stopped (by another interrupt request) at its first sync,
+ * or in a subroutine deep below it (where a nested call must return through every subroutine, but a context only switches back).
+ */
+void benchmark_cpu_interrupts()
+{
+	TIMEDATA start, end;
+	cpuSpeedMultiplier = 1000; // (don't throttle)
+	console_log("CPU interrupts (best of %i runs, %i interrupts each, latency per interrupt):\n", BENCHMARK_REPEAT_COUNT, BENCHMARK_INTERRUPT_COUNT);
+
+	// The syncs the handlers execute are measured on their own, so the cost of entering and leaving them can be told apart.
+	ULONGLONG syncTime = (ULONGLONG)-1;
+	for(UINT i = 0; i < BENCHMARK_REPEAT_COUNT; i++)
+	{
+		get_time(&start);
+		for(UINT j = 0; j < BENCHMARK_INTERRUPT_COUNT; j++)
+			cpu_sync(6);
+		get_time(&end);
+		syncTime = min(syncTime, get_time_difference(&start, &end));
+	}
+	console_log("  sync(6) alone:                 %lluns\n", syncTime * 1000000 / BENCHMARK_INTERRUPT_COUNT);
+
+	const CHAR* names[] = { "IRQ (returns):                ", "NMI (stopped at first sync):  ", "NMI (stopped %i calls deep):  " };
+	USHORT functionIDs[] = { ID_FUNCTION_IRQ, ID_FUNCTION_NMI, ID_FUNCTION_NMI };
+	GenericEvent events[] = { NULL, benchmark_cpu_stop_interrupt, benchmark_cpu_stop_interrupt_deep };
+	for(UINT x = 0; x < 3; x++)
+	{
+		ULONGLONG nestedTime = (ULONGLONG)-1, coroutineTime = (ULONGLONG)-1;
+		for(UINT i = 0; i < BENCHMARK_REPEAT_COUNT; i++)
+		{
+			cpuInterruptCoroutines = FALSE;
+			ULONGLONG time = benchmark_cpu_execute_interrupts(functionIDs[x], events[x]);
+			nestedTime = min(nestedTime, time);
+			cpuInterruptCoroutines = PLATFORM_SUPPORTS_CONTEXTS;
+			time = benchmark_cpu_execute_interrupts(functionIDs[x], events[x]);
+			coroutineTime = min(coroutineTime, time);
+		}
+		console_log("  ");
+		console_log(names[x], BENCHMARK_INTERRUPT_DEPTH);
+		console_log(" nested %lluns, %s %lluns\n", nestedTime * 1000000 / BENCHMARK_INTERRUPT_COUNT,
+				PLATFORM_SUPPORTS_CONTEXTS ? "coroutine" : "coroutine (unsupported)", coroutineTime * 1000000 / BENCHMARK_INTERRUPT_COUNT);
+	}
+
+	// Restore our CPU/PPU state.
+	cpu_init();
+	ppu_init();
+}
+void benchmark_all()
+{
+	// Initialize any needed hardware.
+	cpu_init();
+	ppu_init();
+
+	benchmark_ppu_renderers();
+	benchmark_ppu_transfers();
+	benchmark_cpu_interrupts();
+	console_log("Finished all benchmarks...\n");
+}
@@ -0,0 +1,14 @@
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+#include "platform.h"
+
+
+#define BENCHMARK_FRAME_COUNT		500
+#define BENCHMARK_REPEAT_COUNT		7
+#define BENCHMARK_INTERRUPT_COUNT	200000
+#define BENCHMARK_INTERRUPT_DEPTH	16
+
+void benchmark_all();
+
+#endif /* BENCHMARK_H_ */
@@ -15,6 +15,9 @@ void cpu_init()
 	cpuCyclesCurrentSecond = 0;
 	get_time(&lastSyncTime);
 	cpuCyclesLastSecond = 0;
+	cpuCyclesTotal = 0;
+	cpuStallCycles = 0;
+	cpuInterruptCount = 0;
 	cpuPaused = FALSE;
 	cpuRestarting = FALSE;
 	memset(&registers, 0, sizeof(registers));
@@ -24,21 +27,11 @@ void cpu_init()
 	memset(&sram, 0, sizeof(sram));
 	memset(&interrupts, 0, sizeof(interrupts));
 	interrupts.current = INTERRUPT_RESET;
+	cpuInterruptCoroutines = CPU_USE_COROUTINES;
+	cpuInterruptStopped = FALSE;
 	registers.SP = 0xFF; // top of stack, moves to bottom.
 	cpu_set_flags(0); // makes sure our unused flag is always set.
 
-	// If our PRG-ROM data was never backed up, do so now, as it can be changed at runtime.
-	// If it was, then we restore our backup now.
-	if(prgRomDataBackup == NULL)
-	{
-		prgRomDataBackup = malloc(prgRomDataSize);
-		memcpy(prgRomDataBackup, prgRomData, prgRomDataSize);
-	}
-	else
-	{
-		memcpy(prgRomData, prgRomDataBackup, prgRomDataSize);
-	}
-
 	// If our unmapped memory was never initialized, initialize it.
 	if(unmappedCPUMemory == NULL)
 		unmappedCPUMemory = malloc(0x10000);
@@ -90,15 +83,66 @@ BYTE cpu_stack_pop()
  * Returns TRUE if we should stop executing the current interrupt handler.
  */
 BOOL cpu_sync(UINT cycles)
+{
+	if(!cpu_sync_hardware(cycles))
+		return FALSE;
+	return cpu_sync_interrupts();
+}
+/*
+ * Performs everything cpu_sync does, other than handling interrupts (handle clock cycles, PPU rendering calls, throttling).
+ * Returns TRUE if an interrupt was requested or we're restarting, in which case cpu_sync_interrupts() must be called next.
+ * (Code which keeps registers outside of the registers structure only needs to store them back then)
+ */
+BOOL cpu_sync_hardware(UINT cycles)
 {
 	// Call our sync event handler
 	if(onCpuSync != NULL)
 		onCpuSync();
 
+	// Add any cycles the CPU was stalled for during this instruction.
+	cycles += cpuStallCycles;
+	cpuStallCycles = 0;
+	cpuCyclesTotal += cycles;
+
 	// For each CPU cycle, we the PPU will execute 3.
 	for(UINT i = 0; i < cycles * 3; i++)
 		ppu_update();
 
+	// Add to our cpu cycle count we're tracking for this second
+	cpuCyclesCurrentSecond += cycles;
+
+	// Throttling: Loop until we're allowed to execute more cycles.
+	TIMEDATA currentTime;
+	ULONGLONG timeDifference;
+	ULONGLONG desiredCycleCount;
+	do
+	{
+		// Get the time difference from the time stamp when we hit the start of this second.
+		get_time(&currentTime);
+		timeDifference = get_time_difference(&currentTime, &lastSyncTime);
+
+		// Calculate how many instructions we should have executed by this point.
+		double secondFraction = timeDifference / (double)1000;
+		desiredCycleCount = (UINT)(secondFraction * cpuSpeedMultiplier * CPU_CYCLES_PER_SECOND);
+	}while(cpuPaused || cpuCyclesCurrentSecond > desiredCycleCount);
+
+	// If we've moved a second past our last time stamp, reset our time variables.
+	if(timeDifference >= 1000)
+	{
+		cpuCyclesLastSecond = cpuCyclesCurrentSecond;
+		cpuCyclesCurrentSecond = 0;
+		framesPerSecond = frameCount;
+		frameCount = 0;
+		lastSyncTime = currentTime;
+	}
+	return interrupts.requestedNMI || interrupts.requestedIRQ || cpuRestarting;
+}
+/*
+ * Handles a requested NMI/IRQ, following cpu_sync_hardware().
+ * Returns TRUE if we should stop executing the current interrupt handler.
+ */
+BOOL cpu_sync_interrupts()
+{
 	// Handle NMI/IRQ if there is a request and we're not in one currently (NMI overrides IRQ)
 	if(interrupts.current == INTERRUPT_RESET)
 	{
@@ -112,9 +156,14 @@ BOOL cpu_sync(UINT cycles)
 
 			// Handle our NMI interrupt
 			interrupts.current = INTERRUPT_NMI;
+			cpuInterruptCount++;
 			cpu_stack_push(registers.P);
 			cpu_set_flag(CPU_FLAG_INTERRUPT_DISABLE, TRUE);
-			game_execute(ID_FUNCTION_NMI);
+			BYTE stackPointer = registers.SP;
+			cpu_execute_interrupt(ID_FUNCTION_NMI);
+			// A handler which stopped early may not have returned from its subroutines, leaving their return addresses.
+			if(gameUsesReturnStack)
+				registers.SP = stackPointer;
 			cpu_set_flags(cpu_stack_pop());
 			interrupts.current = INTERRUPT_RESET;
 
@@ -130,10 +179,14 @@ BOOL cpu_sync(UINT cycles)
 
 			// Handle our IRQ request
 			interrupts.current = INTERRUPT_IRQ;
+			cpuInterruptCount++;
 			cpu_stack_push(registers.P);
 			cpu_set_flag(CPU_FLAG_BREAK, TRUE);
 			cpu_set_flag(CPU_FLAG_INTERRUPT_DISABLE, TRUE);
-			game_execute(ID_FUNCTION_IRQ);
+			BYTE stackPointer = registers.SP;
+			cpu_execute_interrupt(ID_FUNCTION_IRQ);
+			if(gameUsesReturnStack)
+				registers.SP = stackPointer;
 			cpu_set_flags(cpu_stack_pop());
 			interrupts.current = INTERRUPT_RESET;
 
@@ -142,36 +195,62 @@ BOOL cpu_sync(UINT cycles)
 	}
 	else if(interrupts.requestedIRQ || interrupts.requestedNMI)
 	{
-		// But if we are in an interrupt and we requested one, tell our calling function we want to end execution.
+		// But if we are in an interrupt and we requested one, stop executing it.
+		// In its own context, we switch straight back to the code it interrupted. Otherwise we tell our calling function we want to end execution.
+		if(cpuInterruptCoroutines)
+		{
+			cpuInterruptStopped = TRUE;
+			switch_context(cpuInterruptContext, cpuInterruptedContext);
+		}
 		return TRUE;
 	}
-
-	// Add to our cpu cycle count we're tracking for this second
-	cpuCyclesCurrentSecond += cycles;
-
-	// Throttling: Loop until we're allowed to execute more cycles.
-	TIMEDATA currentTime;
-	ULONGLONG timeDifference;
-	ULONGLONG desiredCycleCount;
-	do
+	return cpuRestarting;
+}
+/*
+ * Executes the interrupt handler with the given function ID, until it returns or is stopped.
+ * In its own context, entering and stopping it costs a context switch, rather than a nested call which unwinds through every function it called.
+ */
+void cpu_execute_interrupt(USHORT functionID)
+{
+	if(!cpuInterruptCoroutines)
 	{
-		// Get the time difference from the time stamp when we hit the start of this second.
-		get_time(&currentTime);
-		timeDifference = get_time_difference(&currentTime, &lastSyncTime);
-
-		// Calculate how many instructions we should have executed by this point.
-		double secondFraction = timeDifference / (double)1000;
-		desiredCycleCount = (UINT)(secondFraction * cpuSpeedMultiplier * CPU_CYCLES_PER_SECOND);
-	}while(cpuPaused || cpuCyclesCurrentSecond > desiredCycleCount);
+		game_execute(functionID);
+		return;
+	}
+	// If our interrupt handler context was never created, create it (and one for the code it interrupts) now.
+	if(cpuInterruptContext == NULL)
+	{
+		cpuInterruptedContext = create_thread_context();
+		cpuInterruptContext = create_context(cpu_interrupt_context_main, CPU_INTERRUPT_STACK_SIZE);
+	}
+	cpuInterruptFunctionID = functionID;
+	switch_context(cpuInterruptedContext, cpuInterruptContext);
 
-	// If we've moved a second past our last time stamp, reset our time variables.
-	if(timeDifference >= 1000)
+	// A handler which was stopped never continues, so its context starts over (discarding the functions it was in).
+	if(cpuInterruptStopped)
 	{
-		cpuCyclesLastSecond = cpuCyclesCurrentSecond;
-		cpuCyclesCurrentSecond = 0;
-		framesPerSecond = frameCount;
-		frameCount = 0;
-		lastSyncTime = currentTime;
+		cpuInterruptStopped = FALSE;
+		cpuInterruptContext = reset_context(cpuInterruptContext, cpu_interrupt_context_main, CPU_INTERRUPT_STACK_SIZE);
 	}
-	return cpuRestarting;
+}
+/*
+ * Executes interrupt handlers in their own context, switching back to the code they interrupted after each returns.
+ */
+void cpu_interrupt_context_main()
+{
+	while(TRUE)
+	{
+		game_execute(cpuInterruptFunctionID);
+		switch_context(cpuInterruptContext, cpuInterruptedContext);
+	}
+}
+/*
+ * Determines if the given amount of cycles can pass without an interrupt being requested (or one is already pending).
+ * If so, code can execute instructions taking them and sync once after all of them, since no interrupt would have been handled between them.
+ */
+BOOL cpu_is_uninterrupted(UINT cycles)
+{
+	if(interrupts.requestedNMI || interrupts.requestedIRQ || cpuRestarting)
+		return FALSE;
+	return !ppuCtrl.executeNMIonVBLANK || ppu_cycles_until_vblank() > (cycles + cpuStallCycles) * 3;
 }
@@ -8,6 +8,7 @@
 // CPU Definitions
 // ---------------------------------
 #define CPU_CYCLES_PER_SECOND			1789772
+#define CPU_OAM_DMA_STALL_CYCLES		513
 #define CPU_FLAG_CARRY					0
 #define CPU_FLAG_ZERO					1
 #define CPU_FLAG_INTERRUPT_DISABLE		2
@@ -16,6 +17,10 @@
 #define CPU_FLAG_UNUSED					5
 #define CPU_FLAG_OVERFLOW				6
 #define CPU_FLAG_SIGN					7
+#define CPU_INTERRUPT_STACK_SIZE		0x400000 // stack size of the context interrupt handlers execute in.
+#ifndef CPU_USE_COROUTINES
+#define CPU_USE_COROUTINES				FALSE // interrupt handlers execute in their own context, rather than nested in the code they interrupt (needs PLATFORM_SUPPORTS_CONTEXTS).
+#endif
 
 struct CPURegisters
 {
@@ -44,6 +49,14 @@ DOUBLE cpuSpeedMultiplier;
 UINT cpuCyclesCurrentSecond;
 UINT cpuCyclesLastSecond;
 TIMEDATA lastSyncTime;
+ULONGLONG cpuCyclesTotal; // total cycles executed since initialization.
+UINT cpuStallCycles; // cycles the CPU is stalled for (by DMA), added on the next sync.
+BOOL cpuInterruptCoroutines; // interrupt handlers are switched to (and away from) in their own context, rather than called.
+CONTEXTHANDLE cpuInterruptedContext; // the context of the code interrupted (the reset path).
+CONTEXTHANDLE cpuInterruptContext; // the context interrupt handlers execute in.
+USHORT cpuInterruptFunctionID; // the function ID of the interrupt handler to execute when switching to its context.
+BOOL cpuInterruptStopped; // the interrupt handler was stopped before it returned, so its context must be discarded.
+UINT cpuInterruptCount; // NMIs/IRQs handled since initialization.
 
 // ---------------------------------
 // CPU Memory Regions
@@ -52,7 +65,6 @@ BYTE zeroPage[MEMORY_PAGE_SIZE]; // 0x000-0x100
 BYTE stack[MEMORY_PAGE_SIZE]; // 0x100-0x200
 BYTE ram[MEMORY_PAGE_SIZE*6]; // 0x200-0x800
 BYTE sram[MEMORY_PAGE_SIZE*0x20]; // 0x6000-0x8000
-BYTE* prgRomDataBackup; // backs up the PRG-ROM data since it can be changed at runtime.
 
 // ---------------------------------
 // Events
@@ -70,5 +82,10 @@ void cpu_set_flags(BYTE newFlags);
 void cpu_stack_push(BYTE data);
 BYTE cpu_stack_pop();
 BOOL cpu_sync(UINT cycles);
+BOOL cpu_sync_hardware(UINT cycles);
+BOOL cpu_sync_interrupts();
+void cpu_execute_interrupt(USHORT functionID);
+void cpu_interrupt_context_main();
+BOOL cpu_is_uninterrupted(UINT cycles);
 
 #endif /* CPU_H_ */
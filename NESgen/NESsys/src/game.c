@@ -6,1261 +6,692 @@
 // ---------------------------------
 // Functions
 // ---------------------------------
+static BOOL game_function_a441(USHORT jumpAddress);
 BOOL game_execute(USHORT jumpAddress)
 { 
+    BYTE A = registers.A, X = registers.X, Y = registers.Y, SP = registers.SP;
+    BYTE pushed_a45d; // Values pushed and pulled again within a code section.
     // Go to our jump table first to find out where to execute.
     // We do this to display game code first and hide the bloated jump table for later.
     goto Jump;
     
     // Game code follows...
+	BOOL loopTaken_a002;
+	BOOL loopTaken_a041;
+	BOOL loopTaken_a06d;
+	BOOL loopTaken_a077;
+	BOOL loopTaken_a14c;
 FUNCTION_RESET:
 	ClearDecimalFlag(); // Clear Decimal Mode
 	sync(2);
-____runtimeloc_a001:
 	SetInterruptDisableFlag(); // Set Interrupt Disable Status
 	sync(2);
 LOCATION_a002:
-	SetA(cpu_read8(PPUSTATUS_REGISTER)); // Load Accumulator with Memory
+	do // Loop (7 cycles per iteration)
+	{
+	A = MOSInstr_Load(cpu_read8(PPUSTATUS_REGISTER)); // Load Accumulator with Memory
 	sync(4);
-____runtimeloc_a005:
-	if(!cpu_get_flag(CPU_FLAG_SIGN)) { sync(3); goto LOCATION_a002; } // Branch on Result Plus
+	loopTaken_a002 = !cpu_get_flag(CPU_FLAG_SIGN); // Branch on Result Plus (loop)
+	sync(loopTaken_a002 ? 3 : 2);
+	} while(loopTaken_a002);
+	X = 0x0; GAME_SET_FLAGS(0x82, 0x2); // Load Index X with Memory
 	sync(2);
-____runtimeloc_a007:
-	SetX(0x0); // Load Index X with Memory
-	sync(2);
-____runtimeloc_a009:
-	StoreX(PPUCTRL_REGISTER); // Store Index X in Memory
+	cpu_write8(PPUCTRL_REGISTER, 0x0); // Store Index X in Memory
 	sync(4);
-____runtimeloc_a00c:
-	StoreX(PPUMASK_REGISTER); // Store Index X in Memory
+	cpu_write8(PPUMASK_REGISTER, 0x0); // Store Index X in Memory
 	sync(4);
-____runtimeloc_a00f:
-	DecrementX(); // Decrement Index X by One
+	X = 0xff; GAME_SET_FLAGS(0x82, 0x80); // Decrement Index X by One
 	sync(2);
-____runtimeloc_a010:
-	MoveXToSP(); // Transfer Index X to Stack Pointer
+	SP = X; // Transfer Index X to Stack Pointer
 	sync(2);
-____runtimeloc_a011:
-	SetY(0x6); // Load Index Y with Memory
+	Y = 0x6; GAME_SET_FLAGS(0x82, 0x0); // Load Index Y with Memory
 	sync(2);
-____runtimeloc_a013:
-	StoreY(0x1); // Store Index Y in Memory
+	cpu_write8(0x1, 0x6); // Store Index Y in Memory
 	sync(3);
-____runtimeloc_a015:
-	SetY(0x0); // Load Index Y with Memory
+	Y = 0x0; GAME_SET_FLAGS(0x82, 0x2); // Load Index Y with Memory
 	sync(2);
-____runtimeloc_a017:
-	StoreY(0x0); // Store Index Y in Memory
+	cpu_write8(0x0, 0x0); // Store Index Y in Memory
 	sync(3);
-____runtimeloc_a019:
-	SetA(0x0); // Load Accumulator with Memory
+	A = 0x0; GAME_SET_FLAGS(0x82, 0x2); // Load Accumulator with Memory
 	sync(2);
 LOCATION_a01b:
-	StoreA(registers.Y + cpu_read16(0x0)); // Store Accumulator in Memory
+	idiom(&gameIdiomLoops[0], ____idiomexit_a020); // Fill loop: STA ($0),Y / DEY / BNE
+	cpu_write8(Y + cpu_read16(0x0), A); // Store Accumulator in Memory
 	sync(6);
-____runtimeloc_a01d:
-	DecrementY(); // Decrement Index Y by One
+	if(cpu_is_uninterrupted(5)) { Y = Decrement(Y); if(Y != 0x0) { sync(5); goto LOCATION_a01b; } sync(4); } // DEY / BNE $fb (fused count and branch)
+	else
+	{
+	Y = Decrement(Y); // Decrement Index Y by One
 	sync(2);
-____runtimeloc_a01e:
 	if(!cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a01b; } // Branch on Result not Zero
 	sync(2);
-____runtimeloc_a020:
+	}
+____idiomexit_a020:
 	cpu_write8(0x1, Decrement(cpu_read8(0x1))); // Decrement Memory by One
 	sync(5);
-____runtimeloc_a022:
 	if(!cpu_get_flag(CPU_FLAG_SIGN)) { sync(3); goto LOCATION_a01b; } // Branch on Result Plus
 	sync(2);
-____runtimeloc_a024:
-	SetA(0x20); // Load Accumulator with Memory
+	A = 0x20; GAME_SET_FLAGS(0x82, 0x0); // Load Accumulator with Memory
 	sync(2);
-____runtimeloc_a026:
-	StoreA(PPUADDR_REGISTER); // Store Accumulator in Memory
+	cpu_write8(PPUADDR_REGISTER, 0x20); // Store Accumulator in Memory
 	sync(4);
-____runtimeloc_a029:
-	SetA(0x0); // Load Accumulator with Memory
+	A = 0x0; GAME_SET_FLAGS(0x82, 0x2); // Load Accumulator with Memory
 	sync(2);
-____runtimeloc_a02b:
-	StoreA(PPUADDR_REGISTER); // Store Accumulator in Memory
+	cpu_write8(PPUADDR_REGISTER, 0x0); // Store Accumulator in Memory
 	sync(4);
-____runtimeloc_a02e:
-	SetX(0x0); // Load Index X with Memory
+	X = 0x0; GAME_SET_FLAGS(0x82, 0x2); // Load Index X with Memory
 	sync(2);
-____runtimeloc_a030:
-	SetY(0x10); // Load Index Y with Memory
+	Y = 0x10; GAME_SET_FLAGS(0x82, 0x0); // Load Index Y with Memory
 	sync(2);
 LOCATION_a032:
-	StoreA(PPUDATA_REGISTER); // Store Accumulator in Memory
+	idiom(&gameIdiomLoops[1], ____idiomexit_a038); // PPU fill loop: STA $2007 / DEX / BNE
+	cpu_write8(PPUDATA_REGISTER, A); // Store Accumulator in Memory
 	sync(4);
-____runtimeloc_a035:
-	DecrementX(); // Decrement Index X by One
+	if(cpu_is_uninterrupted(5)) { X = Decrement(X); if(X != 0x0) { sync(5); goto LOCATION_a032; } sync(4); } // DEX / BNE $fa (fused count and branch)
+	else
+	{
+	X = Decrement(X); // Decrement Index X by One
 	sync(2);
-____runtimeloc_a036:
 	if(!cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a032; } // Branch on Result not Zero
 	sync(2);
-____runtimeloc_a038:
-	DecrementY(); // Decrement Index Y by One
+	}
+____idiomexit_a038:
+	if(cpu_is_uninterrupted(5)) { Y = Decrement(Y); if(Y != 0x0) { sync(5); goto LOCATION_a032; } sync(4); } // DEY / BNE $f7 (fused count and branch)
+	else
+	{
+	Y = Decrement(Y); // Decrement Index Y by One
 	sync(2);
-____runtimeloc_a039:
 	if(!cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a032; } // Branch on Result not Zero
 	sync(2);
-____runtimeloc_a03b:
-	SetA(0x0); // Load Accumulator with Memory
+	}
+	A = 0x0; GAME_SET_FLAGS(0x82, 0x2); // Load Accumulator with Memory
 	sync(2);
-____runtimeloc_a03d:
-	StoreA(PPUOAMADDR_REGISTER); // Store Accumulator in Memory
+	cpu_write8(PPUOAMADDR_REGISTER, 0x0); // Store Accumulator in Memory
 	sync(4);
-____runtimeloc_a040:
-	MoveAToY(); // Transfer Accumulator to Index Y
+	Y = 0x0; GAME_SET_FLAGS(0x82, 0x2); // Transfer Accumulator to Index Y
 	sync(2);
 LOCATION_a041:
-	StoreA(PPUOAMDATA_REGISTER); // Store Accumulator in Memory
+	do // Loop (9 cycles per iteration)
+	{
+	cpu_write8(PPUOAMDATA_REGISTER, 0x0); // Store Accumulator in Memory
 	sync(4);
-____runtimeloc_a044:
-	DecrementY(); // Decrement Index Y by One
-	sync(2);
-____runtimeloc_a045:
-	if(!cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a041; } // Branch on Result not Zero
+	Y = Decrement(Y); // Decrement Index Y by One
 	sync(2);
-____runtimeloc_a047:
-	SetX(0x0); // Load Index X with Memory
+	loopTaken_a041 = !cpu_get_flag(CPU_FLAG_ZERO); // Branch on Result not Zero (loop)
+	sync(loopTaken_a041 ? 3 : 2);
+	} while(loopTaken_a041);
+	X = 0x0; GAME_SET_FLAGS(0x82, 0x2); // Load Index X with Memory
 	sync(2);
 LOCATION_a049:
-	SetA(cpu_read8(registers.X + 0xe171)); // Load Accumulator with Memory
+	idiom(&gameIdiomLoops[2], ____idiomexit_a054); // Copy loop: LDA $e171,X / STA $600,X / INX / CPX #$c0 / BNE
+	A = cpu_read8(X + 0xe171); // Load Accumulator with Memory
 	sync(4);
-____runtimeloc_a04c:
-	StoreA(registers.X + 0x600); // Store Accumulator in Memory
+	cpu_write8(X + 0x600, A); // Store Accumulator in Memory
 	sync(5);
-____runtimeloc_a04f:
-	IncrementX(); // Increment Index X by One
+	if(cpu_is_uninterrupted(7)) { X = Increment(X); MOSInstr_Compare(X, 0xc0); if(X != 0xc0) { sync(7); goto LOCATION_a049; } sync(6); } // INX / CPX #$c0 / BNE $f5 (fused count and branch)
+	else
+	{
+	X++; // Increment Index X by One
 	sync(2);
-____runtimeloc_a050:
-	CompareWithX(0xc0); // Compare Memory and Index X
+	MOSInstr_Compare(X, 0xc0); // Compare Memory and Index X
 	sync(2);
-____runtimeloc_a052:
 	if(!cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a049; } // Branch on Result not Zero
 	sync(2);
-____runtimeloc_a054:
-	SetX(0x0); // Load Index X with Memory
+	}
+____idiomexit_a054:
+	X = 0x0; GAME_SET_FLAGS(0x82, 0x2); // Load Index X with Memory
 	sync(2);
 LOCATION_a056:
-	SetA(cpu_read8(registers.X + 0xe231)); // Load Accumulator with Memory
+	idiom(&gameIdiomLoops[3], ____idiomexit_a05f); // Copy loop: LDA $e231,X / STA $700,X / INX / BNE
+	A = cpu_read8(X + 0xe231); // Load Accumulator with Memory
 	sync(4);
-____runtimeloc_a059:
-	StoreA(registers.X + 0x700); // Store Accumulator in Memory
+	cpu_write8(X + 0x700, A); // Store Accumulator in Memory
 	sync(5);
-____runtimeloc_a05c:
-	IncrementX(); // Increment Index X by One
+	if(cpu_is_uninterrupted(5)) { X = Increment(X); if(X != 0x0) { sync(5); goto LOCATION_a056; } sync(4); } // INX / BNE $f7 (fused count and branch)
+	else
+	{
+	X = Increment(X); // Increment Index X by One
 	sync(2);
-____runtimeloc_a05d:
 	if(!cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a056; } // Branch on Result not Zero
 	sync(2);
-____runtimeloc_a05f:
-	SetX(0x3f); // Load Index X with Memory
+	}
+____idiomexit_a05f:
+	X = 0x3f; GAME_SET_FLAGS(0x82, 0x0); // Load Index X with Memory
 	sync(2);
-____runtimeloc_a061:
-	StoreX(PPUADDR_REGISTER); // Store Index X in Memory
+	cpu_write8(PPUADDR_REGISTER, 0x3f); // Store Index X in Memory
 	sync(4);
-____runtimeloc_a064:
-	SetX(0x0); // Load Index X with Memory
+	X = 0x0; GAME_SET_FLAGS(0x82, 0x2); // Load Index X with Memory
 	sync(2);
-____runtimeloc_a066:
-	StoreX(PPUADDR_REGISTER); // Store Index X in Memory
+	cpu_write8(PPUADDR_REGISTER, 0x0); // Store Index X in Memory
 	sync(4);
-____runtimeloc_a069:
-	SetX(0xd); // Load Index X with Memory
+	X = 0xd; GAME_SET_FLAGS(0x82, 0x0); // Load Index X with Memory
 	sync(2);
-____runtimeloc_a06b:
-	SetY(0x10); // Load Index Y with Memory
+	Y = 0x10; GAME_SET_FLAGS(0x82, 0x0); // Load Index Y with Memory
 	sync(2);
 LOCATION_a06d:
-	StoreX(PPUDATA_REGISTER); // Store Index X in Memory
+	do // Loop (9 cycles per iteration)
+	{
+	cpu_write8(PPUDATA_REGISTER, 0xd); // Store Index X in Memory
 	sync(4);
-____runtimeloc_a070:
-	DecrementY(); // Decrement Index Y by One
+	Y = Decrement(Y); // Decrement Index Y by One
 	sync(2);
-____runtimeloc_a071:
-	if(!cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a06d; } // Branch on Result not Zero
+	loopTaken_a06d = !cpu_get_flag(CPU_FLAG_ZERO); // Branch on Result not Zero (loop)
+	sync(loopTaken_a06d ? 3 : 2);
+	} while(loopTaken_a06d);
+	X = 0x0; GAME_SET_FLAGS(0x82, 0x2); // Load Index X with Memory
 	sync(2);
-____runtimeloc_a073:
-	SetX(0x0); // Load Index X with Memory
-	sync(2);
-____runtimeloc_a075:
-	SetY(0x10); // Load Index Y with Memory
+	Y = 0x10; GAME_SET_FLAGS(0x82, 0x0); // Load Index Y with Memory
 	sync(2);
 LOCATION_a077:
-	SetA(cpu_read8(registers.X + 0xe431)); // Load Accumulator with Memory
+	do // Loop (15 cycles per iteration)
+	{
+	A = cpu_read8(X + 0xe431); // Load Accumulator with Memory
 	sync(4);
-____runtimeloc_a07a:
-	StoreA(PPUDATA_REGISTER); // Store Accumulator in Memory
+	cpu_write8(PPUDATA_REGISTER, A); // Store Accumulator in Memory
 	sync(4);
-____runtimeloc_a07d:
-	IncrementX(); // Increment Index X by One
-	sync(2);
-____runtimeloc_a07e:
-	DecrementY(); // Decrement Index Y by One
+	X++; // Increment Index X by One
 	sync(2);
-____runtimeloc_a07f:
-	if(!cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a077; } // Branch on Result not Zero
+	Y = Decrement(Y); // Decrement Index Y by One
 	sync(2);
-____runtimeloc_a081:
-	SetA(0x0); // Load Accumulator with Memory
+	loopTaken_a077 = !cpu_get_flag(CPU_FLAG_ZERO); // Branch on Result not Zero (loop)
+	sync(loopTaken_a077 ? 3 : 2);
+	} while(loopTaken_a077);
+	A = 0x0; GAME_SET_FLAGS(0x82, 0x2); // Load Accumulator with Memory
 	sync(2);
-____runtimeloc_a083:
-	StoreA(0x0); // Store Accumulator in Memory
+	cpu_write8(0x0, 0x0); // Store Accumulator in Memory
 	sync(3);
-____runtimeloc_a085:
-	SetA(0x80); // Load Accumulator with Memory
+	A = 0x80; GAME_SET_FLAGS(0x82, 0x80); // Load Accumulator with Memory
 	sync(2);
-____runtimeloc_a087:
-	StoreA(0x1); // Store Accumulator in Memory
+	cpu_write8(0x1, 0x80); // Store Accumulator in Memory
 	sync(3);
-____runtimeloc_a089:
-	SetA(0x1); // Load Accumulator with Memory
+	A = 0x1; GAME_SET_FLAGS(0x82, 0x0); // Load Accumulator with Memory
 	sync(2);
-____runtimeloc_a08b:
-	StoreA(0x3); // Store Accumulator in Memory
+	cpu_write8(0x3, 0x1); // Store Accumulator in Memory
 	sync(3);
-____runtimeloc_a08d:
-	SetA(0x80); // Load Accumulator with Memory
+	A = 0x80; GAME_SET_FLAGS(0x82, 0x80); // Load Accumulator with Memory
 	sync(2);
-____runtimeloc_a08f:
-	StoreA(PPUCTRL_REGISTER); // Store Accumulator in Memory
+	cpu_write8(PPUCTRL_REGISTER, 0x80); // Store Accumulator in Memory
 	sync(4);
-____runtimeloc_a092:
-	SetA(0x1e); // Load Accumulator with Memory
+	A = 0x1e; GAME_SET_FLAGS(0x82, 0x0); // Load Accumulator with Memory
 	sync(2);
-____runtimeloc_a094:
-	StoreA(PPUMASK_REGISTER); // Store Accumulator in Memory
+	cpu_write8(PPUMASK_REGISTER, 0x1e); // Store Accumulator in Memory
 	sync(4);
 LOCATION_a097:
-	SetA(cpu_read8(0x0)); // Load Accumulator with Memory
+	A = MOSInstr_Load(cpu_read8(0x0)); // Load Accumulator with Memory
 	sync(3);
-____runtimeloc_a099:
 	if(cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a097; } // Branch on Result Zero
 	sync(2);
-____runtimeloc_a09b:
-	XORWithA(0x1); // "Exclusive-OR" Memory with Accumulator
+	A ^= 0x1; // "Exclusive-OR" Memory with Accumulator
 	sync(2);
-____runtimeloc_a09d:
-	StoreA(0x0); // Store Accumulator in Memory
+	cpu_write8(0x0, A); // Store Accumulator in Memory
 	sync(3);
-____runtimeloc_a09f:
-	SetX(0x0); // Load Index X with Memory
+	X = 0x0; GAME_SET_FLAGS(0x82, 0x2); // Load Index X with Memory
 	sync(2);
 LOCATION_a0a1:
-	SetA(cpu_read8(registers.X + 0x600)); // Load Accumulator with Memory
+	A = cpu_read8(X + 0x600); // Load Accumulator with Memory
 	sync(4);
-____runtimeloc_a0a4:
-	StoreA(0x11); // Store Accumulator in Memory
+	cpu_write8(0x11, A); // Store Accumulator in Memory
 	sync(3);
-____runtimeloc_a0a6:
-	SetA(cpu_read8(registers.X + 0x640)); // Load Accumulator with Memory
+	A = cpu_read8(X + 0x640); // Load Accumulator with Memory
 	sync(4);
-____runtimeloc_a0a9:
-	StoreX(0x10); // Store Index X in Memory
+	cpu_write8(0x10, X); // Store Index X in Memory
 	sync(3);
-____runtimeloc_a0ab:
-	AndA(0x1); // "AND" Memory with Accumulator
+	A = MOSInstr_Load(A & 0x1); // "AND" Memory with Accumulator
 	sync(2);
-____runtimeloc_a0ad:
 	if(cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a0b6; } // Branch on Result Zero
 	sync(2);
-____runtimeloc_a0af:
-	SetA(0xff); // Load Accumulator with Memory
+	A = 0xff; GAME_SET_FLAGS(0x82, 0x80); // Load Accumulator with Memory
 	sync(2);
-____runtimeloc_a0b1:
 	SetCarryFlag(); // Set Carry Flag
 	sync(2);
-____runtimeloc_a0b2:
-	SubtractFromA(cpu_read8(0x11)); // Subtract Memory from Accumulator with Borrow
+	A = MOSInstr_SubtractWithBorrow(A, cpu_read8(0x11)); // Subtract Memory from Accumulator with Borrow
 	sync(3);
-____runtimeloc_a0b4:
-	StoreA(0x11); // Store Accumulator in Memory
+	cpu_write8(0x11, A); // Store Accumulator in Memory
 	sync(3);
 LOCATION_a0b6:
-	SetX(cpu_read8(0x11)); // Load Index X with Memory
+	X = cpu_read8(0x11); // Load Index X with Memory
 	sync(3);
-____runtimeloc_a0b8:
-	SetA(cpu_read8(registers.X + 0xe331)); // Load Accumulator with Memory
+	A = cpu_read8(X + 0xe331); // Load Accumulator with Memory
 	sync(4);
-____runtimeloc_a0bb:
-	SetX(cpu_read8(0x10)); // Load Index X with Memory
+	X = cpu_read8(0x10); // Load Index X with Memory
 	sync(3);
-____runtimeloc_a0bd:
-	StoreA(0xfc); // Store Accumulator in Memory
+	cpu_write8(0xfc, A); // Store Accumulator in Memory
 	sync(3);
-____runtimeloc_a0bf:
-	SetA(cpu_read8(registers.X + 0x680)); // Load Accumulator with Memory
+	A = cpu_read8(X + 0x680); // Load Accumulator with Memory
 	sync(4);
-____runtimeloc_a0c2:
-	StoreA(0xfd); // Store Accumulator in Memory
+	cpu_write8(0xfd, A); // Store Accumulator in Memory
 	sync(3);
-____runtimeloc_a0c4:
-	sync(6); if(game_execute(ID_LOCATION_a441)) return TRUE; // Jump to New Location Saving Return Address
-____runtimeloc_a0c7:
-	SetA(cpu_read8(0xff)); // Load Accumulator with Memory
+	sync(6); GAME_SPILL_REGISTERS(); if(game_function_a441(ID_FUNCTION_a441)) return TRUE; GAME_LOAD_REGISTERS(); // Jump to New Location Saving Return Address
+	A = cpu_read8(0xff); // Load Accumulator with Memory
 	sync(3);
-____runtimeloc_a0c9:
-	StoreA(0x11); // Store Accumulator in Memory
+	cpu_write8(0x11, A); // Store Accumulator in Memory
 	sync(3);
-____runtimeloc_a0cb:
-	SetA(cpu_read8(registers.X + 0x640)); // Load Accumulator with Memory
+	A = cpu_read8(X + 0x640); // Load Accumulator with Memory
 	sync(4);
-____runtimeloc_a0ce:
-	AndA(0x2); // "AND" Memory with Accumulator
+	A = MOSInstr_Load(A & 0x2); // "AND" Memory with Accumulator
 	sync(2);
-____runtimeloc_a0d0:
 	if(cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a0dc; } // Branch on Result Zero
 	sync(2);
-____runtimeloc_a0d2:
-	SetA(cpu_read8(0x1)); // Load Accumulator with Memory
+	A = cpu_read8(0x1); // Load Accumulator with Memory
 	sync(3);
-____runtimeloc_a0d4:
 	SetCarryFlag(); // Set Carry Flag
 	sync(2);
-____runtimeloc_a0d5:
-	SubtractFromA(cpu_read8(0x11)); // Subtract Memory from Accumulator with Borrow
+	A = MOSInstr_SubtractWithBorrow(A, cpu_read8(0x11)); // Subtract Memory from Accumulator with Borrow
 	sync(3);
-____runtimeloc_a0d7:
-	StoreA(0x11); // Store Accumulator in Memory
+	cpu_write8(0x11, A); // Store Accumulator in Memory
 	sync(3);
-____runtimeloc_a0d9:
 	sync(3);
 	goto LOCATION_a0e3; // Jump to New Location
 LOCATION_a0dc:
-	SetA(cpu_read8(0x1)); // Load Accumulator with Memory
+	A = cpu_read8(0x1); // Load Accumulator with Memory
 	sync(3);
-____runtimeloc_a0de:
 	ClearCarryFlag(); // Clear Carry Flag
 	sync(2);
-____runtimeloc_a0df:
-	AddToA(cpu_read8(0x11)); // Add Memory to Accumulator with Carry
+	A = MOSInstr_AddWithCarry(A, cpu_read8(0x11)); // Add Memory to Accumulator with Carry
 	sync(3);
-____runtimeloc_a0e1:
-	StoreA(0x11); // Store Accumulator in Memory
+	cpu_write8(0x11, A); // Store Accumulator in Memory
 	sync(3);
 LOCATION_a0e3:
-	MoveXToA(); // Transfer Index X to Accumulator
+	A = X; // Transfer Index X to Accumulator
 	sync(2);
-____runtimeloc_a0e4:
-	registers.A = ShiftLeft(registers.A); // Shift Left One Bit (Memory or Accumulator)
+	if(cpu_is_uninterrupted(4)) { A = MOSInstr_ShiftLeftBy(A, 2); sync(4); } // ASL A / ASL A (fused shift chain)
+	else
+	{
+	A = ShiftLeft(A); // Shift Left One Bit (Memory or Accumulator)
 	sync(2);
-____runtimeloc_a0e5:
-	registers.A = ShiftLeft(registers.A); // Shift Left One Bit (Memory or Accumulator)
+	A = ShiftLeft(A); // Shift Left One Bit (Memory or Accumulator)
 	sync(2);
-____runtimeloc_a0e6:
+	}
 	ClearCarryFlag(); // Clear Carry Flag
 	sync(2);
-____runtimeloc_a0e7:
-	AddToA(0x3); // Add Memory to Accumulator with Carry
+	A = MOSInstr_AddWithCarry(A, 0x3); // Add Memory to Accumulator with Carry
 	sync(2);
-____runtimeloc_a0e9:
-	MoveAToX(); // Transfer Accumulator to Index X
+	X = A; // Transfer Accumulator to Index X
 	sync(2);
-____runtimeloc_a0ea:
-	SetA(cpu_read8(0x11)); // Load Accumulator with Memory
+	A = cpu_read8(0x11); // Load Accumulator with Memory
 	sync(3);
-____runtimeloc_a0ec:
-	StoreA(registers.X + 0x700); // Store Accumulator in Memory
+	cpu_write8(X + 0x700, A); // Store Accumulator in Memory
 	sync(5);
-____runtimeloc_a0ef:
-	SetX(cpu_read8(0x10)); // Load Index X with Memory
+	X = cpu_read8(0x10); // Load Index X with Memory
 	sync(3);
-____runtimeloc_a0f1:
-	SetA(cpu_read8(registers.X + 0x600)); // Load Accumulator with Memory
+	A = cpu_read8(X + 0x600); // Load Accumulator with Memory
 	sync(4);
-____runtimeloc_a0f4:
-	StoreA(0x11); // Store Accumulator in Memory
+	cpu_write8(0x11, A); // Store Accumulator in Memory
 	sync(3);
-____runtimeloc_a0f6:
-	SetA(cpu_read8(registers.X + 0x640)); // Load Accumulator with Memory
+	A = cpu_read8(X + 0x640); // Load Accumulator with Memory
 	sync(4);
-____runtimeloc_a0f9:
-	StoreX(0x10); // Store Index X in Memory
+	cpu_write8(0x10, X); // Store Index X in Memory
 	sync(3);
-____runtimeloc_a0fb:
-	AndA(0x1); // "AND" Memory with Accumulator
+	A = MOSInstr_Load(A & 0x1); // "AND" Memory with Accumulator
 	sync(2);
-____runtimeloc_a0fd:
 	if(!cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a106; } // Branch on Result not Zero
 	sync(2);
-____runtimeloc_a0ff:
-	SetA(0xff); // Load Accumulator with Memory
+	A = 0xff; GAME_SET_FLAGS(0x82, 0x80); // Load Accumulator with Memory
 	sync(2);
-____runtimeloc_a101:
 	SetCarryFlag(); // Set Carry Flag
 	sync(2);
-____runtimeloc_a102:
-	SubtractFromA(cpu_read8(0x11)); // Subtract Memory from Accumulator with Borrow
+	A = MOSInstr_SubtractWithBorrow(A, cpu_read8(0x11)); // Subtract Memory from Accumulator with Borrow
 	sync(3);
-____runtimeloc_a104:
-	StoreA(0x11); // Store Accumulator in Memory
+	cpu_write8(0x11, A); // Store Accumulator in Memory
 	sync(3);
 LOCATION_a106:
-	SetX(cpu_read8(0x11)); // Load Index X with Memory
+	X = cpu_read8(0x11); // Load Index X with Memory
 	sync(3);
-____runtimeloc_a108:
-	SetA(cpu_read8(registers.X + 0xe331)); // Load Accumulator with Memory
+	A = cpu_read8(X + 0xe331); // Load Accumulator with Memory
 	sync(4);
-____runtimeloc_a10b:
-	SetX(cpu_read8(0x10)); // Load Index X with Memory
+	X = cpu_read8(0x10); // Load Index X with Memory
 	sync(3);
-____runtimeloc_a10d:
-	StoreA(0xfc); // Store Accumulator in Memory
+	cpu_write8(0xfc, A); // Store Accumulator in Memory
 	sync(3);
-____runtimeloc_a10f:
-	SetA(cpu_read8(registers.X + 0x680)); // Load Accumulator with Memory
+	A = cpu_read8(X + 0x680); // Load Accumulator with Memory
 	sync(4);
-____runtimeloc_a112:
-	StoreA(0xfd); // Store Accumulator in Memory
+	cpu_write8(0xfd, A); // Store Accumulator in Memory
 	sync(3);
-____runtimeloc_a114:
-	sync(6); if(game_execute(ID_LOCATION_a441)) return TRUE; // Jump to New Location Saving Return Address
-____runtimeloc_a117:
-	SetA(cpu_read8(0xff)); // Load Accumulator with Memory
+	sync(6); GAME_SPILL_REGISTERS(); if(game_function_a441(ID_FUNCTION_a441)) return TRUE; GAME_LOAD_REGISTERS(); // Jump to New Location Saving Return Address
+	A = cpu_read8(0xff); // Load Accumulator with Memory
 	sync(3);
-____runtimeloc_a119:
-	StoreA(0x11); // Store Accumulator in Memory
+	cpu_write8(0x11, A); // Store Accumulator in Memory
 	sync(3);
-____runtimeloc_a11b:
-	SetA(cpu_read8(registers.X + 0x640)); // Load Accumulator with Memory
+	A = cpu_read8(X + 0x640); // Load Accumulator with Memory
 	sync(4);
-____runtimeloc_a11e:
-	CompareWithA(0x0); // Compare Memory and Accumulator
+	if(cpu_is_uninterrupted(5)) { MOSInstr_Compare(A, 0x0); if(A == 0x0) { sync(5); goto LOCATION_a130; } sync(4); } // CMP #$0 / BEQ $e (fused compare and branch)
+	else
+	{
+	MOSInstr_Compare(A, 0x0); // Compare Memory and Accumulator
 	sync(2);
-____runtimeloc_a120:
 	if(cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a130; } // Branch on Result Zero
 	sync(2);
-____runtimeloc_a122:
-	CompareWithA(0x3); // Compare Memory and Accumulator
+	}
+	if(cpu_is_uninterrupted(5)) { MOSInstr_Compare(A, 0x3); if(A == 0x3) { sync(5); goto LOCATION_a130; } sync(4); } // CMP #$3 / BEQ $a (fused compare and branch)
+	else
+	{
+	MOSInstr_Compare(A, 0x3); // Compare Memory and Accumulator
 	sync(2);
-____runtimeloc_a124:
 	if(cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a130; } // Branch on Result Zero
 	sync(2);
-____runtimeloc_a126:
-	SetA(cpu_read8(0x1)); // Load Accumulator with Memory
+	}
+	A = cpu_read8(0x1); // Load Accumulator with Memory
 	sync(3);
-____runtimeloc_a128:
 	SetCarryFlag(); // Set Carry Flag
 	sync(2);
-____runtimeloc_a129:
-	SubtractFromA(cpu_read8(0x11)); // Subtract Memory from Accumulator with Borrow
+	A = MOSInstr_SubtractWithBorrow(A, cpu_read8(0x11)); // Subtract Memory from Accumulator with Borrow
 	sync(3);
-____runtimeloc_a12b:
-	StoreA(0x11); // Store Accumulator in Memory
+	cpu_write8(0x11, A); // Store Accumulator in Memory
 	sync(3);
-____runtimeloc_a12d:
 	sync(3);
 	goto LOCATION_a137; // Jump to New Location
 LOCATION_a130:
-	SetA(cpu_read8(0x1)); // Load Accumulator with Memory
+	A = cpu_read8(0x1); // Load Accumulator with Memory
 	sync(3);
-____runtimeloc_a132:
 	ClearCarryFlag(); // Clear Carry Flag
 	sync(2);
-____runtimeloc_a133:
-	AddToA(cpu_read8(0x11)); // Add Memory to Accumulator with Carry
+	A = MOSInstr_AddWithCarry(A, cpu_read8(0x11)); // Add Memory to Accumulator with Carry
 	sync(3);
-____runtimeloc_a135:
-	StoreA(0x11); // Store Accumulator in Memory
+	cpu_write8(0x11, A); // Store Accumulator in Memory
 	sync(3);
 LOCATION_a137:
-	MoveXToA(); // Transfer Index X to Accumulator
+	A = X; // Transfer Index X to Accumulator
 	sync(2);
-____runtimeloc_a138:
-	registers.A = ShiftLeft(registers.A); // Shift Left One Bit (Memory or Accumulator)
+	if(cpu_is_uninterrupted(4)) { A = MOSInstr_ShiftLeftBy(A, 2); sync(4); } // ASL A / ASL A (fused shift chain)
+	else
+	{
+	A = ShiftLeft(A); // Shift Left One Bit (Memory or Accumulator)
 	sync(2);
-____runtimeloc_a139:
-	registers.A = ShiftLeft(registers.A); // Shift Left One Bit (Memory or Accumulator)
+	A = ShiftLeft(A); // Shift Left One Bit (Memory or Accumulator)
 	sync(2);
-____runtimeloc_a13a:
-	MoveAToX(); // Transfer Accumulator to Index X
+	}
+	X = A; // Transfer Accumulator to Index X
 	sync(2);
-____runtimeloc_a13b:
-	SetA(cpu_read8(0x11)); // Load Accumulator with Memory
+	A = cpu_read8(0x11); // Load Accumulator with Memory
 	sync(3);
-____runtimeloc_a13d:
-	StoreA(registers.X + 0x700); // Store Accumulator in Memory
+	cpu_write8(X + 0x700, A); // Store Accumulator in Memory
 	sync(5);
-____runtimeloc_a140:
-	SetX(cpu_read8(0x10)); // Load Index X with Memory
+	X = cpu_read8(0x10); // Load Index X with Memory
 	sync(3);
-____runtimeloc_a142:
-	IncrementX(); // Increment Index X by One
+	if(cpu_is_uninterrupted(7)) { X = Increment(X); MOSInstr_Compare(X, 0x40); if(X == 0x40) { sync(7); goto LOCATION_a14a; } sync(6); } // INX / CPX #$40 / BEQ $3 (fused count and branch)
+	else
+	{
+	X++; // Increment Index X by One
 	sync(2);
-____runtimeloc_a143:
-	CompareWithX(0x40); // Compare Memory and Index X
+	MOSInstr_Compare(X, 0x40); // Compare Memory and Index X
 	sync(2);
-____runtimeloc_a145:
 	if(cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a14a; } // Branch on Result Zero
 	sync(2);
-____runtimeloc_a147:
+	}
 	sync(3);
 	goto LOCATION_a0a1; // Jump to New Location
 LOCATION_a14a:
-	SetX(0x0); // Load Index X with Memory
+	X = 0x0; GAME_SET_FLAGS(0x82, 0x2); // Load Index X with Memory
 	sync(2);
 LOCATION_a14c:
-	cpu_write8(registers.X + 0x680, Increment(cpu_read8(registers.X + 0x680))); // Increment Memory by One
+	do // Loop (2 code sections)
+	{
+	cpu_write8(X + 0x680, Increment(cpu_read8(X + 0x680))); // Increment Memory by One
 	sync(7);
-____runtimeloc_a14f:
 	SetCarryFlag(); // Set Carry Flag
 	sync(2);
-____runtimeloc_a150:
-	SetA(0x0); // Load Accumulator with Memory
+	A = 0x0; GAME_SET_FLAGS(0x82, 0x2); // Load Accumulator with Memory
 	sync(2);
-____runtimeloc_a152:
-	AddToA(cpu_read8(registers.X + 0x600)); // Add Memory to Accumulator with Carry
+	A = MOSInstr_AddWithCarry(A, cpu_read8(X + 0x600)); // Add Memory to Accumulator with Carry
 	sync(4);
-____runtimeloc_a155:
-	StoreA(registers.X + 0x600); // Store Accumulator in Memory
+	cpu_write8(X + 0x600, A); // Store Accumulator in Memory
 	sync(5);
-____runtimeloc_a158:
 	if(!cpu_get_flag(CPU_FLAG_CARRY)) { sync(3); goto LOCATION_a169; } // Branch on Carry Clear
 	sync(2);
-____runtimeloc_a15a:
-	cpu_write8(registers.X + 0x640, Increment(cpu_read8(registers.X + 0x640))); // Increment Memory by One
+	cpu_write8(X + 0x640, Increment(cpu_read8(X + 0x640))); // Increment Memory by One
 	sync(7);
-____runtimeloc_a15d:
-	SetA(cpu_read8(registers.X + 0x640)); // Load Accumulator with Memory
+	A = cpu_read8(X + 0x640); // Load Accumulator with Memory
 	sync(4);
-____runtimeloc_a160:
-	CompareWithA(0x4); // Compare Memory and Accumulator
+	if(cpu_is_uninterrupted(5)) { MOSInstr_Compare(A, 0x4); if(A != 0x4) { sync(5); goto LOCATION_a169; } sync(4); } // CMP #$4 / BNE $5 (fused compare and branch)
+	else
+	{
+	MOSInstr_Compare(A, 0x4); // Compare Memory and Accumulator
 	sync(2);
-____runtimeloc_a162:
 	if(!cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a169; } // Branch on Result not Zero
 	sync(2);
-____runtimeloc_a164:
-	SetA(0x0); // Load Accumulator with Memory
+	}
+	A = 0x0; GAME_SET_FLAGS(0x82, 0x2); // Load Accumulator with Memory
 	sync(2);
-____runtimeloc_a166:
-	StoreA(registers.X + 0x640); // Store Accumulator in Memory
+	cpu_write8(X + 0x640, A); // Store Accumulator in Memory
 	sync(5);
 LOCATION_a169:
-	IncrementX(); // Increment Index X by One
+	X++; // Increment Index X by One
 	sync(2);
-____runtimeloc_a16a:
-	CompareWithX(0x40); // Compare Memory and Index X
+	MOSInstr_Compare(X, 0x40); // Compare Memory and Index X
 	sync(2);
-____runtimeloc_a16c:
-	if(!cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a14c; } // Branch on Result not Zero
-	sync(2);
-____runtimeloc_a16e:
+	loopTaken_a14c = !cpu_get_flag(CPU_FLAG_ZERO); // Branch on Result not Zero (loop)
+	sync(loopTaken_a14c ? 3 : 2);
+	} while(loopTaken_a14c);
 	sync(3);
 	goto LOCATION_a097; // Jump to New Location
-LOCATION_a441:
-	PushA(); // Push Accumulator on Stack
-	sync(3);
-____runtimeloc_a442:
-	MoveXToA(); // Transfer Index X to Accumulator
-	sync(2);
-____runtimeloc_a443:
-	PushA(); // Push Accumulator on Stack
-	sync(3);
-____runtimeloc_a444:
-	SetA(0x0); // Load Accumulator with Memory
-	sync(2);
-____runtimeloc_a446:
-	StoreA(0xfe); // Store Accumulator in Memory
-	sync(3);
-____runtimeloc_a448:
-	SetX(0x8); // Load Index X with Memory
-	sync(2);
-LOCATION_a44a:
-	cpu_write8(0xfc, ShiftRight(cpu_read8(0xfc))); // Shift Right One Bit (Memory or Accumulator)
-	sync(5);
-____runtimeloc_a44c:
-	if(!cpu_get_flag(CPU_FLAG_CARRY)) { sync(3); goto LOCATION_a451; } // Branch on Carry Clear
-	sync(2);
-____runtimeloc_a44e:
-	ClearCarryFlag(); // Clear Carry Flag
-	sync(2);
-____runtimeloc_a44f:
-	AddToA(cpu_read8(0xfd)); // Add Memory to Accumulator with Carry
-	sync(3);
-LOCATION_a451:
-	registers.A = RotateRight(registers.A); // Rotate One Bit Right (Memory or Accumulator)
-	sync(2);
-____runtimeloc_a452:
-	cpu_write8(0xfe, RotateRight(cpu_read8(0xfe))); // Rotate One Bit Right (Memory or Accumulator)
-	sync(5);
-____runtimeloc_a454:
-	DecrementX(); // Decrement Index X by One
-	sync(2);
-____runtimeloc_a455:
-	if(!cpu_get_flag(CPU_FLAG_ZERO)) { sync(3); goto LOCATION_a44a; } // Branch on Result not Zero
-	sync(2);
-____runtimeloc_a457:
-	StoreA(0xff); // Store Accumulator in Memory
-	sync(3);
-____runtimeloc_a459:
-	PopA(); // Pull Accumulator from Stack
-	sync(4);
-____runtimeloc_a45a:
-	MoveAToX(); // Transfer Accumulator to Index X
-	sync(2);
-____runtimeloc_a45b:
-	PopA(); // Pull Accumulator from Stack
-	sync(4);
-____runtimeloc_a45c:
-	sync(6); return FALSE; // Return from Subroutine
 FUNCTION_NMI:
-	PushA(); // Push Accumulator on Stack
+	pushed_a45d = A; stack[SP--] = A; // Push Accumulator on Stack
 	sync(3);
-____runtimeloc_a45e:
-	SetA(0x1); // Load Accumulator with Memory
+	A = 0x1; GAME_SET_FLAGS(0x82, 0x0); // Load Accumulator with Memory
 	sync(2);
-____runtimeloc_a460:
-	StoreA(0x0); // Store Accumulator in Memory
+	cpu_write8(0x0, 0x1); // Store Accumulator in Memory
 	sync(3);
-____runtimeloc_a462:
-	SetA(0x7); // Load Accumulator with Memory
+	A = 0x7; GAME_SET_FLAGS(0x82, 0x0); // Load Accumulator with Memory
 	sync(2);
-____runtimeloc_a464:
-	StoreA(PPUOAMDMA_REGISTER); // Store Accumulator in Memory
+	cpu_write8(PPUOAMDMA_REGISTER, 0x7); // Store Accumulator in Memory
 	sync(4);
-____runtimeloc_a467:
-	PopA(); // Pull Accumulator from Stack
+	A = MOSInstr_Load(pushed_a45d); SP++; // Pull Accumulator from Stack
 	sync(4);
-____runtimeloc_a468:
-	sync(6); return TRUE; // Return from Interrupt
+	sync(6); GAME_SPILL_REGISTERS(); return TRUE; // Return from Interrupt
 FUNCTION_IRQ:
-	sync(6); return TRUE; // Return from Interrupt
+	sync(6); GAME_SPILL_REGISTERS(); return TRUE; // Return from Interrupt
 
         
-    // Switch table for functions here first.
+    // Jump table for functions here first.
     // This jumps to the appropriate code location based off a given address.
     // Absolute jumps jump directly, runtime calculated (indirect) jumps use this table.
     // Anything that calls this function obviously also uses this to begin in the correct location since goto's are local.
     // NOTE: We can only put one case per address even though there may be multiple labels at a given address.
+    // (Locations in subroutines are executed by calling the subroutine's function)
     Jump:
+#if GAME_USE_COMPUTED_GOTO
+    {
+        static const INT jumpTable[0x4000] =
+        {
+            [0x2000] = &&FUNCTION_RESET - &&JumpDefault,
+            [0x2002] = &&LOCATION_a002 - &&JumpDefault,
+            [0x201b] = &&LOCATION_a01b - &&JumpDefault,
+            [0x2032] = &&LOCATION_a032 - &&JumpDefault,
+            [0x2041] = &&LOCATION_a041 - &&JumpDefault,
+            [0x2049] = &&LOCATION_a049 - &&JumpDefault,
+            [0x2056] = &&LOCATION_a056 - &&JumpDefault,
+            [0x206d] = &&LOCATION_a06d - &&JumpDefault,
+            [0x2077] = &&LOCATION_a077 - &&JumpDefault,
+            [0x2097] = &&LOCATION_a097 - &&JumpDefault,
+            [0x20a1] = &&LOCATION_a0a1 - &&JumpDefault,
+            [0x20b6] = &&LOCATION_a0b6 - &&JumpDefault,
+            [0x20dc] = &&LOCATION_a0dc - &&JumpDefault,
+            [0x20e3] = &&LOCATION_a0e3 - &&JumpDefault,
+            [0x2106] = &&LOCATION_a106 - &&JumpDefault,
+            [0x2130] = &&LOCATION_a130 - &&JumpDefault,
+            [0x2137] = &&LOCATION_a137 - &&JumpDefault,
+            [0x214a] = &&LOCATION_a14a - &&JumpDefault,
+            [0x214c] = &&LOCATION_a14c - &&JumpDefault,
+            [0x2169] = &&LOCATION_a169 - &&JumpDefault,
+            [0x2441] = &&____delegate_a441 - &&JumpDefault,
+            [0x244a] = &&____delegate_a441 - &&JumpDefault,
+            [0x2451] = &&____delegate_a441 - &&JumpDefault,
+            [0x245d] = &&FUNCTION_NMI - &&JumpDefault,
+            [0x2469] = &&FUNCTION_IRQ - &&JumpDefault,
+        };
+        if(jumpAddress >= 0x8000)
+        {
+            jumpAddress &= 0xbfff; // Our ROM is mirrored onto the second bank.
+            goto *(&&JumpDefault + jumpTable[jumpAddress - 0x8000]);
+        }
+    }
+#else
     switch(jumpAddress)
     {
+	case ID_FUNCTION_NMI:
+	case 0xe45d:
+		goto FUNCTION_NMI;
 	case ID_FUNCTION_RESET:
 	case 0xe000:
 		goto FUNCTION_RESET;
-	case ID_LOCATION_a041:
-	case 0xe041:
-		goto LOCATION_a041;
 	case ID_LOCATION_a002:
 	case 0xe002:
 		goto LOCATION_a002;
-	case ID_LOCATION_a106:
-	case 0xe106:
-		goto LOCATION_a106;
-	case ID_LOCATION_a441:
-	case 0xe441:
-		goto LOCATION_a441;
+	case ID_LOCATION_a01b:
+	case 0xe01b:
+		goto LOCATION_a01b;
+	case ID_LOCATION_a032:
+	case 0xe032:
+		goto LOCATION_a032;
+	case ID_LOCATION_a041:
+	case 0xe041:
+		goto LOCATION_a041;
 	case ID_LOCATION_a049:
 	case 0xe049:
 		goto LOCATION_a049;
-	case ID_LOCATION_a44a:
-	case 0xe44a:
-		goto LOCATION_a44a;
-	case ID_LOCATION_a137:
-	case 0xe137:
-		goto LOCATION_a137;
-	case ID_LOCATION_a14c:
-	case 0xe14c:
-		goto LOCATION_a14c;
-	case ID_LOCATION_a451:
-	case 0xe451:
-		goto LOCATION_a451;
 	case ID_LOCATION_a056:
 	case 0xe056:
 		goto LOCATION_a056;
+	case ID_LOCATION_a06d:
+	case 0xe06d:
+		goto LOCATION_a06d;
+	case ID_LOCATION_a077:
+	case 0xe077:
+		goto LOCATION_a077;
 	case ID_LOCATION_a097:
 	case 0xe097:
 		goto LOCATION_a097;
-	case ID_LOCATION_a01b:
-	case 0xe01b:
-		goto LOCATION_a01b;
+	case ID_LOCATION_a0b6:
+	case 0xe0b6:
+		goto LOCATION_a0b6;
+	case ID_FUNCTION_a441:
+	case 0xe441:
+		GAME_SPILL_REGISTERS(); return game_function_a441(ID_FUNCTION_a441);
+	case ID_LOCATION_a451:
+	case 0xe451:
+		GAME_SPILL_REGISTERS(); return game_function_a441(ID_LOCATION_a451);
+	case ID_LOCATION_a44a:
+	case 0xe44a:
+		GAME_SPILL_REGISTERS(); return game_function_a441(ID_LOCATION_a44a);
 	case ID_LOCATION_a0dc:
 	case 0xe0dc:
 		goto LOCATION_a0dc;
-	case ID_FUNCTION_NMI:
-	case 0xe45d:
-		goto FUNCTION_NMI;
+	case ID_LOCATION_a106:
+	case 0xe106:
+		goto LOCATION_a106;
+	case ID_LOCATION_a130:
+	case 0xe130:
+		goto LOCATION_a130;
+	case ID_LOCATION_a14a:
+	case 0xe14a:
+		goto LOCATION_a14a;
+	case ID_LOCATION_a169:
+	case 0xe169:
+		goto LOCATION_a169;
+	case ID_LOCATION_a14c:
+	case 0xe14c:
+		goto LOCATION_a14c;
 	case ID_LOCATION_a0a1:
 	case 0xe0a1:
 		goto LOCATION_a0a1;
+	case ID_LOCATION_a137:
+	case 0xe137:
+		goto LOCATION_a137;
 	case ID_LOCATION_a0e3:
 	case 0xe0e3:
 		goto LOCATION_a0e3;
-	case ID_LOCATION_a169:
-	case 0xe169:
-		goto LOCATION_a169;
-	case ID_LOCATION_a06d:
-	case 0xe06d:
-		goto LOCATION_a06d;
-	case ID_LOCATION_a130:
-	case 0xe130:
-		goto LOCATION_a130;
-	case ID_LOCATION_a032:
-	case 0xe032:
-		goto LOCATION_a032;
 	case ID_FUNCTION_IRQ:
 	case 0xe469:
 		goto FUNCTION_IRQ;
-	case ID_LOCATION_a0b6:
-	case 0xe0b6:
-		goto LOCATION_a0b6;
-	case ID_LOCATION_a077:
-	case 0xe077:
-		goto LOCATION_a077;
-	case ID_LOCATION_a14a:
-	case 0xe14a:
-		goto LOCATION_a14a;
-	case 0xa001:
-	case 0xe001:
-		goto ____runtimeloc_a001;
-	case 0xa044:
-	case 0xe044:
-		goto ____runtimeloc_a044;
-	case 0xa045:
-	case 0xe045:
-		goto ____runtimeloc_a045;
-	case 0xa047:
-	case 0xe047:
-		goto ____runtimeloc_a047;
-	case 0xa005:
-	case 0xe005:
-		goto ____runtimeloc_a005;
-	case 0xa007:
-	case 0xe007:
-		goto ____runtimeloc_a007;
-	case 0xa009:
-	case 0xe009:
-		goto ____runtimeloc_a009;
-	case 0xa00c:
-	case 0xe00c:
-		goto ____runtimeloc_a00c;
-	case 0xa00f:
-	case 0xe00f:
-		goto ____runtimeloc_a00f;
-	case 0xa010:
-	case 0xe010:
-		goto ____runtimeloc_a010;
-	case 0xa011:
-	case 0xe011:
-		goto ____runtimeloc_a011;
-	case 0xa013:
-	case 0xe013:
-		goto ____runtimeloc_a013;
-	case 0xa015:
-	case 0xe015:
-		goto ____runtimeloc_a015;
-	case 0xa017:
-	case 0xe017:
-		goto ____runtimeloc_a017;
-	case 0xa019:
-	case 0xe019:
-		goto ____runtimeloc_a019;
-	case 0xa108:
-	case 0xe108:
-		goto ____runtimeloc_a108;
-	case 0xa10b:
-	case 0xe10b:
-		goto ____runtimeloc_a10b;
-	case 0xa10d:
-	case 0xe10d:
-		goto ____runtimeloc_a10d;
-	case 0xa10f:
-	case 0xe10f:
-		goto ____runtimeloc_a10f;
-	case 0xa112:
-	case 0xe112:
-		goto ____runtimeloc_a112;
-	case 0xa114:
-	case 0xe114:
-		goto ____runtimeloc_a114;
-	case 0xa117:
-	case 0xe117:
-		goto ____runtimeloc_a117;
-	case 0xa119:
-	case 0xe119:
-		goto ____runtimeloc_a119;
-	case 0xa11b:
-	case 0xe11b:
-		goto ____runtimeloc_a11b;
-	case 0xa11e:
-	case 0xe11e:
-		goto ____runtimeloc_a11e;
-	case 0xa120:
-	case 0xe120:
-		goto ____runtimeloc_a120;
-	case 0xa122:
-	case 0xe122:
-		goto ____runtimeloc_a122;
-	case 0xa124:
-	case 0xe124:
-		goto ____runtimeloc_a124;
-	case 0xa126:
-	case 0xe126:
-		goto ____runtimeloc_a126;
-	case 0xa128:
-	case 0xe128:
-		goto ____runtimeloc_a128;
-	case 0xa129:
-	case 0xe129:
-		goto ____runtimeloc_a129;
-	case 0xa12b:
-	case 0xe12b:
-		goto ____runtimeloc_a12b;
-	case 0xa12d:
-	case 0xe12d:
-		goto ____runtimeloc_a12d;
-	case 0xa442:
-	case 0xe442:
-		goto ____runtimeloc_a442;
-	case 0xa443:
-	case 0xe443:
-		goto ____runtimeloc_a443;
-	case 0xa444:
-	case 0xe444:
-		goto ____runtimeloc_a444;
-	case 0xa446:
-	case 0xe446:
-		goto ____runtimeloc_a446;
-	case 0xa448:
-	case 0xe448:
-		goto ____runtimeloc_a448;
-	case 0xa04c:
-	case 0xe04c:
-		goto ____runtimeloc_a04c;
-	case 0xa04f:
-	case 0xe04f:
-		goto ____runtimeloc_a04f;
-	case 0xa050:
-	case 0xe050:
-		goto ____runtimeloc_a050;
-	case 0xa052:
-	case 0xe052:
-		goto ____runtimeloc_a052;
-	case 0xa054:
-	case 0xe054:
-		goto ____runtimeloc_a054;
-	case 0xa44c:
-	case 0xe44c:
-		goto ____runtimeloc_a44c;
-	case 0xa44e:
-	case 0xe44e:
-		goto ____runtimeloc_a44e;
-	case 0xa44f:
-	case 0xe44f:
-		goto ____runtimeloc_a44f;
-	case 0xa138:
-	case 0xe138:
-		goto ____runtimeloc_a138;
-	case 0xa139:
-	case 0xe139:
-		goto ____runtimeloc_a139;
-	case 0xa13a:
-	case 0xe13a:
-		goto ____runtimeloc_a13a;
-	case 0xa13b:
-	case 0xe13b:
-		goto ____runtimeloc_a13b;
-	case 0xa13d:
-	case 0xe13d:
-		goto ____runtimeloc_a13d;
-	case 0xa140:
-	case 0xe140:
-		goto ____runtimeloc_a140;
-	case 0xa142:
-	case 0xe142:
-		goto ____runtimeloc_a142;
-	case 0xa143:
-	case 0xe143:
-		goto ____runtimeloc_a143;
-	case 0xa145:
-	case 0xe145:
-		goto ____runtimeloc_a145;
-	case 0xa147:
-	case 0xe147:
-		goto ____runtimeloc_a147;
-	case 0xa14f:
-	case 0xe14f:
-		goto ____runtimeloc_a14f;
-	case 0xa150:
-	case 0xe150:
-		goto ____runtimeloc_a150;
-	case 0xa152:
-	case 0xe152:
-		goto ____runtimeloc_a152;
-	case 0xa155:
-	case 0xe155:
-		goto ____runtimeloc_a155;
-	case 0xa158:
-	case 0xe158:
-		goto ____runtimeloc_a158;
-	case 0xa15a:
-	case 0xe15a:
-		goto ____runtimeloc_a15a;
-	case 0xa15d:
-	case 0xe15d:
-		goto ____runtimeloc_a15d;
-	case 0xa160:
-	case 0xe160:
-		goto ____runtimeloc_a160;
-	case 0xa162:
-	case 0xe162:
-		goto ____runtimeloc_a162;
-	case 0xa164:
-	case 0xe164:
-		goto ____runtimeloc_a164;
-	case 0xa166:
-	case 0xe166:
-		goto ____runtimeloc_a166;
-	case 0xa452:
-	case 0xe452:
-		goto ____runtimeloc_a452;
-	case 0xa454:
-	case 0xe454:
-		goto ____runtimeloc_a454;
-	case 0xa455:
-	case 0xe455:
-		goto ____runtimeloc_a455;
-	case 0xa457:
-	case 0xe457:
-		goto ____runtimeloc_a457;
-	case 0xa459:
-	case 0xe459:
-		goto ____runtimeloc_a459;
-	case 0xa45a:
-	case 0xe45a:
-		goto ____runtimeloc_a45a;
-	case 0xa45b:
-	case 0xe45b:
-		goto ____runtimeloc_a45b;
-	case 0xa45c:
-	case 0xe45c:
-		goto ____runtimeloc_a45c;
-	case 0xa059:
-	case 0xe059:
-		goto ____runtimeloc_a059;
-	case 0xa05c:
-	case 0xe05c:
-		goto ____runtimeloc_a05c;
-	case 0xa05d:
-	case 0xe05d:
-		goto ____runtimeloc_a05d;
-	case 0xa05f:
-	case 0xe05f:
-		goto ____runtimeloc_a05f;
-	case 0xa061:
-	case 0xe061:
-		goto ____runtimeloc_a061;
-	case 0xa064:
-	case 0xe064:
-		goto ____runtimeloc_a064;
-	case 0xa066:
-	case 0xe066:
-		goto ____runtimeloc_a066;
-	case 0xa069:
-	case 0xe069:
-		goto ____runtimeloc_a069;
-	case 0xa06b:
-	case 0xe06b:
-		goto ____runtimeloc_a06b;
-	case 0xa099:
-	case 0xe099:
-		goto ____runtimeloc_a099;
-	case 0xa09b:
-	case 0xe09b:
-		goto ____runtimeloc_a09b;
-	case 0xa09d:
-	case 0xe09d:
-		goto ____runtimeloc_a09d;
-	case 0xa09f:
-	case 0xe09f:
-		goto ____runtimeloc_a09f;
-	case 0xa01d:
-	case 0xe01d:
-		goto ____runtimeloc_a01d;
-	case 0xa01e:
-	case 0xe01e:
-		goto ____runtimeloc_a01e;
-	case 0xa020:
-	case 0xe020:
-		goto ____runtimeloc_a020;
-	case 0xa022:
-	case 0xe022:
-		goto ____runtimeloc_a022;
-	case 0xa024:
-	case 0xe024:
-		goto ____runtimeloc_a024;
-	case 0xa026:
-	case 0xe026:
-		goto ____runtimeloc_a026;
-	case 0xa029:
-	case 0xe029:
-		goto ____runtimeloc_a029;
-	case 0xa02b:
-	case 0xe02b:
-		goto ____runtimeloc_a02b;
-	case 0xa02e:
-	case 0xe02e:
-		goto ____runtimeloc_a02e;
-	case 0xa030:
-	case 0xe030:
-		goto ____runtimeloc_a030;
-	case 0xa0de:
-	case 0xe0de:
-		goto ____runtimeloc_a0de;
-	case 0xa0df:
-	case 0xe0df:
-		goto ____runtimeloc_a0df;
-	case 0xa0e1:
-	case 0xe0e1:
-		goto ____runtimeloc_a0e1;
-	case 0xa45e:
-	case 0xe45e:
-		goto ____runtimeloc_a45e;
-	case 0xa460:
-	case 0xe460:
-		goto ____runtimeloc_a460;
-	case 0xa462:
-	case 0xe462:
-		goto ____runtimeloc_a462;
-	case 0xa464:
-	case 0xe464:
-		goto ____runtimeloc_a464;
-	case 0xa467:
-	case 0xe467:
-		goto ____runtimeloc_a467;
-	case 0xa468:
-	case 0xe468:
-		goto ____runtimeloc_a468;
-	case 0xa0a4:
-	case 0xe0a4:
-		goto ____runtimeloc_a0a4;
-	case 0xa0a6:
-	case 0xe0a6:
-		goto ____runtimeloc_a0a6;
-	case 0xa0a9:
-	case 0xe0a9:
-		goto ____runtimeloc_a0a9;
-	case 0xa0ab:
-	case 0xe0ab:
-		goto ____runtimeloc_a0ab;
-	case 0xa0ad:
-	case 0xe0ad:
-		goto ____runtimeloc_a0ad;
-	case 0xa0af:
-	case 0xe0af:
-		goto ____runtimeloc_a0af;
-	case 0xa0b1:
-	case 0xe0b1:
-		goto ____runtimeloc_a0b1;
-	case 0xa0b2:
-	case 0xe0b2:
-		goto ____runtimeloc_a0b2;
-	case 0xa0b4:
-	case 0xe0b4:
-		goto ____runtimeloc_a0b4;
-	case 0xa0e4:
-	case 0xe0e4:
-		goto ____runtimeloc_a0e4;
-	case 0xa0e5:
-	case 0xe0e5:
-		goto ____runtimeloc_a0e5;
-	case 0xa0e6:
-	case 0xe0e6:
-		goto ____runtimeloc_a0e6;
-	case 0xa0e7:
-	case 0xe0e7:
-		goto ____runtimeloc_a0e7;
-	case 0xa0e9:
-	case 0xe0e9:
-		goto ____runtimeloc_a0e9;
-	case 0xa0ea:
-	case 0xe0ea:
-		goto ____runtimeloc_a0ea;
-	case 0xa0ec:
-	case 0xe0ec:
-		goto ____runtimeloc_a0ec;
-	case 0xa0ef:
-	case 0xe0ef:
-		goto ____runtimeloc_a0ef;
-	case 0xa0f1:
-	case 0xe0f1:
-		goto ____runtimeloc_a0f1;
-	case 0xa0f4:
-	case 0xe0f4:
-		goto ____runtimeloc_a0f4;
-	case 0xa0f6:
-	case 0xe0f6:
-		goto ____runtimeloc_a0f6;
-	case 0xa0f9:
-	case 0xe0f9:
-		goto ____runtimeloc_a0f9;
-	case 0xa0fb:
-	case 0xe0fb:
-		goto ____runtimeloc_a0fb;
-	case 0xa0fd:
-	case 0xe0fd:
-		goto ____runtimeloc_a0fd;
-	case 0xa0ff:
-	case 0xe0ff:
-		goto ____runtimeloc_a0ff;
-	case 0xa101:
-	case 0xe101:
-		goto ____runtimeloc_a101;
-	case 0xa102:
-	case 0xe102:
-		goto ____runtimeloc_a102;
-	case 0xa104:
-	case 0xe104:
-		goto ____runtimeloc_a104;
-	case 0xa16a:
-	case 0xe16a:
-		goto ____runtimeloc_a16a;
-	case 0xa16c:
-	case 0xe16c:
-		goto ____runtimeloc_a16c;
-	case 0xa16e:
-	case 0xe16e:
-		goto ____runtimeloc_a16e;
-	case 0xa070:
-	case 0xe070:
-		goto ____runtimeloc_a070;
-	case 0xa071:
-	case 0xe071:
-		goto ____runtimeloc_a071;
-	case 0xa073:
-	case 0xe073:
-		goto ____runtimeloc_a073;
-	case 0xa075:
-	case 0xe075:
-		goto ____runtimeloc_a075;
-	case 0xa132:
-	case 0xe132:
-		goto ____runtimeloc_a132;
-	case 0xa133:
-	case 0xe133:
-		goto ____runtimeloc_a133;
-	case 0xa135:
-	case 0xe135:
-		goto ____runtimeloc_a135;
-	case 0xa035:
-	case 0xe035:
-		goto ____runtimeloc_a035;
-	case 0xa036:
-	case 0xe036:
-		goto ____runtimeloc_a036;
-	case 0xa038:
-	case 0xe038:
-		goto ____runtimeloc_a038;
-	case 0xa039:
-	case 0xe039:
-		goto ____runtimeloc_a039;
-	case 0xa03b:
-	case 0xe03b:
-		goto ____runtimeloc_a03b;
-	case 0xa03d:
-	case 0xe03d:
-		goto ____runtimeloc_a03d;
-	case 0xa040:
-	case 0xe040:
-		goto ____runtimeloc_a040;
-	case 0xa0b8:
-	case 0xe0b8:
-		goto ____runtimeloc_a0b8;
-	case 0xa0bb:
-	case 0xe0bb:
-		goto ____runtimeloc_a0bb;
-	case 0xa0bd:
-	case 0xe0bd:
-		goto ____runtimeloc_a0bd;
-	case 0xa0bf:
-	case 0xe0bf:
-		goto ____runtimeloc_a0bf;
-	case 0xa0c2:
-	case 0xe0c2:
-		goto ____runtimeloc_a0c2;
-	case 0xa0c4:
-	case 0xe0c4:
-		goto ____runtimeloc_a0c4;
-	case 0xa0c7:
-	case 0xe0c7:
-		goto ____runtimeloc_a0c7;
-	case 0xa0c9:
-	case 0xe0c9:
-		goto ____runtimeloc_a0c9;
-	case 0xa0cb:
-	case 0xe0cb:
-		goto ____runtimeloc_a0cb;
-	case 0xa0ce:
-	case 0xe0ce:
-		goto ____runtimeloc_a0ce;
-	case 0xa0d0:
-	case 0xe0d0:
-		goto ____runtimeloc_a0d0;
-	case 0xa0d2:
-	case 0xe0d2:
-		goto ____runtimeloc_a0d2;
-	case 0xa0d4:
-	case 0xe0d4:
-		goto ____runtimeloc_a0d4;
-	case 0xa0d5:
-	case 0xe0d5:
-		goto ____runtimeloc_a0d5;
-	case 0xa0d7:
-	case 0xe0d7:
-		goto ____runtimeloc_a0d7;
-	case 0xa0d9:
-	case 0xe0d9:
-		goto ____runtimeloc_a0d9;
-	case 0xa07a:
-	case 0xe07a:
-		goto ____runtimeloc_a07a;
-	case 0xa07d:
-	case 0xe07d:
-		goto ____runtimeloc_a07d;
-	case 0xa07e:
-	case 0xe07e:
-		goto ____runtimeloc_a07e;
-	case 0xa07f:
-	case 0xe07f:
-		goto ____runtimeloc_a07f;
-	case 0xa081:
-	case 0xe081:
-		goto ____runtimeloc_a081;
-	case 0xa083:
-	case 0xe083:
-		goto ____runtimeloc_a083;
-	case 0xa085:
-	case 0xe085:
-		goto ____runtimeloc_a085;
-	case 0xa087:
-	case 0xe087:
-		goto ____runtimeloc_a087;
-	case 0xa089:
-	case 0xe089:
-		goto ____runtimeloc_a089;
-	case 0xa08b:
-	case 0xe08b:
-		goto ____runtimeloc_a08b;
-	case 0xa08d:
-	case 0xe08d:
-		goto ____runtimeloc_a08d;
-	case 0xa08f:
-	case 0xe08f:
-		goto ____runtimeloc_a08f;
-	case 0xa092:
-	case 0xe092:
-		goto ____runtimeloc_a092;
-	case 0xa094:
-	case 0xe094:
-		goto ____runtimeloc_a094;
-	default:
-		error("Attempted to jump to an non-executable location 0x%04x. This location may have been calculated at runtime and not supported by the compiler, the ROM may be faulty, or improper emulation of some component has caused undesirable runtime effects.", jumpAddress);
-
     }
+#endif
+    JumpDefault:
+        GAME_SPILL_REGISTERS(); return interpreter_execute(jumpAddress);
+#if GAME_USE_COMPUTED_GOTO
+    ____delegate_a441:
+        GAME_SPILL_REGISTERS(); return game_function_a441(jumpAddress);
+#endif
+}
+
+/*
+ * Subroutine at 0xa441.
+ * Reads A, X; writes A, X, C, Z, V, N; preserves Y.
+ */
+static BOOL game_function_a441(USHORT jumpAddress)
+{
+    BYTE A = registers.A, X = registers.X, Y = registers.Y, SP = registers.SP;
+	BOOL loopTaken_a44a;
+	if(jumpAddress != ID_FUNCTION_a441)
+		goto Jump;
+
+	stack[SP--] = A; // Push Accumulator on Stack
+	sync(3);
+	A = X; // Transfer Index X to Accumulator
+	sync(2);
+	stack[SP--] = A; // Push Accumulator on Stack
+	sync(3);
+	A = 0x0; GAME_SET_FLAGS(0x82, 0x2); // Load Accumulator with Memory
+	sync(2);
+	cpu_write8(0xfe, 0x0); // Store Accumulator in Memory
+	sync(3);
+	X = 0x8; GAME_SET_FLAGS(0x82, 0x0); // Load Index X with Memory
+	sync(2);
+LOCATION_a44a:
+	do // Loop (2 code sections)
+	{
+	cpu_write8(0xfc, ShiftRight(cpu_read8(0xfc))); // Shift Right One Bit (Memory or Accumulator)
+	sync(5);
+	if(!cpu_get_flag(CPU_FLAG_CARRY)) { sync(3); goto LOCATION_a451; } // Branch on Carry Clear
+	sync(2);
+	ClearCarryFlag(); // Clear Carry Flag
+	sync(2);
+	A = MOSInstr_AddWithCarry(A, cpu_read8(0xfd)); // Add Memory to Accumulator with Carry
+	sync(3);
+LOCATION_a451:
+	A = RotateRight(A); // Rotate One Bit Right (Memory or Accumulator)
+	sync(2);
+	cpu_write8(0xfe, RotateRight(cpu_read8(0xfe))); // Rotate One Bit Right (Memory or Accumulator)
+	sync(5);
+	X = Decrement(X); // Decrement Index X by One
+	sync(2);
+	loopTaken_a44a = !cpu_get_flag(CPU_FLAG_ZERO); // Branch on Result not Zero (loop)
+	sync(loopTaken_a44a ? 3 : 2);
+	} while(loopTaken_a44a);
+	cpu_write8(0xff, A); // Store Accumulator in Memory
+	sync(3);
+	A = MOSInstr_Load(stack[++SP]); // Pull Accumulator from Stack
+	sync(4);
+	X = A; // Transfer Accumulator to Index X
+	sync(2);
+	A = MOSInstr_Load(stack[++SP]); // Pull Accumulator from Stack
+	sync(4);
+	sync(6); GAME_SPILL_REGISTERS(); return FALSE; // Return from Subroutine
 
+    // Jump table for locations in this subroutine. Anything else is executed by game_execute().
+    Jump:
+#if GAME_USE_COMPUTED_GOTO
+    {
+        static const INT jumpTable[0x8] =
+        {
+            [0x0] = &&LOCATION_a44a - &&JumpDefault,
+            [0x7] = &&LOCATION_a451 - &&JumpDefault,
+        };
+        if((USHORT)(jumpAddress - 0xa44a) < 0x8)
+            goto *(&&JumpDefault + jumpTable[(USHORT)(jumpAddress - 0xa44a)]);
+    }
+#else
+    switch(jumpAddress)
+    {
+	case ID_LOCATION_a451:
+		goto LOCATION_a451;
+	case ID_LOCATION_a44a:
+		goto LOCATION_a44a;
+    }
+#endif
+    JumpDefault:
+        GAME_SPILL_REGISTERS(); return game_execute(jumpAddress);
 
-    return FALSE;
+    GAME_SPILL_REGISTERS(); return FALSE;
 }
 
 // ---------------------------------
@@ -1276,13 +707,289 @@ enum MIRRORINGTYPE mirroringType = VERTICAL;
  */
 struct TLBEntry gameTLB[] =
 {
-	{  0x8000, 0xc000, prgRomData },
-	{  0xc000, 0x10000, prgRomData },
+	{  0x8000, 0xc000, (BYTE*)prgRomData },
+	{  0xc000, 0x10000, (BYTE*)prgRomData },
 
 };
 UINT gameTLBSize = sizeof(gameTLB) / sizeof(struct TLBEntry);
+BOOL gameUsesReturnStack = FALSE; // JSRs push their return address and RTSs dispatch to it (the interpreter does the same).
+
+/*
+ * Entry Map
+ * One bit per PRG-ROM address (from 0x8000), set if game_execute() has a label for it. The interpreter returns to compiled code at these.
+ */
+BYTE gameEntryMap[] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x05, 0x00, 0x00, 0x08, 0x00, 0x00, 0x04, 0x00, 0x02, 0x02, 0x40, 0x00, 0x00, 0x20, 0x80, 0x00, 
+	0x00, 0x00, 0x80, 0x00, 0x02, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x10, 0x08, 0x00, 0x00, 0x00, 
+	0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x81, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x04, 0x02, 0x20, 0x00, 0x02, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x05, 0x00, 0x00, 0x08, 0x00, 0x00, 0x04, 0x00, 0x02, 0x02, 0x40, 0x00, 0x00, 0x20, 0x80, 0x00, 
+	0x00, 0x00, 0x80, 0x00, 0x02, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x10, 0x08, 0x00, 0x00, 0x00, 
+	0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x81, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x04, 0x02, 0x20, 0x00, 0x02, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
 
-BYTE prgRomData[] = {
+/*
+ * Recognized loop idioms
+ * Counted store/copy loops which can be executed in bulk, indexed by the idiom() calls at their starting location.
+ */
+struct IDIOMLOOP gameIdiomLoops[] =
+{
+	{ IDIOM_FILL, IDIOM_INDEX_Y, TRUE, FALSE, 0x0, { IDIOM_OPERAND_NONE, 0x0 }, { IDIOM_OPERAND_INDIRECT, 0x0 }, 11 }, // 0xa01b: STA ($0),Y / DEY / BNE
+	{ IDIOM_FILL, IDIOM_INDEX_X, TRUE, FALSE, 0x0, { IDIOM_OPERAND_NONE, 0x0 }, { IDIOM_OPERAND_PPUDATA, 0x0 }, 9 }, // 0xa032: STA $2007 / DEX / BNE
+	{ IDIOM_COPY, IDIOM_INDEX_X, FALSE, TRUE, 0xc0, { IDIOM_OPERAND_ABSOLUTE, 0xe171 }, { IDIOM_OPERAND_ABSOLUTE, 0x600 }, 16 }, // 0xa049: LDA $e171,X / STA $600,X / INX / CPX #$c0 / BNE
+	{ IDIOM_COPY, IDIOM_INDEX_X, FALSE, FALSE, 0x0, { IDIOM_OPERAND_ABSOLUTE, 0xe231 }, { IDIOM_OPERAND_ABSOLUTE, 0x700 }, 14 }, // 0xa056: LDA $e231,X / STA $700,X / INX / BNE
+};
+
+const BYTE prgRomData[] = {
 	0xd8, 0x78, 0xad, 0x02, 0x20, 0x10, 0xfb, 0xa2, 0x00, 0x8e, 0x00, 0x20, 0x8e, 0x01, 0x20, 0xca, 
 	0x9a, 0xa0, 0x06, 0x84, 0x01, 0xa0, 0x00, 0x84, 0x00, 0xa9, 0x00, 0x91, 0x00, 0x88, 0xd0, 0xfb, 
 	0xc6, 0x01, 0x10, 0xf7, 0xa9, 0x20, 0x8d, 0x06, 0x20, 0xa9, 0x00, 0x8d, 0x06, 0x20, 0xa2, 0x00, 
@@ -2308,9 +2015,10 @@ BYTE prgRomData[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5d, 0xe4, 0x00, 0xe0, 0x69, 0xe4
 };
-
-UINT prgRomDataSize = sizeof(prgRomData);
-BYTE chrRom[] = {
+UINT prgRomDataSize = 0x4000;
+const BYTE* prgRomCode = prgRomData;
+UINT prgRomCodeSize = 0x4000;
+const BYTE chrRom[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x3c, 0x7e, 0xff, 0xff, 0xff, 0xff, 0x7e, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3c, 0x7e, 0xff, 0xff, 0xff, 0xff, 0x7e, 0x3c, 
@@ -2824,6 +2532,6 @@ BYTE chrRom[] = {
 	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
-UINT chrRomSize = sizeof(chrRom);
+UINT chrRomSize = 0x2000;
 
 #endif
\ No newline at end of file
@@ -5,6 +5,11 @@
 #include "memory.h"
 #include "instructions.h"
 #include "ppu.h"
+#include "idioms.h"
+#include "hle.h"
+#include "memo.h"
+#include "interpreter.h"
+#include "profile.h"
 
 // ---------------------------------
 // Objects/Structures
@@ -12,85 +17,128 @@
 enum MIRRORINGTYPE mirroringType;
 extern struct TLBEntry gameTLB[];
 UINT gameTLBSize;
+extern BYTE gameEntryMap[];
+extern struct IDIOMLOOP gameIdiomLoops[];
+extern struct HLEROUTINE gameKnownRoutines[];
+extern struct MEMOSUBROUTINE gameMemoSubroutines[];
+BOOL gameUsesReturnStack;
 
 // ---------------------------------
 // Function IDs (used for interrupt/JSR locations).
 // ---------------------------------
+#define ID_FUNCTION_NMI               0xa45d
 #define ID_FUNCTION_RESET             0xa000
-#define ID_LOCATION_a041              0xa041
 #define ID_LOCATION_a002              0xa002
-#define ID_LOCATION_a106              0xa106
-#define ID_LOCATION_a441              0xa441
+#define ID_LOCATION_a01b              0xa01b
+#define ID_LOCATION_a032              0xa032
+#define ID_LOCATION_a041              0xa041
 #define ID_LOCATION_a049              0xa049
-#define ID_LOCATION_a44a              0xa44a
-#define ID_LOCATION_a137              0xa137
-#define ID_LOCATION_a14c              0xa14c
-#define ID_LOCATION_a451              0xa451
 #define ID_LOCATION_a056              0xa056
+#define ID_LOCATION_a06d              0xa06d
+#define ID_LOCATION_a077              0xa077
 #define ID_LOCATION_a097              0xa097
-#define ID_LOCATION_a01b              0xa01b
+#define ID_LOCATION_a0b6              0xa0b6
+#define ID_FUNCTION_a441              0xa441
+#define ID_LOCATION_a451              0xa451
+#define ID_LOCATION_a44a              0xa44a
 #define ID_LOCATION_a0dc              0xa0dc
-#define ID_FUNCTION_NMI               0xa45d
+#define ID_LOCATION_a106              0xa106
+#define ID_LOCATION_a130              0xa130
+#define ID_LOCATION_a14a              0xa14a
+#define ID_LOCATION_a169              0xa169
+#define ID_LOCATION_a14c              0xa14c
 #define ID_LOCATION_a0a1              0xa0a1
+#define ID_LOCATION_a137              0xa137
 #define ID_LOCATION_a0e3              0xa0e3
-#define ID_LOCATION_a169              0xa169
-#define ID_LOCATION_a06d              0xa06d
-#define ID_LOCATION_a130              0xa130
-#define ID_LOCATION_a032              0xa032
 #define ID_FUNCTION_IRQ               0xa469
-#define ID_LOCATION_a0b6              0xa0b6
-#define ID_LOCATION_a077              0xa077
-#define ID_LOCATION_a14a              0xa14a
 
         
 // ---------------------------------
 // Function Mappings
 // ---------------------------------
-#define RequestBRK                    MOSInstr_BRK
-#define OrA                           MOSInstr_ORA
-#define ShiftLeft                     MOSInstr_ASL
-#define PushFlags                     MOSInstr_PHP
-#define ClearCarryFlag                MOSInstr_CLC
+#define AddToA                        MOSInstr_ADC
 #define AndA                          MOSInstr_AND
+#define ShiftLeft                     MOSInstr_ASL
 #define TEST                          MOSInstr_BIT
-#define RotateLeft                    MOSInstr_ROL
-#define PopFlags                      MOSInstr_PLP
-#define SetCarryFlag                  MOSInstr_SEC
+#define RequestBRK                    MOSInstr_BRK
+#define ClearCarryFlag                MOSInstr_CLC
+#define ClearDecimalFlag              MOSInstr_CLD
+#define ClearInterruptDisableFlag     MOSInstr_CLI
+#define ClearOverflowFlag             MOSInstr_CLV
+#define CompareWithA                  MOSInstr_CMP
+#define CompareWithX                  MOSInstr_CPX
+#define CompareWithY                  MOSInstr_CPY
+#define Decrement                     MOSInstr_DEC
+#define DecrementX                    MOSInstr_DEX
+#define DecrementY                    MOSInstr_DEY
 #define XORWithA                      MOSInstr_EOR
+#define Increment                     MOSInstr_INC
+#define IncrementX                    MOSInstr_INX
+#define IncrementY                    MOSInstr_INY
+#define SetA                          MOSInstr_LDA
+#define SetX                          MOSInstr_LDX
+#define SetY                          MOSInstr_LDY
 #define ShiftRight                    MOSInstr_LSR
+#define OrA                           MOSInstr_ORA
 #define PushA                         MOSInstr_PHA
-#define ClearInterruptDisableFlag     MOSInstr_CLI
-#define AddToA                        MOSInstr_ADC
-#define RotateRight                   MOSInstr_ROR
+#define PushFlags                     MOSInstr_PHP
 #define PopA                          MOSInstr_PLA
+#define PopFlags                      MOSInstr_PLP
+#define RotateLeft                    MOSInstr_ROL
+#define RotateRight                   MOSInstr_ROR
+#define SubtractFromA                 MOSInstr_SBC
+#define SetCarryFlag                  MOSInstr_SEC
+#define SetDecimalFlag                MOSInstr_SED
 #define SetInterruptDisableFlag       MOSInstr_SEI
 #define StoreA                        MOSInstr_STA
-#define StoreY                        MOSInstr_STY
 #define StoreX                        MOSInstr_STX
-#define DecrementY                    MOSInstr_DEY
-#define MoveXToA                      MOSInstr_TXA
-#define MoveYToA                      MOSInstr_TYA
-#define MoveXToSP                     MOSInstr_TXS
-#define SetY                          MOSInstr_LDY
-#define SetA                          MOSInstr_LDA
-#define SetX                          MOSInstr_LDX
-#define MoveAToY                      MOSInstr_TAY
+#define StoreY                        MOSInstr_STY
 #define MoveAToX                      MOSInstr_TAX
-#define ClearOverflowFlag             MOSInstr_CLV
+#define MoveAToY                      MOSInstr_TAY
 #define MoveSPToX                     MOSInstr_TSX
-#define CompareWithY                  MOSInstr_CPY
-#define CompareWithA                  MOSInstr_CMP
-#define Decrement                     MOSInstr_DEC
-#define IncrementY                    MOSInstr_INY
-#define DecrementX                    MOSInstr_DEX
-#define ClearDecimalFlag              MOSInstr_CLD
-#define CompareWithX                  MOSInstr_CPX
-#define SubtractFromA                 MOSInstr_SBC
-#define Increment                     MOSInstr_INC
-#define IncrementX                    MOSInstr_INX
-#define SetDecimalFlag                MOSInstr_SED
+#define MoveXToA                      MOSInstr_TXA
+#define MoveXToSP                     MOSInstr_TXS
+#define MoveYToA                      MOSInstr_TYA
+
+// Registers are kept in local variables (A, X, Y, SP) by each function, and only stored back to the registers structure (spilled)
+// where code outside of the function can observe them: interrupts, calls, returns, loop idioms, known routines and memoization. They're loaded again afterwards.
+#define GAME_SPILL_REGISTERS()    { registers.A = A; registers.X = X; registers.Y = Y; registers.SP = SP; }
+#define GAME_LOAD_REGISTERS()     { A = registers.A; X = registers.X; Y = registers.Y; SP = registers.SP; }
+#define sync(interval)            if(cpu_sync_hardware(interval)) { GAME_SPILL_REGISTERS(); if(cpu_sync_interrupts()) { return TRUE; } GAME_LOAD_REGISTERS(); }
+#define idiom(loop, exitLabel)    { GAME_SPILL_REGISTERS(); UINT idiomCycles = idiom_execute_loop(loop); if(idiomCycles != 0) { GAME_LOAD_REGISTERS(); sync(idiomCycles); goto exitLabel; } }
+#define hle(routine, exitLabel)   { GAME_SPILL_REGISTERS(); UINT hleCycles = hle_execute_routine(routine); if(hleCycles != 0) { GAME_LOAD_REGISTERS(); sync(hleCycles); goto exitLabel; } }
+#define memoize(subroutine)       { GAME_SPILL_REGISTERS(); UINT memoCycles = memo_lookup(subroutine); if(memoCycles != 0) { GAME_LOAD_REGISTERS(); sync(memoCycles); return FALSE; } }
+
+// Sets the processor status flags in the mask to the given values, for instructions whose results constant propagation determined.
+#define GAME_SET_FLAGS(mask, flags)  registers.P = (registers.P & ~(mask)) | (flags)
+
+// Jump tables are dense arrays of label addresses where the compiler supports them (GCC/Clang), switches otherwise.
+#ifndef GAME_USE_COMPUTED_GOTO
+#ifdef __GNUC__
+#define GAME_USE_COMPUTED_GOTO    TRUE
+#else
+#define GAME_USE_COMPUTED_GOTO    FALSE
+#endif
+#endif
+
+// Hints from an execution profile (branches which almost always go one way, code which wasn't executed), where the compiler supports them.
+#ifdef __GNUC__
+#define GAME_LIKELY(condition)    __builtin_expect(!!(condition), 1)
+#define GAME_UNLIKELY(condition)  __builtin_expect(!!(condition), 0)
+#define GAME_COLD                 __attribute__((cold))
+#else
+#define GAME_LIKELY(condition)    (condition)
+#define GAME_UNLIKELY(condition)  (condition)
+#define GAME_COLD
+#endif
+#if defined(__GNUC__) && !defined(__clang__)
+#define GAME_COLD_LABEL           __attribute__((cold, unused))
+#else
+#define GAME_COLD_LABEL
+#endif
 
-#define sync(interval)            if(cpu_sync(interval)) { return TRUE; }
+// Records an execution profile (written on exit) if the game was generated with -g.
+#define GAME_PROFILING            FALSE
 
 // ---------------------------------
 // Functions
@@ -100,9 +148,11 @@ BOOL game_execute(USHORT jumpAddress);
 // ---------------------------------
 // Data
 // ---------------------------------
-extern BYTE prgRomData[];
+extern const BYTE prgRomData[];
 UINT prgRomDataSize;
-extern BYTE chrRom[];
+extern const BYTE* prgRomCode;
+UINT prgRomCodeSize;
+extern const BYTE chrRom[];
 UINT chrRomSize;
 
 #endif /* GAME_H_ */
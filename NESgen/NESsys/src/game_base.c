@@ -40,7 +40,12 @@ struct TLBEntry gameTLB[] =
 		{0,0,0} // dummy so certain compilers don't complain about this template.
 };
 UINT gameTLBSize = sizeof(gameTLB) / sizeof(struct TLBEntry);
+BYTE gameEntryMap[0x1000] = { 0 };
+BOOL gameUsesReturnStack = FALSE;
 
-BYTE chrRom[] = { };
+const BYTE prgRomCodeData[0x4000] = { 0 };
+const BYTE* prgRomCode = prgRomCodeData;
+UINT prgRomCodeSize = sizeof(prgRomCodeData);
+const BYTE chrRom[] = { };
 UINT chrRomSize = sizeof(chrRom);
 #endif
@@ -13,6 +13,8 @@
 enum MIRRORINGTYPE mirroringType;
 extern struct TLBEntry gameTLB[];
 UINT gameTLBSize;
+extern BYTE gameEntryMap[];
+BOOL gameUsesReturnStack;
 
 // ---------------------------------
 // Function IDs (used for interrupt/JSR locations).
@@ -26,15 +28,39 @@ UINT gameTLBSize;
 // Functions
 // ---------------------------------
 #define SYNC(interval)            if(cpu_sync(interval)) { return TRUE; }
+#define GAME_PROFILING            FALSE
 BOOL game_execute(USHORT jumpAddress);
 
 // ---------------------------------
 // Data
 // ---------------------------------
-extern BYTE prgRomData[];
+extern const BYTE prgRomData[];
 UINT prgRomDataSize;
-extern BYTE chrRom[];
+extern const BYTE* prgRomCode;
+UINT prgRomCodeSize;
+extern const BYTE chrRom[];
 UINT chrRomSize;
+#elif APPLICATION_MULTIPLE_GAMES
+#include "games.h"
+
+// ---------------------------------
+// Selected Game
+// ---------------------------------
+// Every game linked in has its symbols prefixed (NESgen.py -G), the runtime uses the one selected (games_select()) through its descriptor.
+#define mirroringType				(selectedGame->mirroringType)
+#define gameTLB						(selectedGame->tlb)
+#define gameTLBSize					(selectedGame->tlbSize)
+#define gameEntryMap				(selectedGame->entryMap)
+#define gameUsesReturnStack			(selectedGame->usesReturnStack)
+#define ID_FUNCTION_RESET			(selectedGame->resetFunctionID)
+#define ID_FUNCTION_NMI				(selectedGame->nmiFunctionID)
+#define ID_FUNCTION_IRQ				(selectedGame->irqFunctionID)
+#define GAME_PROFILING				(selectedGame->profiling)
+#define game_execute(jumpAddress)	(selectedGame->execute(jumpAddress))
+#define prgRomCode					(selectedGame->prgRomCode)
+#define prgRomCodeSize				(selectedGame->prgRomCodeSize)
+#define chrRom						(selectedGame->chrRom)
+#define chrRomSize					(selectedGame->chrRomSize)
 #else
 #include "game.h"
 #endif
@@ -0,0 +1,50 @@
+#include "NESsys.h"
+#include "memo.h"
+#include "games.h"
+
+#if APPLICATION_MULTIPLE_GAMES
+/*
+ * NOTES:
+ * -Every game in the list is linked in. Its symbols are prefixed with its name, so only its descriptor (<name>_game) is referenced here.
+ * -The runtime reads the selected game's code, data and settings through its descriptor (see game_base.h), so one game runs at a time.
+ */
+#define GAME_REGISTER(name)		extern struct GAMEDESCRIPTOR name##_game;
+#include GAMES_LIST_PATH
+#undef GAME_REGISTER
+
+#define GAME_REGISTER(name)		&name##_game,
+struct GAMEDESCRIPTOR* games[] =
+{
+#include GAMES_LIST_PATH
+	NULL
+};
+#undef GAME_REGISTER
+
+/*
+ * Selects the game with the given name to run (or the first game registered, if no name is given).
+ * Returns a boolean indicating if the game was found.
+ */
+BOOL games_select(const char* name)
+{
+	for(UINT i = 0; games[i] != NULL; i++)
+	{
+		if(name != NULL && strcmp(games[i]->name, name) != 0)
+			continue;
+		selectedGame = games[i];
+		memoSubroutines = selectedGame->memoSubroutines;
+		memoSubroutineCount = selectedGame->memoSubroutineCount;
+		return TRUE;
+	}
+	return FALSE;
+}
+/*
+ * Prints the names of the games registered.
+ */
+void games_print()
+{
+	console_log("Games:");
+	for(UINT i = 0; games[i] != NULL; i++)
+		console_log(" %s", games[i]->name);
+	console_log("\n");
+}
+#endif
@@ -0,0 +1,47 @@
+
+#ifndef GAMES_H_
+#define GAMES_H_
+#include "NESsys.h"
+#include "memory.h"
+#include "ppu.h"
+#include "memo.h"
+
+// ---------------------------------
+// Game Registration
+// ---------------------------------
+/*
+ * Describes a game generated with a symbol prefix (NESgen.py -G <name>), so NESsys builds containing multiple games
+ * (APPLICATION_MULTIPLE_GAMES) can select it by name at runtime. Games are registered by the list NESgen writes next to their headers.
+ */
+struct GAMEDESCRIPTOR
+{
+	const char* name;
+	BOOL (*execute)(USHORT jumpAddress);
+	USHORT resetFunctionID;
+	USHORT nmiFunctionID;
+	USHORT irqFunctionID;
+	enum MIRRORINGTYPE mirroringType;
+	struct TLBEntry* tlb;
+	UINT tlbSize;
+	BYTE* entryMap;
+	BOOL usesReturnStack;
+	struct MEMOSUBROUTINE* memoSubroutines;
+	UINT memoSubroutineCount;
+	BOOL profiling;
+	const BYTE* prgRomCode;
+	UINT prgRomCodeSize;
+	const BYTE* chrRom;
+	UINT chrRomSize;
+};
+#define GAMES_LIST_PATH			"games_list.h" // GAME_REGISTER(name) for every game generated with -G into the directory.
+
+// The game selected to run (APPLICATION_MULTIPLE_GAMES).
+struct GAMEDESCRIPTOR* selectedGame;
+
+// ---------------------------------
+// Functions
+// ---------------------------------
+BOOL games_select(const char* name);
+void games_print();
+
+#endif /* GAMES_H_ */
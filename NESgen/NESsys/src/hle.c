@@ -0,0 +1,243 @@
+#include "NESsys.h"
+#include "cpu.h"
+#include "memory.h"
+#include "hle.h"
+
+/*
+ * NOTES:
+ * -Known routines are recognized by the compiler, which emits a call to execute the routine natively at its start, continuing at its RTS.
+ * -Each routine leaves memory, registers and flags exactly as its instructions would (for whatever its variables hold), and returns the cycles
+ *  they would have taken. It only accesses zero page, so the only reason it can't execute natively is an interrupt occurring during it,
+ *  in which case zero cycles are returned and it executes instruction by instruction instead.
+ */
+
+/*
+ * Obtains the amount of times a loop counted down from the given value iterates (DEX / BNE).
+ */
+UINT hle_get_iterations(BYTE count)
+{
+	return count == 0 ? 0x100 : count;
+}
+/*
+ * Obtains the most cycles the given routine can take (whichever way its branches go).
+ */
+UINT hle_get_max_cycles(const struct HLEROUTINE* routine)
+{
+	switch(routine->type)
+	{
+		case HLE_MULTIPLY:
+			return 9 + (hle_get_iterations(routine->operands[0]) * 19) - 1;
+		case HLE_DIVIDE:
+			return 4 + (hle_get_iterations(routine->operands[0]) * 30) - 1;
+		case HLE_DECIMAL:
+			return 23 + ((2 + 9) * 11); // (at most two hundreds, then nine tens)
+		case HLE_LFSR:
+			return 5 + (hle_get_iterations(routine->operands[0]) * 16) - 1 + 5;
+	}
+	return 0;
+}
+/*
+ * Shift and add multiplication (factor * multiplicand, the high byte in A and the low byte in factor).
+ */
+UINT hle_multiply(BYTE count, BYTE factor, BYTE multiplicand)
+{
+	// LDA #0 / LDX #count / LSR factor
+	BYTE a = 0;
+	BYTE x = count;
+	BOOL carry = zeroPage[factor] & 0x01;
+	zeroPage[factor] >>= 1;
+	UINT cycles = 2 + 2 + 5;
+	do
+	{
+		// BCC skip / CLC / ADC multiplicand
+		if(carry)
+		{
+			BYTE value = zeroPage[multiplicand];
+			USHORT result = a + value;
+			cpu_set_flag(CPU_FLAG_OVERFLOW, ~(a ^ value) & 0x80 & (a ^ result));
+			carry = result > 0xFF;
+			a = (BYTE)result;
+			cycles += 2 + 2 + 3;
+		}
+		else
+			cycles += 3;
+
+		// ROR A / ROR factor / DEX / BNE loop
+		BOOL shiftedOut = a & 0x01;
+		a = (a >> 1) | (carry << 7);
+		carry = zeroPage[factor] & 0x01;
+		zeroPage[factor] = (zeroPage[factor] >> 1) | (shiftedOut << 7);
+		x--;
+		cycles += 2 + 5 + 2 + 3;
+	}while(x != 0);
+
+	registers.A = a;
+	registers.X = x;
+	cpu_set_flag(CPU_FLAG_CARRY, carry);
+	cpu_set_flag(CPU_FLAG_ZERO, TRUE);
+	cpu_set_flag(CPU_FLAG_SIGN, FALSE);
+	return cycles - 1; // the final branch is not taken.
+}
+/*
+ * Shift and subtract division ((high:low) / divisor, the quotient in high:low and the remainder in A).
+ */
+UINT hle_divide(BYTE count, BYTE low, BYTE high, BYTE divisor)
+{
+	// LDA #0 / LDX #count
+	BYTE a = 0;
+	BYTE x = count;
+	BOOL carry;
+	UINT cycles = 2 + 2;
+	do
+	{
+		// ASL low / ROL high / ROL A / CMP divisor
+		BOOL shiftedOut = zeroPage[low] >> 7;
+		zeroPage[low] <<= 1;
+		carry = zeroPage[high] >> 7;
+		zeroPage[high] = (zeroPage[high] << 1) | shiftedOut;
+		a = (a << 1) | carry;
+		BYTE value = zeroPage[divisor];
+		carry = a >= value;
+		cycles += 5 + 5 + 2 + 3;
+
+		// BCC skip / SBC divisor / INC low (the carry is set, so nothing is borrowed)
+		if(carry)
+		{
+			BYTE result = a - value;
+			cpu_set_flag(CPU_FLAG_OVERFLOW, (a ^ value) & 0x80 & (a ^ result));
+			a = result;
+			zeroPage[low]++;
+			cycles += 2 + 3 + 5;
+		}
+		else
+			cycles += 3;
+
+		// DEX / BNE loop
+		x--;
+		cycles += 2 + 3;
+	}while(x != 0);
+
+	registers.A = a;
+	registers.X = x;
+	cpu_set_flag(CPU_FLAG_CARRY, carry);
+	cpu_set_flag(CPU_FLAG_ZERO, TRUE);
+	cpu_set_flag(CPU_FLAG_SIGN, FALSE);
+	return cycles - 1; // the final branch is not taken.
+}
+/*
+ * Counts how many times the given value can be subtracted from A (CMP #value / BCC / SBC #value / INY / BNE), into Y.
+ * Returns the cycles taken, leaving the carry, zero and sign flags of the last comparison (or SBC and INY, if Y wrapped around).
+ */
+UINT hle_decimal_digit(BYTE* a, BYTE* y, BYTE value, BOOL* carry, BOOL* zero, BOOL* sign)
+{
+	UINT cycles = 0;
+	while(TRUE)
+	{
+		// CMP #value / BCC
+		*carry = *a >= value;
+		*zero = *a == value;
+		*sign = (BYTE)(*a - value) >> 7;
+		if(!*carry)
+			return cycles + 2 + 3;
+
+		// SBC #value / INY / BNE (the carry is set, so nothing is borrowed, and it stays set)
+		BYTE result = *a - value;
+		cpu_set_flag(CPU_FLAG_OVERFLOW, (*a ^ value) & 0x80 & (*a ^ result));
+		*a = result;
+		(*y)++;
+		*zero = *y == 0;
+		*sign = *y >> 7;
+		if(*y == 0)
+			return cycles + 2 + 2 + 2 + 2 + 2;
+		cycles += 2 + 2 + 2 + 2 + 3;
+	}
+}
+/*
+ * Decimal conversion by repeated subtraction (A into hundreds, tens and ones digits).
+ */
+UINT hle_decimal(BYTE hundreds, BYTE tens, BYTE ones)
+{
+	// LDY #0 / (hundreds) / STY hundreds / LDY #0 / (tens) / STY tens / STA ones
+	BYTE a = registers.A;
+	BYTE y = 0;
+	BOOL carry, zero, sign;
+	UINT cycles = 2;
+	cycles += hle_decimal_digit(&a, &y, 100, &carry, &zero, &sign);
+	zeroPage[hundreds] = y;
+	y = 0;
+	cycles += 3 + 2;
+	cycles += hle_decimal_digit(&a, &y, 10, &carry, &zero, &sign);
+	zeroPage[tens] = y;
+	zeroPage[ones] = a;
+	cycles += 3 + 3;
+
+	registers.A = a;
+	registers.Y = y;
+	cpu_set_flag(CPU_FLAG_CARRY, carry);
+	cpu_set_flag(CPU_FLAG_ZERO, zero);
+	cpu_set_flag(CPU_FLAG_SIGN, sign);
+	return cycles;
+}
+/*
+ * Galois linear feedback shift register (seedHigh:seedLow shifted count times, with the feedback applied for every bit shifted out).
+ */
+UINT hle_lfsr(BYTE count, BYTE seedLow, BYTE seedHigh, BYTE feedback)
+{
+	// LDX #count / LDA seedLow
+	BYTE x = count;
+	BYTE a = zeroPage[seedLow];
+	UINT cycles = 2 + 3;
+	do
+	{
+		// ASL A / ROL seedHigh / BCC skip / EOR #feedback
+		BOOL shiftedOut = a >> 7;
+		a <<= 1;
+		BOOL carry = zeroPage[seedHigh] >> 7;
+		zeroPage[seedHigh] = (zeroPage[seedHigh] << 1) | shiftedOut;
+		cycles += 2 + 5;
+		if(carry)
+		{
+			a ^= feedback;
+			cycles += 2 + 2;
+		}
+		else
+			cycles += 3;
+
+		// DEX / BNE loop
+		x--;
+		cycles += 2 + 3;
+	}while(x != 0);
+
+	// STA seedLow / CMP #0
+	zeroPage[seedLow] = a;
+	registers.A = a;
+	registers.X = x;
+	cpu_set_flag(CPU_FLAG_CARRY, TRUE);
+	cpu_set_flag(CPU_FLAG_ZERO, a == 0);
+	cpu_set_flag(CPU_FLAG_SIGN, a & 0x80);
+	return cycles - 1 + 3 + 2; // the final branch is not taken.
+}
+/*
+ * Executes the given known routine up to its RTS, leaving memory, registers and flags as the instructions would have.
+ * Returns the amount of cycles the instructions would have taken, or zero if the routine could not be executed natively.
+ */
+UINT hle_execute_routine(const struct HLEROUTINE* routine)
+{
+	// If an interrupt could occur during the routine, it must be handled between the instructions it occurred at.
+	if(!cpu_is_uninterrupted(hle_get_max_cycles(routine)))
+		return 0;
+
+	const BYTE* operands = routine->operands;
+	switch(routine->type)
+	{
+		case HLE_MULTIPLY:
+			return hle_multiply(operands[0], operands[1], operands[2]);
+		case HLE_DIVIDE:
+			return hle_divide(operands[0], operands[1], operands[2], operands[3]);
+		case HLE_DECIMAL:
+			return hle_decimal(operands[0], operands[1], operands[2]);
+		case HLE_LFSR:
+			return hle_lfsr(operands[0], operands[1], operands[2], operands[3]);
+	}
+	return 0;
+}
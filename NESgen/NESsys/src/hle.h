@@ -0,0 +1,34 @@
+
+#ifndef HLE_H_
+#define HLE_H_
+#include "NESsys.h"
+#include "cpu.h"
+#include "memory.h"
+
+// ---------------------------------
+// Known Routine Definitions
+// ---------------------------------
+#define HLE_MAX_OPERANDS	4
+enum HLETYPE
+{
+	HLE_MULTIPLY, // LDA #0 / LDX #count / LSR factor / (BCC / CLC / ADC multiplicand) / ROR A / ROR factor / DEX / BNE: count, factor, multiplicand
+	HLE_DIVIDE, // LDA #0 / LDX #count / (ASL low / ROL high / ROL A / CMP divisor / BCC / SBC divisor / INC low) / DEX / BNE: count, low, high, divisor
+	HLE_DECIMAL, // (CMP #100 / BCC / SBC #100 / INY / BNE) / STY hundreds / (CMP #10 / ...) / STY tens / STA ones: hundreds, tens, ones
+	HLE_LFSR // LDX #count / LDA seedLow / (ASL A / ROL seedHigh / BCC / EOR #feedback) / DEX / BNE / STA seedLow / CMP #0: count, seedLow, seedHigh, feedback
+};
+/*
+ * A subroutine the compiler recognized as a known routine (up to its RTS), which is executed with native code instead of its instructions.
+ * Operands are the zero page addresses and immediate values it was recognized with, in the order listed above.
+ */
+struct HLEROUTINE
+{
+	enum HLETYPE type;
+	BYTE operands[HLE_MAX_OPERANDS];
+};
+
+// ---------------------------------
+// Functions
+// ---------------------------------
+UINT hle_execute_routine(const struct HLEROUTINE* routine);
+
+#endif /* HLE_H_ */
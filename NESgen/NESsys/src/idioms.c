@@ -0,0 +1,188 @@
+#include "NESsys.h"
+#include "cpu.h"
+#include "memory.h"
+#include "ppu.h"
+#include "idioms.h"
+
+/*
+ * NOTES:
+ * -Idiom loops are recognized by the compiler, which emits a call to execute the entire loop at its head.
+ * -If a loop can't be executed with the exact same results in bulk (an interrupt may occur during it, or it accesses
+ *  memory with side effects), zero cycles are returned and the loop executes instruction by instruction instead.
+ * -The call is at the loop's head, which every iteration branches back to. Once a loop couldn't be executed in bulk, its remaining
+ *  iterations aren't checked again (that would resolve every address they access, for every iteration).
+ */
+
+/*
+ * Obtains a pointer to the index register the given loop counts with.
+ */
+BYTE* idiom_get_index_register(const struct IDIOMLOOP* loop)
+{
+	return loop->index == IDIOM_INDEX_X ? &registers.X : &registers.Y;
+}
+/*
+ * Obtains the amount of iterations the given loop will execute for, given the current index register.
+ */
+UINT idiom_get_iterations(const struct IDIOMLOOP* loop)
+{
+	// The index is stepped before it is tested, so a loop which starts at its final value runs 256 times.
+	BYTE index = *idiom_get_index_register(loop);
+	BYTE finalIndex = loop->compare ? loop->compareValue : 0;
+	BYTE distance = loop->decrement ? (BYTE)(index - finalIndex) : (BYTE)(finalIndex - index);
+	return distance == 0 ? 0x100 : distance;
+}
+/*
+ * Resolves the CPU address an operand accesses with the given index register value.
+ */
+USHORT idiom_get_operand_addr(const struct IDIOMOPERAND* operand, BYTE index)
+{
+	switch(operand->mode)
+	{
+		case IDIOM_OPERAND_ZERO_PAGE:
+			return (operand->address + index) & 0xFF;
+		case IDIOM_OPERAND_INDIRECT:
+			return cpu_read16(operand->address) + index;
+		default:
+			return operand->address + index;
+	}
+}
+/*
+ * Translates the CPU address an operand accesses, if it is plain memory which can be accessed without side effects.
+ * Returns NULL otherwise.
+ */
+BYTE* idiom_translate_operand(const struct IDIOMOPERAND* operand, BYTE index, BOOL write)
+{
+	USHORT fixedAddr = cpu_get_non_mirrored_addr(idiom_get_operand_addr(operand, index));
+	if(write && !IS_CPU_SYSTEM_MEMORY(fixedAddr))
+		return NULL;
+	return cpu_mem_translate(fixedAddr);
+}
+/*
+ * Checks if a pointer read by an indirect operand is located at the given (non-mirrored) address.
+ */
+BOOL idiom_is_pointer_addr(const struct IDIOMOPERAND* operand, USHORT fixedAddr)
+{
+	if(operand->mode != IDIOM_OPERAND_INDIRECT)
+		return FALSE;
+	return fixedAddr == cpu_get_non_mirrored_addr(operand->address) || fixedAddr == cpu_get_non_mirrored_addr(operand->address + 1);
+}
+/*
+ * Obtains the index register value the next iteration of the given loop starts with, given the current one.
+ */
+BYTE idiom_get_next_index(const struct IDIOMLOOP* loop, BYTE index)
+{
+	return loop->decrement ? (BYTE)(index - 1) : (BYTE)(index + 1);
+}
+/*
+ * Executes the entire given loop from its head in bulk, if it can be executed with the exact same results.
+ * Returns the amount of cycles the instructions would have taken, or zero if the loop could not be executed in bulk.
+ */
+UINT idiom_execute_loop_in_bulk(const struct IDIOMLOOP* loop)
+{
+	UINT iterations = idiom_get_iterations(loop);
+	UINT cycles = (iterations * loop->iterationCycles) - 1; // the final branch is not taken.
+
+	// If an interrupt could occur during the loop, it must be handled between the instructions it occurred at.
+	if(interrupts.requestedNMI || interrupts.requestedIRQ)
+		return 0;
+	if(ppuCtrl.executeNMIonVBLANK && ppu_cycles_until_vblank() <= (cycles + cpuStallCycles) * 3)
+		return 0;
+
+	// Resolve every byte we'll access first, so we can still fall back before anything was changed.
+	BYTE* index = idiom_get_index_register(loop);
+	BYTE* destinations[0x100];
+	BYTE* sources[0x100];
+	for(UINT i = 0; i < iterations; i++)
+	{
+		BYTE currentIndex = loop->decrement ? (BYTE)(*index - i) : (BYTE)(*index + i);
+		if(loop->destination.mode != IDIOM_OPERAND_PPUDATA)
+		{
+			// Writes must not change the pointers we resolved addresses with.
+			destinations[i] = idiom_translate_operand(&loop->destination, currentIndex, TRUE);
+			if(destinations[i] == NULL)
+				return 0;
+			USHORT fixedAddr = cpu_get_non_mirrored_addr(idiom_get_operand_addr(&loop->destination, currentIndex));
+			if(idiom_is_pointer_addr(&loop->destination, fixedAddr) || idiom_is_pointer_addr(&loop->source, fixedAddr))
+				return 0;
+		}
+		if(loop->type == IDIOM_COPY)
+		{
+			sources[i] = idiom_translate_operand(&loop->source, currentIndex, FALSE);
+			if(sources[i] == NULL)
+				return 0;
+		}
+	}
+
+	// PPUDATA writes are only independent of the PPU's progress while it isn't rendering (which changes the VRAM address),
+	// and if they don't write to the palette (which is displayed while rendering is disabled).
+	if(loop->destination.mode == IDIOM_OPERAND_PPUDATA)
+	{
+		USHORT increment = ppuCtrl.vramAddrIncrements32 ? 32 : 1;
+		if(ppuMask.showBackground || ppuMask.showSprites)
+			return 0;
+		if((ppuRegisters.v % 0x4000) + ((iterations - 1) * increment) >= PALETTE_ADDRS_START)
+			return 0;
+	}
+
+	// Perform the loop.
+	if(loop->destination.mode == IDIOM_OPERAND_PPUDATA)
+	{
+		if(loop->type == IDIOM_COPY)
+		{
+			BYTE block[0x100];
+			for(UINT i = 0; i < iterations; i++)
+				block[i] = *sources[i];
+			registers.A = block[iterations - 1];
+			ppu_write_data_block(block, iterations);
+		}
+		else
+			ppu_fill_data(registers.A, iterations);
+	}
+	else if(loop->type == IDIOM_COPY)
+	{
+		// Copy in order, so overlapping source/destination memory behaves the same.
+		for(UINT i = 0; i < iterations; i++)
+		{
+			registers.A = *sources[i];
+			*destinations[i] = registers.A;
+		}
+	}
+	else
+	{
+		for(UINT i = 0; i < iterations; i++)
+			*destinations[i] = registers.A;
+	}
+
+	// The index ends at its final value, so the last step (or compare) set the zero flag and cleared the sign flag.
+	// (A compare of equal values also sets the carry flag)
+	*index = loop->decrement ? (BYTE)(*index - iterations) : (BYTE)(*index + iterations);
+	cpu_set_flag(CPU_FLAG_ZERO, TRUE);
+	cpu_set_flag(CPU_FLAG_SIGN, FALSE);
+	if(loop->compare)
+		cpu_set_flag(CPU_FLAG_CARRY, TRUE);
+	return cycles;
+}
+/*
+ * Executes the entire given loop from its head, leaving memory, registers and flags as the instructions would have.
+ * Returns the amount of cycles the instructions would have taken, or zero if the loop could not be executed in bulk.
+ */
+UINT idiom_execute_loop(const struct IDIOMLOOP* loop)
+{
+	// If this is the next iteration of a loop which couldn't be executed in bulk, it continues instruction by instruction.
+	BYTE index = *idiom_get_index_register(loop);
+	if(loop == idiomDeclinedLoop && index == idiomDeclinedIndex && idiomDeclinedIterations > 0)
+	{
+		idiomDeclinedIndex = idiom_get_next_index(loop, index);
+		idiomDeclinedIterations--;
+		return 0;
+	}
+
+	UINT cycles = idiom_execute_loop_in_bulk(loop);
+	if(cycles == 0)
+	{
+		idiomDeclinedLoop = loop;
+		idiomDeclinedIndex = idiom_get_next_index(loop, index);
+		idiomDeclinedIterations = idiom_get_iterations(loop) - 1;
+	}
+	return cycles;
+}
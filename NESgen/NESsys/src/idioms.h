@@ -0,0 +1,53 @@
+
+#ifndef IDIOMS_H_
+#define IDIOMS_H_
+#include "NESsys.h"
+#include "cpu.h"
+#include "memory.h"
+
+// ---------------------------------
+// Idiom Definitions
+// ---------------------------------
+enum IDIOMTYPE { IDIOM_FILL, IDIOM_COPY };
+enum IDIOMINDEX { IDIOM_INDEX_X, IDIOM_INDEX_Y };
+enum IDIOMOPERANDMODE
+{
+	IDIOM_OPERAND_NONE, // unused (the source of a fill)
+	IDIOM_OPERAND_ABSOLUTE, // address + index
+	IDIOM_OPERAND_ZERO_PAGE, // (address + index) & 0xFF
+	IDIOM_OPERAND_INDIRECT, // pointer at address + index
+	IDIOM_OPERAND_PPUDATA // every access goes to PPUDATA
+};
+struct IDIOMOPERAND
+{
+	enum IDIOMOPERANDMODE mode;
+	USHORT address;
+};
+/*
+ * A counted loop recognized by the compiler, which stores a value (fill) or loaded values (copy) once per iteration:
+ * [LDA source] / STA destination / INX|INY|DEX|DEY / [CPX|CPY #compareValue] / BNE
+ */
+struct IDIOMLOOP
+{
+	enum IDIOMTYPE type;
+	enum IDIOMINDEX index;
+	BOOL decrement; // index is decremented every iteration, otherwise incremented.
+	BOOL compare; // index is compared to compareValue, otherwise the loop ends when it reaches zero.
+	BYTE compareValue;
+	struct IDIOMOPERAND source;
+	struct IDIOMOPERAND destination;
+	BYTE iterationCycles; // cycles for one iteration, including the taken branch.
+};
+
+// The loop which last couldn't be executed in bulk, the index its next iteration starts with, and how many iterations it has left.
+const struct IDIOMLOOP* idiomDeclinedLoop;
+BYTE idiomDeclinedIndex;
+UINT idiomDeclinedIterations;
+
+// ---------------------------------
+// Functions
+// ---------------------------------
+UINT idiom_get_iterations(const struct IDIOMLOOP* loop);
+UINT idiom_execute_loop(const struct IDIOMLOOP* loop);
+
+#endif /* IDIOMS_H_ */
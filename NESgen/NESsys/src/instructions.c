@@ -11,14 +11,7 @@
  */
 void MOSInstr_ADC(BYTE value)
 {
-	// TODO: Revisit to verify this.
-	USHORT result = registers.A + value + cpu_get_flag(CPU_FLAG_CARRY);
-	cpu_set_flag(CPU_FLAG_CARRY, result > 0xFF); // set if result carried over 8-bit
-	result &= 0xFF; // ensure 8-bit from now on
-	cpu_set_flag(CPU_FLAG_ZERO, result == 0); // set if result is 0
-	cpu_set_flag(CPU_FLAG_SIGN, result & 0x80); // set if sign bit is set
-	cpu_set_flag(CPU_FLAG_OVERFLOW, ~(registers.A ^ value) & 0x80 & (registers.A ^ result)); // set if operands results were same but result's wasn't.
-	registers.A = (BYTE)result;
+	registers.A = MOSInstr_AddWithCarry(registers.A, value);
 }
 /*
  * ANDs the accumulator with the given value.
@@ -46,9 +39,7 @@ BYTE MOSInstr_ASL(BYTE value)
  */
 void MOSInstr_BIT(BYTE value)
 {
-	cpu_set_flag(CPU_FLAG_OVERFLOW, value & 0x40); // copy bit 6 to overflow.
-	cpu_set_flag(CPU_FLAG_ZERO, (value & registers.A) == 0); // set if value and A don't share any bits
-	cpu_set_flag(CPU_FLAG_SIGN, value & 0x80); // set if sign bit is set
+	MOSInstr_Test(registers.A, value);
 }
 /*
  * Initiates the IRQ interrupt.
@@ -91,30 +82,21 @@ void MOSInstr_CLV()
  */
 void MOSInstr_CMP(BYTE value)
 {
-	cpu_set_flag(CPU_FLAG_CARRY, registers.A >= value); // set if A exceeds/matches value
-	value = registers.A - value;
-	cpu_set_flag(CPU_FLAG_ZERO, value == 0); // set if difference is 0
-	cpu_set_flag(CPU_FLAG_SIGN, value & 0x80); // set if sign bit on difference is set
+	MOSInstr_Compare(registers.A, value);
 }
 /*
  * Compares difference of given value and X register and stores in flags.
  */
 void MOSInstr_CPX(BYTE value)
 {
-	cpu_set_flag(CPU_FLAG_CARRY, registers.X >= value); // set if X exceeds/matches value
-	value = registers.X - value;
-	cpu_set_flag(CPU_FLAG_ZERO, value == 0); // set if difference is 0
-	cpu_set_flag(CPU_FLAG_SIGN, value & 0x80); // set if sign bit on difference is set
+	MOSInstr_Compare(registers.X, value);
 }
 /*
  * Compares difference of given value and Y register and stores in flags.
  */
 void MOSInstr_CPY(BYTE value)
 {
-	cpu_set_flag(CPU_FLAG_CARRY, registers.Y >= value); // set if Y exceeds/matches value
-	value = registers.Y - value;
-	cpu_set_flag(CPU_FLAG_ZERO, value == 0); // set if difference is 0
-	cpu_set_flag(CPU_FLAG_SIGN, value & 0x80); // set if sign bit on difference is set
+	MOSInstr_Compare(registers.Y, value);
 }
 /*
  * Decrements the given value and returns it.
@@ -308,14 +290,7 @@ void MOSInstr_RTI()
  */
 void MOSInstr_SBC(BYTE value)
 {
-	USHORT result = (registers.A - value) - (1 - cpu_get_flag(CPU_FLAG_CARRY));
-	cpu_set_flag(CPU_FLAG_CARRY, result <= 0xFF); // set if result didn't carry over 8-bit.
-	result &= 0xFF; // ensure 8-bit from this point forward.
-	cpu_set_flag(CPU_FLAG_ZERO, result == 0); // set if result is 0
-	cpu_set_flag(CPU_FLAG_SIGN, result & 0x80); // set if sign bit is set
-	cpu_set_flag(CPU_FLAG_OVERFLOW, (registers.A ^ value) & 0x80 & (registers.A ^ result)); // set if A has different sign than memory and result
-
-	registers.A = (BYTE)result;
+	registers.A = MOSInstr_SubtractWithBorrow(registers.A, value);
 }
 /*
  * Sets the carry flag
@@ -411,3 +386,114 @@ void MOSInstr_TYA()
 	cpu_set_flag(CPU_FLAG_ZERO, registers.A == 0); // set if result is 0
 	cpu_set_flag(CPU_FLAG_SIGN, registers.A & 0x80); // set if sign bit is set
 }
+
+/*
+ * The following take the registers they use as arguments and return the result, instead of using the registers structure.
+ * (used by compiled code which keeps registers in local variables)
+ */
+
+/*
+ * Sets the zero and sign flags for the given value (loaded into a register), and returns it.
+ */
+BYTE MOSInstr_Load(BYTE value)
+{
+	cpu_set_flag(CPU_FLAG_ZERO, value == 0); // set if result is 0
+	cpu_set_flag(CPU_FLAG_SIGN, value & 0x80); // set if sign bit is set
+	return value;
+}
+/*
+ * Adds given value to the given accumulator (and adds carry bit), and returns the result.
+ */
+BYTE MOSInstr_AddWithCarry(BYTE a, BYTE value)
+{
+	// TODO: Revisit to verify this.
+	USHORT result = a + value + cpu_get_flag(CPU_FLAG_CARRY);
+	cpu_set_flag(CPU_FLAG_CARRY, result > 0xFF); // set if result carried over 8-bit
+	result &= 0xFF; // ensure 8-bit from now on
+	cpu_set_flag(CPU_FLAG_ZERO, result == 0); // set if result is 0
+	cpu_set_flag(CPU_FLAG_SIGN, result & 0x80); // set if sign bit is set
+	cpu_set_flag(CPU_FLAG_OVERFLOW, ~(a ^ value) & 0x80 & (a ^ result)); // set if operands results were same but result's wasn't.
+	return (BYTE)result;
+}
+/*
+ * Subtracts given value from the given accumulator (with borrow), and returns the result.
+ */
+BYTE MOSInstr_SubtractWithBorrow(BYTE a, BYTE value)
+{
+	USHORT result = (a - value) - (1 - cpu_get_flag(CPU_FLAG_CARRY));
+	cpu_set_flag(CPU_FLAG_CARRY, result <= 0xFF); // set if result didn't carry over 8-bit.
+	result &= 0xFF; // ensure 8-bit from this point forward.
+	cpu_set_flag(CPU_FLAG_ZERO, result == 0); // set if result is 0
+	cpu_set_flag(CPU_FLAG_SIGN, result & 0x80); // set if sign bit is set
+	cpu_set_flag(CPU_FLAG_OVERFLOW, (a ^ value) & 0x80 & (a ^ result)); // set if A has different sign than memory and result
+	return (BYTE)result;
+}
+/*
+ * Compares difference of given value and the given register value and stores in flags.
+ */
+void MOSInstr_Compare(BYTE registerValue, BYTE value)
+{
+	cpu_set_flag(CPU_FLAG_CARRY, registerValue >= value); // set if the register exceeds/matches value
+	value = registerValue - value;
+	cpu_set_flag(CPU_FLAG_ZERO, value == 0); // set if difference is 0
+	cpu_set_flag(CPU_FLAG_SIGN, value & 0x80); // set if sign bit on difference is set
+}
+/*
+ * Tests many different bits on the given value (and the given accumulator).
+ */
+void MOSInstr_Test(BYTE a, BYTE value)
+{
+	cpu_set_flag(CPU_FLAG_OVERFLOW, value & 0x40); // copy bit 6 to overflow.
+	cpu_set_flag(CPU_FLAG_ZERO, (value & a) == 0); // set if value and A don't share any bits
+	cpu_set_flag(CPU_FLAG_SIGN, value & 0x80); // set if sign bit is set
+}
+
+/*
+ * The following execute a chain of the same shift (or shift and rotate pair) at once, setting the flags the last instruction would.
+ * (used by compiled code for fused instruction sequences)
+ */
+
+/*
+ * Shifts the given value left by the given number of bits (ASL repeated that many times), and returns it.
+ */
+BYTE MOSInstr_ShiftLeftBy(BYTE value, BYTE count)
+{
+	cpu_set_flag(CPU_FLAG_CARRY, (value << (count - 1)) & 0x80); // set to the last bit shifted out
+	value <<= count;
+	cpu_set_flag(CPU_FLAG_ZERO, value == 0); // set if result is 0
+	cpu_set_flag(CPU_FLAG_SIGN, value & 0x80); // set if sign bit is set
+	return value;
+}
+/*
+ * Shifts the given value right by the given number of bits (LSR repeated that many times), and returns it.
+ */
+BYTE MOSInstr_ShiftRightBy(BYTE value, BYTE count)
+{
+	cpu_set_flag(CPU_FLAG_CARRY, (value >> (count - 1)) & 0x01); // set to the last bit shifted out
+	value >>= count;
+	cpu_set_flag(CPU_FLAG_ZERO, value == 0); // set if result is 0
+	cpu_set_flag(CPU_FLAG_SIGN, value & 0x80); // set if sign bit is set
+	return value;
+}
+/*
+ * Shifts the given 16-bit value left by the given number of bits (ASL of the low byte, ROL of the high byte, repeated), and returns it.
+ */
+USHORT MOSInstr_ShiftLeft16(USHORT value, BYTE count)
+{
+	cpu_set_flag(CPU_FLAG_CARRY, ((value << (count - 1)) & 0x8000) != 0); // set to the last bit shifted out (BOOL is too small for the bit itself)
+	value <<= count;
+	cpu_set_flag(CPU_FLAG_ZERO, (value >> 8) == 0); // set if the high byte (rotated last) is 0
+	cpu_set_flag(CPU_FLAG_SIGN, (value & 0x8000) != 0); // set if its sign bit is set
+	return value;
+}
+/*
+ * Shifts the given 16-bit value right by the given number of bits (LSR of the high byte, ROR of the low byte, repeated), and returns it.
+ */
+USHORT MOSInstr_ShiftRight16(USHORT value, BYTE count)
+{
+	cpu_set_flag(CPU_FLAG_CARRY, (value >> (count - 1)) & 0x01); // set to the last bit shifted out
+	value >>= count;
+	cpu_set_flag(CPU_FLAG_ZERO, (value & 0xFF) == 0); // set if the low byte (rotated last) is 0
+	cpu_set_flag(CPU_FLAG_SIGN, value & 0x80); // set if its sign bit is set
+	return value;
+}
@@ -60,4 +60,15 @@ void MOSInstr_TXA();
 void MOSInstr_TXS();
 void MOSInstr_TYA();
 
+BYTE MOSInstr_Load(BYTE value);
+BYTE MOSInstr_AddWithCarry(BYTE a, BYTE value);
+BYTE MOSInstr_SubtractWithBorrow(BYTE a, BYTE value);
+void MOSInstr_Compare(BYTE registerValue, BYTE value);
+void MOSInstr_Test(BYTE a, BYTE value);
+
+BYTE MOSInstr_ShiftLeftBy(BYTE value, BYTE count);
+BYTE MOSInstr_ShiftRightBy(BYTE value, BYTE count);
+USHORT MOSInstr_ShiftLeft16(USHORT value, BYTE count);
+USHORT MOSInstr_ShiftRight16(USHORT value, BYTE count);
+
 #endif /* INSTRUCTIONS_H_ */
@@ -0,0 +1,446 @@
+#include "NESsys.h"
+#include "cpu.h"
+#include "memory.h"
+#include "instructions.h"
+#include "game_base.h"
+#include "interpreter.h"
+#include "profile.h"
+
+/*
+ * NOTES:
+ * -The compiler only outputs labels at locations it expects to be jumped to. A jump anywhere else misses the jump table
+ *  and is executed here instead, instruction by instruction, until it reaches a location which has a label again.
+ * -Control flow behaves like the compiled code: JSR calls game_execute() instead of pushing a return address, RTS and RTI return.
+ *  Unless the compiled code uses a return stack (gameUsesReturnStack), then JSR pushes its return address and RTS always pops it.
+ * -Code is decoded once into blocks (cached by address), which are executed by jumping directly from one instruction's code to the next.
+ *  Blocks decoded from RAM are compared against memory before executing, so code which is rewritten is decoded again.
+ */
+
+/*
+ * How to execute every opcode (with the same base cycles as the compiled code).
+ */
+const struct INTERPRETEROPCODE interpreterOpcodes[0x100] =
+{
+	[0x00] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 7, { .implied = MOSInstr_BRK } }, // BRK
+	[0x01] = { INTERPRETER_READ, INTERPRETER_MODE_INDIRECT_X, 6, { .read = MOSInstr_ORA } }, // ORA
+	[0x05] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE, 3, { .read = MOSInstr_ORA } }, // ORA
+	[0x06] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ZERO_PAGE, 5, { .modify = MOSInstr_ASL } }, // ASL
+	[0x08] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 3, { .implied = MOSInstr_PHP } }, // PHP
+	[0x09] = { INTERPRETER_READ, INTERPRETER_MODE_IMMEDIATE, 2, { .read = MOSInstr_ORA } }, // ORA
+	[0x0A] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ACCUMULATOR, 2, { .modify = MOSInstr_ASL } }, // ASL
+	[0x0D] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE, 4, { .read = MOSInstr_ORA } }, // ORA
+	[0x0E] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ABSOLUTE, 6, { .modify = MOSInstr_ASL } }, // ASL
+	[0x10] = { INTERPRETER_BRANCH, INTERPRETER_MODE_RELATIVE, 2, { NULL }, CPU_FLAG_SIGN, FALSE }, // BPL
+	[0x11] = { INTERPRETER_READ, INTERPRETER_MODE_INDIRECT_Y, 5, { .read = MOSInstr_ORA } }, // ORA
+	[0x15] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE_X, 4, { .read = MOSInstr_ORA } }, // ORA
+	[0x16] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ZERO_PAGE_X, 6, { .modify = MOSInstr_ASL } }, // ASL
+	[0x18] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_CLC } }, // CLC
+	[0x19] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE_Y, 4, { .read = MOSInstr_ORA } }, // ORA
+	[0x1D] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE_X, 4, { .read = MOSInstr_ORA } }, // ORA
+	[0x1E] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ABSOLUTE_X, 7, { .modify = MOSInstr_ASL } }, // ASL
+	[0x20] = { INTERPRETER_JSR, INTERPRETER_MODE_ABSOLUTE, 6 }, // JSR
+	[0x21] = { INTERPRETER_READ, INTERPRETER_MODE_INDIRECT_X, 6, { .read = MOSInstr_AND } }, // AND
+	[0x24] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE, 3, { .read = MOSInstr_BIT } }, // BIT
+	[0x25] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE, 3, { .read = MOSInstr_AND } }, // AND
+	[0x26] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ZERO_PAGE, 5, { .modify = MOSInstr_ROL } }, // ROL
+	[0x28] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 4, { .implied = MOSInstr_PLP } }, // PLP
+	[0x29] = { INTERPRETER_READ, INTERPRETER_MODE_IMMEDIATE, 2, { .read = MOSInstr_AND } }, // AND
+	[0x2A] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ACCUMULATOR, 2, { .modify = MOSInstr_ROL } }, // ROL
+	[0x2C] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE, 4, { .read = MOSInstr_BIT } }, // BIT
+	[0x2D] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE, 4, { .read = MOSInstr_AND } }, // AND
+	[0x2E] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ABSOLUTE, 6, { .modify = MOSInstr_ROL } }, // ROL
+	[0x30] = { INTERPRETER_BRANCH, INTERPRETER_MODE_RELATIVE, 2, { NULL }, CPU_FLAG_SIGN, TRUE }, // BMI
+	[0x31] = { INTERPRETER_READ, INTERPRETER_MODE_INDIRECT_Y, 5, { .read = MOSInstr_AND } }, // AND
+	[0x35] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE_X, 4, { .read = MOSInstr_AND } }, // AND
+	[0x36] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ZERO_PAGE_X, 6, { .modify = MOSInstr_ROL } }, // ROL
+	[0x38] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_SEC } }, // SEC
+	[0x39] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE_Y, 4, { .read = MOSInstr_AND } }, // AND
+	[0x3D] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE_X, 4, { .read = MOSInstr_AND } }, // AND
+	[0x3E] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ABSOLUTE_X, 7, { .modify = MOSInstr_ROL } }, // ROL
+	[0x40] = { INTERPRETER_RTI, INTERPRETER_MODE_IMPLIED, 6 }, // RTI
+	[0x41] = { INTERPRETER_READ, INTERPRETER_MODE_INDIRECT_X, 6, { .read = MOSInstr_EOR } }, // EOR
+	[0x45] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE, 3, { .read = MOSInstr_EOR } }, // EOR
+	[0x46] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ZERO_PAGE, 5, { .modify = MOSInstr_LSR } }, // LSR
+	[0x48] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 3, { .implied = MOSInstr_PHA } }, // PHA
+	[0x49] = { INTERPRETER_READ, INTERPRETER_MODE_IMMEDIATE, 2, { .read = MOSInstr_EOR } }, // EOR
+	[0x4A] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ACCUMULATOR, 2, { .modify = MOSInstr_LSR } }, // LSR
+	[0x4C] = { INTERPRETER_JMP, INTERPRETER_MODE_ABSOLUTE, 3 }, // JMP
+	[0x4D] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE, 4, { .read = MOSInstr_EOR } }, // EOR
+	[0x4E] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ABSOLUTE, 6, { .modify = MOSInstr_LSR } }, // LSR
+	[0x50] = { INTERPRETER_BRANCH, INTERPRETER_MODE_RELATIVE, 2, { NULL }, CPU_FLAG_OVERFLOW, FALSE }, // BVC
+	[0x51] = { INTERPRETER_READ, INTERPRETER_MODE_INDIRECT_Y, 5, { .read = MOSInstr_EOR } }, // EOR
+	[0x55] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE_X, 4, { .read = MOSInstr_EOR } }, // EOR
+	[0x56] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ZERO_PAGE_X, 6, { .modify = MOSInstr_LSR } }, // LSR
+	[0x58] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_CLI } }, // CLI
+	[0x59] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE_Y, 4, { .read = MOSInstr_EOR } }, // EOR
+	[0x5D] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE_X, 4, { .read = MOSInstr_EOR } }, // EOR
+	[0x5E] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ABSOLUTE_X, 7, { .modify = MOSInstr_LSR } }, // LSR
+	[0x60] = { INTERPRETER_RTS, INTERPRETER_MODE_IMPLIED, 6 }, // RTS
+	[0x61] = { INTERPRETER_READ, INTERPRETER_MODE_INDIRECT_X, 6, { .read = MOSInstr_ADC } }, // ADC
+	[0x65] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE, 3, { .read = MOSInstr_ADC } }, // ADC
+	[0x66] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ZERO_PAGE, 5, { .modify = MOSInstr_ROR } }, // ROR
+	[0x68] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 4, { .implied = MOSInstr_PLA } }, // PLA
+	[0x69] = { INTERPRETER_READ, INTERPRETER_MODE_IMMEDIATE, 2, { .read = MOSInstr_ADC } }, // ADC
+	[0x6A] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ACCUMULATOR, 2, { .modify = MOSInstr_ROR } }, // ROR
+	[0x6C] = { INTERPRETER_JMP, INTERPRETER_MODE_INDIRECT, 4 }, // JMP
+	[0x6D] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE, 4, { .read = MOSInstr_ADC } }, // ADC
+	[0x6E] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ABSOLUTE, 6, { .modify = MOSInstr_ROR } }, // ROR
+	[0x70] = { INTERPRETER_BRANCH, INTERPRETER_MODE_RELATIVE, 2, { NULL }, CPU_FLAG_OVERFLOW, TRUE }, // BVS
+	[0x71] = { INTERPRETER_READ, INTERPRETER_MODE_INDIRECT_Y, 5, { .read = MOSInstr_ADC } }, // ADC
+	[0x75] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE_X, 4, { .read = MOSInstr_ADC } }, // ADC
+	[0x76] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ZERO_PAGE_X, 6, { .modify = MOSInstr_ROR } }, // ROR
+	[0x78] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_SEI } }, // SEI
+	[0x79] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE_Y, 4, { .read = MOSInstr_ADC } }, // ADC
+	[0x7D] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE_X, 4, { .read = MOSInstr_ADC } }, // ADC
+	[0x7E] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ABSOLUTE_X, 7, { .modify = MOSInstr_ROR } }, // ROR
+	[0x81] = { INTERPRETER_STORE, INTERPRETER_MODE_INDIRECT_X, 6, { .store = MOSInstr_STA } }, // STA
+	[0x84] = { INTERPRETER_STORE, INTERPRETER_MODE_ZERO_PAGE, 3, { .store = MOSInstr_STY } }, // STY
+	[0x85] = { INTERPRETER_STORE, INTERPRETER_MODE_ZERO_PAGE, 3, { .store = MOSInstr_STA } }, // STA
+	[0x86] = { INTERPRETER_STORE, INTERPRETER_MODE_ZERO_PAGE, 3, { .store = MOSInstr_STX } }, // STX
+	[0x88] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_DEY } }, // DEY
+	[0x8A] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_TXA } }, // TXA
+	[0x8C] = { INTERPRETER_STORE, INTERPRETER_MODE_ABSOLUTE, 4, { .store = MOSInstr_STY } }, // STY
+	[0x8D] = { INTERPRETER_STORE, INTERPRETER_MODE_ABSOLUTE, 4, { .store = MOSInstr_STA } }, // STA
+	[0x8E] = { INTERPRETER_STORE, INTERPRETER_MODE_ABSOLUTE, 4, { .store = MOSInstr_STX } }, // STX
+	[0x90] = { INTERPRETER_BRANCH, INTERPRETER_MODE_RELATIVE, 2, { NULL }, CPU_FLAG_CARRY, FALSE }, // BCC
+	[0x91] = { INTERPRETER_STORE, INTERPRETER_MODE_INDIRECT_Y, 6, { .store = MOSInstr_STA } }, // STA
+	[0x94] = { INTERPRETER_STORE, INTERPRETER_MODE_ZERO_PAGE_X, 4, { .store = MOSInstr_STY } }, // STY
+	[0x95] = { INTERPRETER_STORE, INTERPRETER_MODE_ZERO_PAGE_X, 4, { .store = MOSInstr_STA } }, // STA
+	[0x96] = { INTERPRETER_STORE, INTERPRETER_MODE_ZERO_PAGE_Y, 4, { .store = MOSInstr_STX } }, // STX
+	[0x98] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_TYA } }, // TYA
+	[0x99] = { INTERPRETER_STORE, INTERPRETER_MODE_ABSOLUTE_Y, 5, { .store = MOSInstr_STA } }, // STA
+	[0x9A] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_TXS } }, // TXS
+	[0x9D] = { INTERPRETER_STORE, INTERPRETER_MODE_ABSOLUTE_X, 5, { .store = MOSInstr_STA } }, // STA
+	[0xA0] = { INTERPRETER_READ, INTERPRETER_MODE_IMMEDIATE, 2, { .read = MOSInstr_LDY } }, // LDY
+	[0xA1] = { INTERPRETER_READ, INTERPRETER_MODE_INDIRECT_X, 6, { .read = MOSInstr_LDA } }, // LDA
+	[0xA2] = { INTERPRETER_READ, INTERPRETER_MODE_IMMEDIATE, 2, { .read = MOSInstr_LDX } }, // LDX
+	[0xA4] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE, 3, { .read = MOSInstr_LDY } }, // LDY
+	[0xA5] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE, 3, { .read = MOSInstr_LDA } }, // LDA
+	[0xA6] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE, 3, { .read = MOSInstr_LDX } }, // LDX
+	[0xA8] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_TAY } }, // TAY
+	[0xA9] = { INTERPRETER_READ, INTERPRETER_MODE_IMMEDIATE, 2, { .read = MOSInstr_LDA } }, // LDA
+	[0xAA] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_TAX } }, // TAX
+	[0xAC] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE, 4, { .read = MOSInstr_LDY } }, // LDY
+	[0xAD] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE, 4, { .read = MOSInstr_LDA } }, // LDA
+	[0xAE] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE, 4, { .read = MOSInstr_LDX } }, // LDX
+	[0xB0] = { INTERPRETER_BRANCH, INTERPRETER_MODE_RELATIVE, 2, { NULL }, CPU_FLAG_CARRY, TRUE }, // BCS
+	[0xB1] = { INTERPRETER_READ, INTERPRETER_MODE_INDIRECT_Y, 5, { .read = MOSInstr_LDA } }, // LDA
+	[0xB4] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE_X, 4, { .read = MOSInstr_LDY } }, // LDY
+	[0xB5] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE_X, 4, { .read = MOSInstr_LDA } }, // LDA
+	[0xB6] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE_Y, 4, { .read = MOSInstr_LDX } }, // LDX
+	[0xB8] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_CLV } }, // CLV
+	[0xB9] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE_Y, 4, { .read = MOSInstr_LDA } }, // LDA
+	[0xBA] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_TSX } }, // TSX
+	[0xBC] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE_X, 4, { .read = MOSInstr_LDY } }, // LDY
+	[0xBD] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE_X, 4, { .read = MOSInstr_LDA } }, // LDA
+	[0xBE] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE_Y, 4, { .read = MOSInstr_LDX } }, // LDX
+	[0xC0] = { INTERPRETER_READ, INTERPRETER_MODE_IMMEDIATE, 2, { .read = MOSInstr_CPY } }, // CPY
+	[0xC1] = { INTERPRETER_READ, INTERPRETER_MODE_INDIRECT_X, 6, { .read = MOSInstr_CMP } }, // CMP
+	[0xC4] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE, 3, { .read = MOSInstr_CPY } }, // CPY
+	[0xC5] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE, 3, { .read = MOSInstr_CMP } }, // CMP
+	[0xC6] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ZERO_PAGE, 5, { .modify = MOSInstr_DEC } }, // DEC
+	[0xC8] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_INY } }, // INY
+	[0xC9] = { INTERPRETER_READ, INTERPRETER_MODE_IMMEDIATE, 2, { .read = MOSInstr_CMP } }, // CMP
+	[0xCA] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_DEX } }, // DEX
+	[0xCC] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE, 4, { .read = MOSInstr_CPY } }, // CPY
+	[0xCD] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE, 4, { .read = MOSInstr_CMP } }, // CMP
+	[0xCE] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ABSOLUTE, 6, { .modify = MOSInstr_DEC } }, // DEC
+	[0xD0] = { INTERPRETER_BRANCH, INTERPRETER_MODE_RELATIVE, 2, { NULL }, CPU_FLAG_ZERO, FALSE }, // BNE
+	[0xD1] = { INTERPRETER_READ, INTERPRETER_MODE_INDIRECT_Y, 5, { .read = MOSInstr_CMP } }, // CMP
+	[0xD5] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE_X, 4, { .read = MOSInstr_CMP } }, // CMP
+	[0xD6] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ZERO_PAGE_X, 6, { .modify = MOSInstr_DEC } }, // DEC
+	[0xD8] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_CLD } }, // CLD
+	[0xD9] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE_Y, 4, { .read = MOSInstr_CMP } }, // CMP
+	[0xDD] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE_X, 4, { .read = MOSInstr_CMP } }, // CMP
+	[0xDE] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ABSOLUTE_X, 7, { .modify = MOSInstr_DEC } }, // DEC
+	[0xE0] = { INTERPRETER_READ, INTERPRETER_MODE_IMMEDIATE, 2, { .read = MOSInstr_CPX } }, // CPX
+	[0xE1] = { INTERPRETER_READ, INTERPRETER_MODE_INDIRECT_X, 6, { .read = MOSInstr_SBC } }, // SBC
+	[0xE4] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE, 3, { .read = MOSInstr_CPX } }, // CPX
+	[0xE5] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE, 3, { .read = MOSInstr_SBC } }, // SBC
+	[0xE6] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ZERO_PAGE, 5, { .modify = MOSInstr_INC } }, // INC
+	[0xE8] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_INX } }, // INX
+	[0xE9] = { INTERPRETER_READ, INTERPRETER_MODE_IMMEDIATE, 2, { .read = MOSInstr_SBC } }, // SBC
+	[0xEA] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_NOP } }, // NOP
+	[0xEC] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE, 4, { .read = MOSInstr_CPX } }, // CPX
+	[0xED] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE, 4, { .read = MOSInstr_SBC } }, // SBC
+	[0xEE] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ABSOLUTE, 6, { .modify = MOSInstr_INC } }, // INC
+	[0xF0] = { INTERPRETER_BRANCH, INTERPRETER_MODE_RELATIVE, 2, { NULL }, CPU_FLAG_ZERO, TRUE }, // BEQ
+	[0xF1] = { INTERPRETER_READ, INTERPRETER_MODE_INDIRECT_Y, 5, { .read = MOSInstr_SBC } }, // SBC
+	[0xF5] = { INTERPRETER_READ, INTERPRETER_MODE_ZERO_PAGE_X, 4, { .read = MOSInstr_SBC } }, // SBC
+	[0xF6] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ZERO_PAGE_X, 6, { .modify = MOSInstr_INC } }, // INC
+	[0xF8] = { INTERPRETER_IMPLIED, INTERPRETER_MODE_IMPLIED, 2, { .implied = MOSInstr_SED } }, // SED
+	[0xF9] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE_Y, 4, { .read = MOSInstr_SBC } }, // SBC
+	[0xFD] = { INTERPRETER_READ, INTERPRETER_MODE_ABSOLUTE_X, 4, { .read = MOSInstr_SBC } }, // SBC
+	[0xFE] = { INTERPRETER_MODIFY, INTERPRETER_MODE_ABSOLUTE_X, 7, { .modify = MOSInstr_INC } }, // INC
+};
+
+/*
+ * Bit per CPU address, set once a jump to it was missed (so we only report it once).
+ */
+BYTE interpreterMissMap[0x10000 / 8];
+
+/*
+ * Initializes the interpreter, discarding all decoded blocks and statistics.
+ */
+void interpreter_init()
+{
+	memset(interpreterBlocks, 0, sizeof(interpreterBlocks));
+	memset(interpreterMissMap, 0, sizeof(interpreterMissMap));
+	interpreterCycles = 0;
+	interpreterMisses = 0;
+	interpreterBlockHits = 0;
+	interpreterBlockMisses = 0;
+}
+/*
+ * Checks if the compiled code has a label for the given address.
+ */
+BOOL interpreter_is_compiled_entry(USHORT address)
+{
+	if(IS_CPU_SYSTEM_MEMORY(address))
+		return FALSE;
+	USHORT index = address - 0x8000;
+	return (gameEntryMap[index / 8] & (1 << (index % 8))) != 0;
+}
+/*
+ * Reads a byte of code. PRG-ROM is read from the full PRG-ROM (data sections may not include code), anything else from memory.
+ */
+BYTE interpreter_read_code(USHORT address)
+{
+	if(IS_CPU_SYSTEM_MEMORY(address))
+		return cpu_read8(address);
+	return prgRomCode[(address - 0x8000) % prgRomCodeSize];
+}
+/*
+ * Obtains the size of an instruction with the given addressing mode.
+ */
+BYTE interpreter_get_instruction_size(enum INTERPRETERMODE mode)
+{
+	switch(mode)
+	{
+		case INTERPRETER_MODE_IMPLIED:
+		case INTERPRETER_MODE_ACCUMULATOR:
+			return 1;
+		case INTERPRETER_MODE_ABSOLUTE:
+		case INTERPRETER_MODE_ABSOLUTE_X:
+		case INTERPRETER_MODE_ABSOLUTE_Y:
+		case INTERPRETER_MODE_INDIRECT:
+			return 3;
+		default:
+			return 2;
+	}
+}
+/*
+ * Resolves the address an instruction with the given addressing mode and operand accesses.
+ */
+USHORT interpreter_get_operand_addr(enum INTERPRETERMODE mode, USHORT operand)
+{
+	switch(mode)
+	{
+		case INTERPRETER_MODE_ZERO_PAGE_X:
+			return (registers.X + operand) & 0xFF;
+		case INTERPRETER_MODE_ZERO_PAGE_Y:
+			return (registers.Y + operand) & 0xFF;
+		case INTERPRETER_MODE_ABSOLUTE_X:
+			return registers.X + operand;
+		case INTERPRETER_MODE_ABSOLUTE_Y:
+			return registers.Y + operand;
+		case INTERPRETER_MODE_INDIRECT_X:
+			return cpu_read16((registers.X + operand) & 0xFF);
+		case INTERPRETER_MODE_INDIRECT_Y:
+			return registers.Y + cpu_read16(operand);
+		default:
+			return operand;
+	}
+}
+/*
+ * Decodes the block of instructions at the given address into the given block.
+ */
+void interpreter_decode_block(struct INTERPRETERBLOCK* block, USHORT address)
+{
+	block->valid = TRUE;
+	block->writable = IS_CPU_SYSTEM_MEMORY(address);
+	block->address = address;
+	block->size = 0;
+	block->count = 0;
+	do
+	{
+		struct INTERPRETERINSTRUCTION* instruction = &block->instructions[block->count++];
+		USHORT instructionAddress = address + block->size;
+		instruction->opcode = &interpreterOpcodes[interpreter_read_code(instructionAddress)];
+		instruction->size = interpreter_get_instruction_size(instruction->opcode->mode);
+		for(BYTE i = 0; i < instruction->size; i++)
+			block->bytes[block->size + i] = interpreter_read_code(instructionAddress + i);
+		instruction->operand = instruction->size == 3 ? (block->bytes[block->size + 1] | (block->bytes[block->size + 2] << 8)) : (instruction->size == 2 ? block->bytes[block->size + 1] : 0);
+		block->size += instruction->size;
+
+		// Anything which changes control flow (or is invalid) ends the block.
+		if(instruction->opcode->operation == INTERPRETER_INVALID || instruction->opcode->operation >= INTERPRETER_BRANCH)
+			break;
+	}
+	while(block->count < INTERPRETER_BLOCK_MAX_INSTRUCTIONS && !interpreter_is_compiled_entry(address + block->size));
+}
+/*
+ * Obtains the decoded block of instructions at the given address, decoding it if it isn't cached (or its code has changed).
+ */
+struct INTERPRETERBLOCK* interpreter_get_block(USHORT address)
+{
+	struct INTERPRETERBLOCK* block = &interpreterBlocks[address % INTERPRETER_BLOCK_CACHE_SIZE];
+	if(block->valid && block->address == address)
+	{
+		// PRG-ROM can't change, but code in RAM may have been rewritten.
+		BOOL changed = FALSE;
+		if(block->writable)
+		{
+			for(USHORT i = 0; i < block->size && !changed; i++)
+				changed = block->bytes[i] != interpreter_read_code(address + i);
+		}
+		if(!changed)
+		{
+			interpreterBlockHits++;
+			return block;
+		}
+	}
+	interpreterBlockMisses++;
+	interpreter_decode_block(block, address);
+	return block;
+}
+
+// Executes the decoded instructions of a block, dispatching directly from one instruction's code to the next.
+#if INTERPRETER_USE_THREADED_DISPATCH
+#define INTERPRETER_DISPATCH()				goto *operationLabels[instruction->opcode->operation]
+#define INTERPRETER_OPERATION(operation)	operation##_LABEL:
+#else
+#define INTERPRETER_DISPATCH()				goto Dispatch
+#define INTERPRETER_OPERATION(operation)	case operation:
+#endif
+#define INTERPRETER_SYNC(cycles)			interpreterCycles += (cycles); if(cpu_sync(cycles)) return TRUE
+#define INTERPRETER_NEXT()					INTERPRETER_SYNC(instruction->opcode->cycles); pc += instruction->size; if(++instruction == end) goto BlockEnd; INTERPRETER_DISPATCH()
+// A write to the block's own code ends it after the instruction, so the rest of it is decoded again.
+#define INTERPRETER_CHECK_CODE_WRITE(addr)	if(block->writable && (USHORT)((addr) - block->address) < block->size) end = instruction + 1
+
+/*
+ * Executes code at the given address (which has no label in the compiled code) until it reaches a location which does,
+ * and continues executing the compiled code there. Returns TRUE if the current interrupt handler should stop executing.
+ */
+BOOL interpreter_execute(USHORT address)
+{
+#if INTERPRETER_USE_THREADED_DISPATCH
+	static const void* const operationLabels[] =
+	{
+		[INTERPRETER_INVALID] = &&INTERPRETER_INVALID_LABEL,
+		[INTERPRETER_READ] = &&INTERPRETER_READ_LABEL,
+		[INTERPRETER_MODIFY] = &&INTERPRETER_MODIFY_LABEL,
+		[INTERPRETER_STORE] = &&INTERPRETER_STORE_LABEL,
+		[INTERPRETER_IMPLIED] = &&INTERPRETER_IMPLIED_LABEL,
+		[INTERPRETER_BRANCH] = &&INTERPRETER_BRANCH_LABEL,
+		[INTERPRETER_JMP] = &&INTERPRETER_JMP_LABEL,
+		[INTERPRETER_JSR] = &&INTERPRETER_JSR_LABEL,
+		[INTERPRETER_RTS] = &&INTERPRETER_RTS_LABEL,
+		[INTERPRETER_RTI] = &&INTERPRETER_RTI_LABEL
+	};
+#endif
+
+	// Report the first time we miss each location, since it is code the compiler didn't discover.
+	interpreterMisses++;
+	profile_miss(address);
+	if(!(interpreterMissMap[address / 8] & (1 << (address % 8))))
+	{
+		interpreterMissMap[address / 8] |= 1 << (address % 8);
+		debug_log("Interpreting code at 0x%04x, which the compiled code has no label for...\n", address);
+	}
+
+	USHORT pc = address;
+	INT pushedBytes = 0; // bytes pushed since we began, so we know an RTS returns to an address pushed to dispatch.
+	do
+	{
+		struct INTERPRETERBLOCK* block = interpreter_get_block(pc);
+		const struct INTERPRETERINSTRUCTION* instruction = block->instructions;
+		const struct INTERPRETERINSTRUCTION* end = instruction + block->count;
+		USHORT operandAddr;
+		INTERPRETER_DISPATCH();
+#if !INTERPRETER_USE_THREADED_DISPATCH
+	Dispatch:
+		switch(instruction->opcode->operation)
+#endif
+		{
+			INTERPRETER_OPERATION(INTERPRETER_READ)
+				if(instruction->opcode->mode == INTERPRETER_MODE_IMMEDIATE)
+					instruction->opcode->function.read((BYTE)instruction->operand);
+				else
+					instruction->opcode->function.read(cpu_read8(interpreter_get_operand_addr(instruction->opcode->mode, instruction->operand)));
+				INTERPRETER_NEXT();
+			INTERPRETER_OPERATION(INTERPRETER_MODIFY)
+				if(instruction->opcode->mode == INTERPRETER_MODE_ACCUMULATOR)
+					registers.A = instruction->opcode->function.modify(registers.A);
+				else
+				{
+					operandAddr = interpreter_get_operand_addr(instruction->opcode->mode, instruction->operand);
+					cpu_write8(operandAddr, instruction->opcode->function.modify(cpu_read8(operandAddr)));
+					INTERPRETER_CHECK_CODE_WRITE(operandAddr);
+				}
+				INTERPRETER_NEXT();
+			INTERPRETER_OPERATION(INTERPRETER_STORE)
+				operandAddr = interpreter_get_operand_addr(instruction->opcode->mode, instruction->operand);
+				instruction->opcode->function.store(operandAddr);
+				INTERPRETER_CHECK_CODE_WRITE(operandAddr);
+				INTERPRETER_NEXT();
+			INTERPRETER_OPERATION(INTERPRETER_IMPLIED)
+				instruction->opcode->function.implied();
+				if(instruction->opcode->function.implied == MOSInstr_PHA || instruction->opcode->function.implied == MOSInstr_PHP)
+					pushedBytes++;
+				else if(instruction->opcode->function.implied == MOSInstr_PLA || instruction->opcode->function.implied == MOSInstr_PLP)
+					pushedBytes--;
+				INTERPRETER_NEXT();
+			INTERPRETER_OPERATION(INTERPRETER_BRANCH)
+				if(cpu_get_flag(instruction->opcode->branchFlag) == instruction->opcode->branchValue)
+				{
+					// If we branch we add an additional cycle, otherwise we don't.
+					INTERPRETER_SYNC(instruction->opcode->cycles + 1);
+					pc += instruction->size + (CHAR)instruction->operand;
+					goto BlockEnd;
+				}
+				INTERPRETER_NEXT();
+			INTERPRETER_OPERATION(INTERPRETER_JMP)
+				INTERPRETER_SYNC(instruction->opcode->cycles);
+				pc = instruction->opcode->mode == INTERPRETER_MODE_INDIRECT ? cpu_read16(instruction->operand) : instruction->operand;
+				goto BlockEnd;
+			INTERPRETER_OPERATION(INTERPRETER_JSR)
+				if(gameUsesReturnStack)
+				{
+					// The return address (the JSR's last byte) is pushed for the subroutine's RTS to return through.
+					cpu_stack_push((pc + 2) >> 8);
+					cpu_stack_push((pc + 2) & 0xFF);
+					INTERPRETER_SYNC(instruction->opcode->cycles);
+					pc = instruction->operand;
+					goto BlockEnd;
+				}
+				INTERPRETER_SYNC(instruction->opcode->cycles);
+				if(game_execute(instruction->operand))
+					return TRUE;
+				pc += instruction->size;
+				goto BlockEnd;
+			INTERPRETER_OPERATION(INTERPRETER_RTS)
+				INTERPRETER_SYNC(instruction->opcode->cycles);
+				if(pushedBytes < 2 && !gameUsesReturnStack)
+					return FALSE;
+				// This RTS returns to an address pushed to dispatch (the address + 1).
+				pc = cpu_stack_pop();
+				pc |= cpu_stack_pop() << 8;
+				pc++;
+				pushedBytes -= 2;
+				goto BlockEnd;
+			INTERPRETER_OPERATION(INTERPRETER_RTI)
+				interpreterCycles += instruction->opcode->cycles;
+				cpu_sync(instruction->opcode->cycles);
+				return TRUE;
+			INTERPRETER_OPERATION(INTERPRETER_INVALID)
+				error("Attempted to jump to an non-executable location 0x%04x (invalid opcode at 0x%04x). This location may have been calculated at runtime and not supported by the compiler, the ROM may be faulty, or improper emulation of some component has caused undesirable runtime effects.", address, pc);
+				return FALSE;
+		}
+	BlockEnd:;
+	}
+	while(!interpreter_is_compiled_entry(pc));
+
+	// We've reached compiled code, so we continue executing there.
+	return game_execute(pc);
+}
@@ -0,0 +1,97 @@
+
+#ifndef INTERPRETER_H_
+#define INTERPRETER_H_
+#include "NESsys.h"
+#include "cpu.h"
+#include "memory.h"
+
+#define INTERPRETER_BLOCK_CACHE_SIZE		0x100 // decoded blocks (direct mapped by address)
+#define INTERPRETER_BLOCK_MAX_INSTRUCTIONS	0x20
+#define INTERPRETER_BLOCK_MAX_SIZE			(INTERPRETER_BLOCK_MAX_INSTRUCTIONS * 3)
+
+// Decoded instructions are dispatched through an array of label addresses where the compiler supports them (GCC/Clang), a switch otherwise.
+#ifndef INTERPRETER_USE_THREADED_DISPATCH
+#ifdef __GNUC__
+#define INTERPRETER_USE_THREADED_DISPATCH	TRUE
+#else
+#define INTERPRETER_USE_THREADED_DISPATCH	FALSE
+#endif
+#endif
+
+// ---------------------------------
+// Opcode Definitions
+// ---------------------------------
+enum INTERPRETEROPERATION
+{
+	INTERPRETER_INVALID, // not an opcode
+	INTERPRETER_READ, // function(value)
+	INTERPRETER_MODIFY, // value = function(value)
+	INTERPRETER_STORE, // function(address)
+	INTERPRETER_IMPLIED, // function()
+	INTERPRETER_BRANCH,
+	INTERPRETER_JMP,
+	INTERPRETER_JSR,
+	INTERPRETER_RTS,
+	INTERPRETER_RTI
+};
+enum INTERPRETERMODE
+{
+	INTERPRETER_MODE_IMPLIED, INTERPRETER_MODE_ACCUMULATOR, INTERPRETER_MODE_IMMEDIATE, INTERPRETER_MODE_RELATIVE,
+	INTERPRETER_MODE_ZERO_PAGE, INTERPRETER_MODE_ZERO_PAGE_X, INTERPRETER_MODE_ZERO_PAGE_Y,
+	INTERPRETER_MODE_ABSOLUTE, INTERPRETER_MODE_ABSOLUTE_X, INTERPRETER_MODE_ABSOLUTE_Y,
+	INTERPRETER_MODE_INDIRECT, INTERPRETER_MODE_INDIRECT_X, INTERPRETER_MODE_INDIRECT_Y
+};
+struct INTERPRETEROPCODE
+{
+	enum INTERPRETEROPERATION operation;
+	enum INTERPRETERMODE mode;
+	BYTE cycles;
+	union
+	{
+		void (*implied)();
+		void (*read)(BYTE value);
+		BYTE (*modify)(BYTE value);
+		void (*store)(USHORT addr);
+	} function;
+	BYTE branchFlag; // flag a branch tests.
+	BOOL branchValue; // value of the flag a branch is taken on.
+};
+
+// ---------------------------------
+// Block Cache
+// ---------------------------------
+struct INTERPRETERINSTRUCTION
+{
+	const struct INTERPRETEROPCODE* opcode;
+	USHORT operand;
+	BYTE size;
+};
+/*
+ * Instructions decoded from an address, up to (and including) the first one which changes control flow,
+ * or up to the first location the compiled code has a label for.
+ */
+struct INTERPRETERBLOCK
+{
+	BOOL valid;
+	BOOL writable; // decoded from RAM, so the code may have changed since (checked against bytes before executing).
+	USHORT address;
+	USHORT size; // size of all instructions, in bytes.
+	BYTE count;
+	BYTE bytes[INTERPRETER_BLOCK_MAX_SIZE];
+	struct INTERPRETERINSTRUCTION instructions[INTERPRETER_BLOCK_MAX_INSTRUCTIONS];
+};
+struct INTERPRETERBLOCK interpreterBlocks[INTERPRETER_BLOCK_CACHE_SIZE];
+
+// Statistics, to see how much code runs outside of the compiled code (native cycles are cpuCyclesTotal - interpreterCycles).
+ULONGLONG interpreterCycles;
+ULONGLONG interpreterMisses; // jumps the compiled code had no label for.
+ULONGLONG interpreterBlockHits;
+ULONGLONG interpreterBlockMisses; // blocks decoded (not cached, evicted, or their code changed).
+
+// ---------------------------------
+// Functions
+// ---------------------------------
+void interpreter_init();
+BOOL interpreter_execute(USHORT address);
+
+#endif /* INTERPRETER_H_ */
@@ -0,0 +1,113 @@
+#include "NESsys.h"
+#include "cpu.h"
+#include "memory.h"
+#include "memo.h"
+
+/*
+ * NOTES:
+ * -Memoized subroutines look their inputs up when called: a hit leaves the registers, flags and RAM as the subroutine did when it was executed
+ *  with the same inputs, and returns the cycles it took. A miss executes the subroutine, which stores its results when it returns.
+ * -Results are only stored if no interrupt was handled while the subroutine executed (the handler could have changed its inputs, and its
+ *  cycles include the handler's), and only used if no interrupt can occur during the cycles they took.
+ */
+
+/*
+ * Obtains the given RAM address (0x000-0x0FF or 0x200-0x7FF, the compiler never memoizes stack page accesses).
+ */
+BYTE* memo_get_ram(USHORT address)
+{
+	return address < MEMORY_PAGE_SIZE ? &zeroPage[address] : &ram[address - (MEMORY_PAGE_SIZE * 2)];
+}
+/*
+ * Packs the registers, flags and RAM the given subroutine reads into a key.
+ */
+ULONGLONG memo_get_key(const struct MEMOSUBROUTINE* subroutine)
+{
+	ULONGLONG key = registers.P & subroutine->inputFlags;
+	if(subroutine->inputRegisters & MEMO_REGISTER_A)
+		key |= (ULONGLONG)registers.A << 8;
+	if(subroutine->inputRegisters & MEMO_REGISTER_X)
+		key |= (ULONGLONG)registers.X << 16;
+	if(subroutine->inputRegisters & MEMO_REGISTER_Y)
+		key |= (ULONGLONG)registers.Y << 24;
+	for(UINT i = 0; i < subroutine->inputCount; i++)
+		key |= (ULONGLONG)*memo_get_ram(subroutine->inputs[i]) << (32 + (i * 8));
+	return key;
+}
+/*
+ * Obtains the cache entry the given key maps to (its halves folded, then hashed so inputs in any byte spread over the cache).
+ */
+struct MEMOENTRY* memo_get_entry(struct MEMOSUBROUTINE* subroutine, ULONGLONG key)
+{
+	UINT hash = (UINT)(key ^ (key >> 32)) * 0x9E3779B1;
+	hash ^= hash >> 15;
+	return &subroutine->entries[hash >> (32 - MEMO_CACHE_BITS)];
+}
+/*
+ * Looks up the results of calling the given subroutine with the current registers, flags and RAM.
+ * Returns the cycles the subroutine took if they were applied, or zero if it must be executed (and memo_store() called when it returns).
+ */
+UINT memo_lookup(struct MEMOSUBROUTINE* subroutine)
+{
+	ULONGLONG key = memo_get_key(subroutine);
+	struct MEMOENTRY* entry = memo_get_entry(subroutine, key);
+	subroutine->calls++;
+	if(entry->valid && entry->key == key && cpu_is_uninterrupted(entry->cycles))
+	{
+		if(subroutine->outputRegisters & MEMO_REGISTER_A)
+			registers.A = entry->A;
+		if(subroutine->outputRegisters & MEMO_REGISTER_X)
+			registers.X = entry->X;
+		if(subroutine->outputRegisters & MEMO_REGISTER_Y)
+			registers.Y = entry->Y;
+		registers.P = (registers.P & ~subroutine->outputFlags) | (entry->P & subroutine->outputFlags);
+		for(UINT i = 0; i < subroutine->outputCount; i++)
+			*memo_get_ram(subroutine->outputs[i]) = entry->outputs[i];
+		subroutine->pending = FALSE;
+		subroutine->hits++;
+		subroutine->cyclesSkipped += entry->cycles;
+		return entry->cycles;
+	}
+
+	// Remember what we're executing with, and when we started (including cycles the CPU is stalled for, which the first sync adds).
+	subroutine->pending = TRUE;
+	subroutine->pendingKey = key;
+	subroutine->pendingStartCycles = cpuCyclesTotal + cpuStallCycles;
+	subroutine->pendingInterruptCount = cpuInterruptCount;
+	return 0;
+}
+/*
+ * Stores the results of the given subroutine, which is returning after a lookup missed (once its return has synced).
+ */
+void memo_store(struct MEMOSUBROUTINE* subroutine)
+{
+	if(!subroutine->pending)
+		return;
+	subroutine->pending = FALSE;
+	if(subroutine->pendingInterruptCount != cpuInterruptCount)
+		return;
+
+	struct MEMOENTRY* entry = memo_get_entry(subroutine, subroutine->pendingKey);
+	entry->key = subroutine->pendingKey;
+	entry->valid = TRUE;
+	entry->A = registers.A;
+	entry->X = registers.X;
+	entry->Y = registers.Y;
+	entry->P = registers.P;
+	for(UINT i = 0; i < subroutine->outputCount; i++)
+		entry->outputs[i] = *memo_get_ram(subroutine->outputs[i]);
+	entry->cycles = (UINT)(cpuCyclesTotal - subroutine->pendingStartCycles);
+}
+/*
+ * Prints how often every memoized subroutine's results were found, and the cycles of instructions that skipped.
+ */
+void memo_report()
+{
+	for(UINT i = 0; i < memoSubroutineCount; i++)
+	{
+		struct MEMOSUBROUTINE* subroutine = &memoSubroutines[i];
+		double hitRate = subroutine->calls > 0 ? ((double)subroutine->hits / subroutine->calls) * 100 : 0;
+		console_log("Memoized subroutine 0x%04X: %llu calls, %llu hits (%.1f%%), %llu cycles skipped.\n", subroutine->address,
+				subroutine->calls, subroutine->hits, hitRate, subroutine->cyclesSkipped);
+	}
+}
@@ -0,0 +1,67 @@
+
+#ifndef MEMO_H_
+#define MEMO_H_
+#include "NESsys.h"
+#include "cpu.h"
+#include "memory.h"
+
+// ---------------------------------
+// Memoization Definitions
+// ---------------------------------
+#define MEMO_CACHE_BITS			6
+#define MEMO_CACHE_SIZE			(1 << MEMO_CACHE_BITS) // direct mapped entries cached per subroutine.
+#define MEMO_MAX_ADDRESSES		4 // RAM addresses a subroutine may read (or write) to be memoized.
+#define MEMO_REGISTER_A			0x01
+#define MEMO_REGISTER_X			0x02
+#define MEMO_REGISTER_Y			0x04
+
+/*
+ * The result of executing a subroutine with inputs packed into key: the registers, flags and RAM it left, and the cycles it took.
+ */
+struct MEMOENTRY
+{
+	ULONGLONG key;
+	BOOL valid;
+	BYTE A, X, Y, P;
+	BYTE outputs[MEMO_MAX_ADDRESSES];
+	UINT cycles;
+};
+/*
+ * A subroutine the compiler found to only depend on the registers, flags and RAM addresses given (and PRG-ROM, which can't change),
+ * and to only change the registers, flags and RAM addresses given. Its results are cached by those inputs.
+ */
+struct MEMOSUBROUTINE
+{
+	USHORT address;
+	BYTE inputRegisters; // MEMO_REGISTER_* read
+	BYTE inputFlags; // processor status flags read (mask)
+	BYTE inputCount;
+	USHORT inputs[MEMO_MAX_ADDRESSES]; // RAM addresses read
+	BYTE outputRegisters; // MEMO_REGISTER_* written
+	BYTE outputFlags; // processor status flags written (mask)
+	BYTE outputCount;
+	USHORT outputs[MEMO_MAX_ADDRESSES]; // RAM addresses written
+
+	// The execution which missed (if it hasn't returned yet), and statistics.
+	struct MEMOENTRY entries[MEMO_CACHE_SIZE];
+	BOOL pending;
+	ULONGLONG pendingKey;
+	ULONGLONG pendingStartCycles;
+	UINT pendingInterruptCount;
+	ULONGLONG calls;
+	ULONGLONG hits;
+	ULONGLONG cyclesSkipped;
+};
+
+// Memoized subroutines of games generated with -z.
+struct MEMOSUBROUTINE* memoSubroutines;
+UINT memoSubroutineCount;
+
+// ---------------------------------
+// Functions
+// ---------------------------------
+UINT memo_lookup(struct MEMOSUBROUTINE* subroutine);
+void memo_store(struct MEMOSUBROUTINE* subroutine);
+void memo_report();
+
+#endif /* MEMO_H_ */
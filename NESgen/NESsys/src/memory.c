@@ -82,6 +82,19 @@ BYTE* cpu_mem_translate(USHORT addr)
 	}
 	return NULL;
 }
+/*
+ * Translates an entire NES CPU memory page (256 bytes) to a buffer that was mapped, so it can be accessed as a block.
+ * Returns NULL if the page is not contiguous memory within our table (such as hardware registers).
+ */
+BYTE* cpu_mem_translate_page(BYTE pageNumber)
+{
+	// Translate the first and last byte of the page, they must be from the same contiguous buffer.
+	USHORT pageAddr = pageNumber * MEMORY_PAGE_SIZE;
+	BYTE* ptr = cpu_mem_translate(cpu_get_non_mirrored_addr(pageAddr));
+	if(ptr == NULL || cpu_mem_translate(cpu_get_non_mirrored_addr(pageAddr + MEMORY_PAGE_SIZE - 1)) != ptr + MEMORY_PAGE_SIZE - 1)
+		return NULL;
+	return ptr;
+}
 /*
  * Reads a byte from the given CPU memory address.
  */
@@ -299,6 +312,9 @@ void ppu_write8(USHORT addr, BYTE data)
 	BYTE* ptr = ppu_mem_translate(fixedAddr);
 	if(ptr != NULL)
 	{
+		// If this changes data our resolved background tiles depend on, invalidate them.
+		if(*ptr != data && IS_TILE_CACHE_MEMORY(fixedAddr))
+			ppu_invalidate_tile_cache();
 		*ptr = data;
 		return;
 	}
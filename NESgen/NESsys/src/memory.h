@@ -50,6 +50,8 @@
 #define NAMETABLE_SIZE							0x400
 #define PALETTE_ADDRS_START						0x3F00
 #define PALETTE_ADDRS_END						0x4000
+#define BACKGROUND_PALETTE_ADDRS_END			0x3F10
+#define IS_TILE_CACHE_MEMORY(addr)				(addr < PATTERNTABLE_ADDR_END || (addr >= PALETTE_ADDRS_START && addr < BACKGROUND_PALETTE_ADDRS_END))
 
 // Translation Lookaside Buffer (TLB) to translate any NES referenced addresses.
 struct TLBEntry
@@ -65,6 +67,7 @@ BYTE* unmappedCPUMemory;
 // ---------------------------------
 USHORT cpu_get_non_mirrored_addr(USHORT addr);
 BYTE* cpu_mem_translate(USHORT addr);
+BYTE* cpu_mem_translate_page(BYTE pageNumber);
 BYTE cpu_read8(USHORT addr);
 USHORT cpu_read16(USHORT addr);
 void cpu_write8(USHORT addr, BYTE data);
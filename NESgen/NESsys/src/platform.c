@@ -66,6 +66,125 @@ void destroy_thread(THREADHANDLE handle)
 	pthread_cancel(handle);
 #endif
 }
+#if !defined(_WIN32) && !__APPLE__ && __x86_64__
+/*
+ * Saves the callee-saved registers to the stack, and the stack pointer to the given location (first argument),
+ * then restores those of the given stack pointer (second argument), returning into the context which saved it.
+ */
+void platform_switch_stack(void** currentStackPointer, void* targetStackPointer);
+__asm__(
+	".pushsection .text\n"
+	".globl platform_switch_stack\n"
+	".type platform_switch_stack, @function\n"
+	"platform_switch_stack:\n"
+	"	pushq %rbp\n"
+	"	pushq %rbx\n"
+	"	pushq %r12\n"
+	"	pushq %r13\n"
+	"	pushq %r14\n"
+	"	pushq %r15\n"
+	"	movq %rsp, (%rdi)\n"
+	"	movq %rsi, %rsp\n"
+	"	popq %r15\n"
+	"	popq %r14\n"
+	"	popq %r13\n"
+	"	popq %r12\n"
+	"	popq %rbx\n"
+	"	popq %rbp\n"
+	"	ret\n"
+	".size platform_switch_stack, .-platform_switch_stack\n"
+	".popsection\n"
+);
+#endif
+/*
+ * Creates a context for the calling thread's own execution, which other contexts can switch back to.
+ */
+CONTEXTHANDLE create_thread_context()
+{
+#ifdef _WIN32
+	return IsThreadAFiber() ? GetCurrentFiber() : ConvertThreadToFiber(NULL);
+#elif PLATFORM_SUPPORTS_CONTEXTS
+	// Filled in when we first switch away from it.
+	CONTEXTHANDLE context = calloc(1, sizeof(*(CONTEXTHANDLE)NULL));
+	if(context == NULL)
+		error("Can't create context.");
+	return context;
+#else
+	error("Contexts are not supported on this platform.");
+	return NULL;
+#endif
+}
+/*
+ * Creates a context (coroutine) with a stack of the given size, which executes the given function when first switched to.
+ * The function must never return, only switch to another context.
+ */
+CONTEXTHANDLE create_context(void (* function)(void), UINT stackSize)
+{
+#ifdef _WIN32
+	return CreateFiber(stackSize, (LPFIBER_START_ROUTINE)function, NULL);
+#elif PLATFORM_SUPPORTS_CONTEXTS && __x86_64__
+	struct PLATFORMCONTEXT* context = malloc(sizeof(struct PLATFORMCONTEXT));
+	if(context == NULL)
+		error("Can't create context.");
+	context->stack = malloc(stackSize);
+	if(context->stack == NULL)
+		error("Can't allocate context stack.");
+	return reset_context(context, function, stackSize);
+#elif PLATFORM_SUPPORTS_CONTEXTS
+	ucontext_t* context = malloc(sizeof(ucontext_t));
+	if(context == NULL)
+		error("Can't create context.");
+	context->uc_stack.ss_sp = malloc(stackSize);
+	if(context->uc_stack.ss_sp == NULL)
+		error("Can't allocate context stack.");
+	return reset_context(context, function, stackSize);
+#else
+	error("Contexts are not supported on this platform.");
+	return NULL;
+#endif
+}
+/*
+ * Restarts a context created by create_context() (which must not be the one executing), so it executes the given function from the start when next switched to.
+ * Returns the context to use from now on.
+ */
+CONTEXTHANDLE reset_context(CONTEXTHANDLE handle, void (* function)(void), UINT stackSize)
+{
+#ifdef _WIN32
+	DeleteFiber(handle);
+	return CreateFiber(stackSize, (LPFIBER_START_ROUTINE)function, NULL);
+#elif PLATFORM_SUPPORTS_CONTEXTS && __x86_64__
+	// The stack starts as if it switched away: six saved registers, then the function to return into (as if called, with no return address).
+	void** top = (void**)(((size_t)handle->stack + stackSize) & ~(size_t)0xF);
+	top[-1] = NULL;
+	top[-2] = (void*)function;
+	for(INT i = 3; i <= 8; i++)
+		top[-i] = NULL;
+	handle->stackPointer = &top[-8];
+	return handle;
+#elif PLATFORM_SUPPORTS_CONTEXTS
+	if(getcontext(handle) != 0)
+		error("Can't create context.");
+	handle->uc_stack.ss_size = stackSize;
+	handle->uc_link = NULL;
+	makecontext(handle, function, 0);
+	return handle;
+#else
+	return handle;
+#endif
+}
+/*
+ * Saves the executing context to the given current context, and continues executing the target context.
+ */
+void switch_context(CONTEXTHANDLE current, CONTEXTHANDLE target)
+{
+#ifdef _WIN32
+	SwitchToFiber(target);
+#elif PLATFORM_SUPPORTS_CONTEXTS && __x86_64__
+	platform_switch_stack(&current->stackPointer, target->stackPointer);
+#elif PLATFORM_SUPPORTS_CONTEXTS
+	swapcontext(current, target);
+#endif
+}
 /*
  * Obtains the current time.
  */
@@ -41,6 +41,7 @@
 	#else
 			// LINUX / Other
     	#include "GL/glut.h"
+    	#include "ucontext.h"
 			extern void glutCloseFunc(void (* function)(void)); // does not resolve with some versions of glut on linux.
 	#endif
 #endif
@@ -50,10 +51,29 @@
 // ---------------------------------
 #ifdef _WIN32
 	typedef HANDLE THREADHANDLE;
+	typedef LPVOID CONTEXTHANDLE;
 	typedef LARGE_INTEGER TIMEDATA;
+	#define PLATFORM_SUPPORTS_CONTEXTS	1
 #else
 	typedef pthread_t THREADHANDLE;
 	typedef struct timespec TIMEDATA;
+	#if __APPLE__
+		// ucontext is deprecated (and needs _XOPEN_SOURCE) on Mac OS.
+		typedef void* CONTEXTHANDLE;
+		#define PLATFORM_SUPPORTS_CONTEXTS	0
+	#elif __x86_64__
+		// Contexts switch by saving registers on their own stack (ucontext also saves the signal mask, with a system call).
+		struct PLATFORMCONTEXT
+		{
+			void* stackPointer; // the stack pointer saved when switching away.
+			void* stack; // the stack allocated for it (NULL for a thread's own context).
+		};
+		typedef struct PLATFORMCONTEXT* CONTEXTHANDLE;
+		#define PLATFORM_SUPPORTS_CONTEXTS	1
+	#else
+		typedef ucontext_t* CONTEXTHANDLE;
+		#define PLATFORM_SUPPORTS_CONTEXTS	1
+	#endif
 	typedef unsigned char BOOL;
 	#define TRUE	1
 	#define FALSE	0
@@ -71,6 +91,7 @@
 	typedef double DOUBLE;
 	#define min(a,b)	(a <= b ? a : b)
 	#define max(a,b)	(a >= b ? a : b)
+	#define FORCEINLINE	inline __attribute__((always_inline))
 #endif
 
 
@@ -82,6 +103,10 @@ void debug_log(const char *fmt, ...);
 void error(const char *fmt, ...);
 THREADHANDLE create_thread(void (* function)(void));
 void destroy_thread(THREADHANDLE handle);
+CONTEXTHANDLE create_thread_context();
+CONTEXTHANDLE create_context(void (* function)(void), UINT stackSize);
+CONTEXTHANDLE reset_context(CONTEXTHANDLE handle, void (* function)(void), UINT stackSize);
+void switch_context(CONTEXTHANDLE current, CONTEXTHANDLE target);
 void get_time(TIMEDATA* time);
 ULONGLONG get_time_difference(TIMEDATA* start, TIMEDATA* end);
 void thread_sleep(UINT milli);
@@ -18,12 +18,12 @@ void ppu_init()
 	ppuCycles = 0;
 	currentScanline = 0;
 	spritesOnCurrentLine = 0;
-	vramWriteToggle = TRUE;
 	vramReadValue = 0;
-	scrollX = 0;
-	scrollY = 0;
 	oamReadWriteAddress = 0;
-	vramReadWriteAddress = 0;
+	memset(&ppuRegisters, 0, sizeof(ppuRegisters));
+	scanlineDrawnDot = 0;
+	scanlineOriginDot = 0;
+	scanlineOriginAddr = 0;
 	frameCount = 0;
 	forceGreyscale = FALSE;
 	memset(&ppuStatus, 0, sizeof(ppuStatus));
@@ -60,6 +60,19 @@ void ppu_init()
 	UINT copySize = min(chrRomSize, PATTERN_TABLE_SIZE * 2);
 	memcpy(patternTablePtr, chrRom, copySize);
 
+	// Invalidate any tiles cached from previous data.
+	memset(&tileCache, 0, sizeof(tileCache));
+	tileCacheGeneration = 1;
+	tileCacheHits = tileCacheMisses = tileCacheEvictions = 0;
+
+	// Precompute our greyscale colors by averaging the color components of each palette color.
+	for(UINT i = 0; i < PALETTE_COLOR_COUNT; i++)
+	{
+		UINT paletteColor = palette[i];
+		paletteColor = ((paletteColor >> 8) & 0xFF) + ((paletteColor >> 16) & 0xFF) + ((paletteColor >> 24) & 0xFF);
+		greyscalePalette[i] = ((paletteColor / 3) * 0x01010100) | 0xFF;
+	}
+
 	debug_log("Picture Processing Unit (PPU) initialized...\n");
 }
 /*
@@ -71,7 +84,7 @@ BYTE ppu_get_status()
 	if (ppuStatus.spriteOverflow) status |= (1 << 5);
 	if (ppuStatus.sprite0Hit) status |= (1 << 6);
 	if (ppuStatus.verticalBlanking) status |= (1 << 7);
-	vramWriteToggle = TRUE;
+	ppuRegisters.w = FALSE;
 	return status;
 }
 /*
@@ -79,8 +92,11 @@ BYTE ppu_get_status()
  */
 void ppu_set_ctrl(BYTE data)
 {
-	if(ppuMask.showBackground || ppuCtrl.masterSlaveSelect != MASTERSLAVE_SLAVE)
-		ppuCtrl.baseNameTableIndex = data & 3; // 1st + 2nd bit.
+	// Draw the current scanline up to this point before the change takes effect.
+	ppu_draw_to_dot(ppuCycles);
+
+	// The nametable select bits (1st + 2nd bit) are stored in our temporary VRAM address.
+	ppuRegisters.t = (ppuRegisters.t & 0xF3FF) | ((USHORT)(data & 3) << 10);
 	ppuCtrl.vramAddrIncrements32 = ((data >> 2) & 1); // 3rd bit, determines increment of 1/32.
 	ppuCtrl.spritePatternTableIndex = (data >> 3) & 1; // 4th bit
 	ppuCtrl.backgroundPatternTableIndex = (data >> 4) & 1; // 5th bit
@@ -94,6 +110,9 @@ void ppu_set_ctrl(BYTE data)
  */
 void ppu_set_mask(BYTE data)
 {
+	// Draw the current scanline up to this point before the change takes effect.
+	ppu_draw_to_dot(ppuCycles);
+
 	// All 8 bits in order from lowest to highest.
 	ppuMask.greyscale = data & 1;
 	ppuMask.showBackgroundLeft = (data >> 1) & 1;
@@ -128,48 +147,80 @@ void ppu_set_oamdata(BYTE data)
 	dataArray[oamReadWriteAddress++] = data;
 }
 /*
- * Copies the entire OAM internal memory to the given CPU memory page number.
+ * Copies the given CPU memory page number into the OAM internal memory (starting at OAMADDR, as writes to OAMDATA would).
  */
 void ppu_oam_dma(BYTE pageNumber)
 {
 	// Copy a memory page from CPU memory to OAM memory.
+	// If the page is mapped to a buffer, copy it as a block, otherwise read it byte by byte.
 	BYTE* dataArray = (BYTE*)objectAttributeMemory;
-	USHORT cpuMemAddr = pageNumber * MEMORY_PAGE_SIZE;
-	for(USHORT i = 0; i < MEMORY_PAGE_SIZE; i++)
-		dataArray[i] = cpu_read8(cpuMemAddr + i);
+	BYTE* page = cpu_mem_translate_page(pageNumber);
+	if(page != NULL)
+	{
+		// We wrap around OAM, so copy in two parts.
+		memcpy(dataArray + oamReadWriteAddress, page, MEMORY_PAGE_SIZE - oamReadWriteAddress);
+		memcpy(dataArray, page + (MEMORY_PAGE_SIZE - oamReadWriteAddress), oamReadWriteAddress);
+	}
+	else
+	{
+		USHORT cpuMemAddr = pageNumber * MEMORY_PAGE_SIZE;
+		for(USHORT i = 0; i < MEMORY_PAGE_SIZE; i++)
+			dataArray[(BYTE)(oamReadWriteAddress + i)] = cpu_read8(cpuMemAddr + i);
+	}
+
+	// The CPU is stalled during the transfer, with an extra cycle to align if the DMA starts on an odd cycle.
+	// (OAMDMA is written by 4 cycle stores, so the DMA starts with the same parity as the cycle count before the store)
+	// https://wiki.nesdev.com/w/index.php/PPU_registers#OAMDMA
+	cpuStallCycles += CPU_OAM_DMA_STALL_CYCLES + (cpuCyclesTotal & 1);
 }
 /*
- * Sets either X or Y scroll value depending on the PPU high/low toggle.
+ * Sets either X or Y scroll value (in the temporary VRAM address/fine X) depending on the PPU write toggle.
  */
 void ppu_set_ppuscroll(BYTE data)
 {
+	// Draw the current scanline up to this point before the change takes effect.
+	ppu_draw_to_dot(ppuCycles);
+
 	// Set the appropriate scroll value based off of our write toggle
-	if(!vramWriteToggle)
+	if(!ppuRegisters.w)
 	{
-		scrollY = data;
-		if(scrollY >= RESOLUTION_HEIGHT)
-			scrollY = 0;
+		// X scroll: coarse X goes into our temporary address, fine X into its own register.
+		ppuRegisters.t = (ppuRegisters.t & ~0x001F) | (data >> 3);
+		ppuRegisters.x = data & 7;
 	}
 	else
 	{
-		scrollX = data;
+		// Y scroll: fine Y and coarse Y go into our temporary address.
+		ppuRegisters.t = (ppuRegisters.t & ~0x73E0) | ((USHORT)(data & 7) << 12) | ((USHORT)(data & 0xF8) << 2);
 	}
 
 	// Toggle our write toggle.
-	vramWriteToggle = !vramWriteToggle;
+	ppuRegisters.w = !ppuRegisters.w;
 }
 /*
- * Sets the either the high or low byte of the PPUADDR register (depending on PPU high/low toggle), used to read/write memory from PPU
+ * Sets the either the high or low byte of the PPUADDR register (depending on PPU write toggle), used to read/write memory from PPU.
+ * PPUADDR shares the temporary VRAM address with PPUSCROLL, the second write copies it into the current VRAM address.
  */
 void ppu_set_ppuaddr(BYTE data)
 {
+	// Draw the current scanline up to this point before the change takes effect.
+	ppu_draw_to_dot(ppuCycles);
+
 	// Set the appropriate high/low byte for the PPU address based off write toggle
-	if(vramWriteToggle)
-		vramReadWriteAddress = (USHORT)data << 8;
+	if(!ppuRegisters.w)
+	{
+		ppuRegisters.t = (ppuRegisters.t & 0x00FF) | ((USHORT)(data & 0x3F) << 8);
+	}
 	else
-		vramReadWriteAddress = (vramReadWriteAddress & 0xFF00) | (USHORT)data;
-	vramWriteToggle = !vramWriteToggle;
-	// TODO: Check this. PPUSCROLL and PPUADDR use the same internal register and must be cleared after use, but we implement separately.
+	{
+		ppuRegisters.t = (ppuRegisters.t & 0xFF00) | data;
+		ppuRegisters.v = ppuRegisters.t;
+
+		// The rest of the current scanline is drawn from our new address.
+		scanlineOriginAddr = ppuRegisters.v;
+		scanlineOriginDot = ppuCycles;
+	}
+	ppuRegisters.w = !ppuRegisters.w;
 }
 /*
  * Reads a byte from the PPU memory space at the given PPUADDR.
@@ -179,19 +230,19 @@ BYTE ppu_get_data()
 	// If we read in our palette memory range, we return that value immediately.
 	// Otherwise we read to an internal memory buffer and return the previous buffer value.
 	BYTE result = 0;
-	USHORT vramRWAddrNM = ppu_get_non_mirrored_addr(vramReadWriteAddress);
+	USHORT vramRWAddrNM = ppu_get_non_mirrored_addr(ppuRegisters.v);
 	if(vramRWAddrNM >= PALETTE_ADDRS_START && vramRWAddrNM < PALETTE_ADDRS_END)
 	{
-		result = ppu_read8(vramReadWriteAddress);
+		result = ppu_read8(ppuRegisters.v);
 	}
 	else
 	{
 		result = vramReadValue;
-		vramReadValue = ppu_read8(vramReadWriteAddress);
+		vramReadValue = ppu_read8(ppuRegisters.v);
 	}
 
 	// Increment our address with our provided increment value.
-	vramReadWriteAddress += ppuCtrl.vramAddrIncrements32 ? 32 : 1;
+	ppuRegisters.v += ppuCtrl.vramAddrIncrements32 ? 32 : 1;
 	return result;
 }
 /*
@@ -200,10 +251,112 @@ BYTE ppu_get_data()
 void ppu_set_data(BYTE data)
 {
 	// Write the given data.
-	ppu_write8(vramReadWriteAddress, data);
+	ppu_write8(ppuRegisters.v, data);
 
 	// Increment our address with our provided increment value.
-	vramReadWriteAddress += ppuCtrl.vramAddrIncrements32 ? 32 : 1;
+	ppuRegisters.v += ppuCtrl.vramAddrIncrements32 ? 32 : 1;
+}
+/*
+ * Writes a run of bytes to the PPU memory space starting at PPUADDR, as consecutive writes to PPUDATA would.
+ * (Contiguous nametable/pattern table memory is written directly, rather than translating every address)
+ */
+void ppu_write_data_block(const BYTE* data, UINT count)
+{
+	USHORT increment = ppuCtrl.vramAddrIncrements32 ? 32 : 1;
+	while(count > 0)
+	{
+		// Determine where the contiguous memory for our current address ends.
+		// Palette memory is irregularly mapped, so we write it byte by byte.
+		USHORT addr = ppuRegisters.v % 0x4000;
+		USHORT endAddr;
+		if(addr < PATTERNTABLE_ADDR_END)
+			endAddr = PATTERNTABLE_ADDR_END;
+		else if(addr < PALETTE_ADDRS_START)
+			endAddr = min((USHORT)((addr & ~(NAMETABLE_SIZE - 1)) + NAMETABLE_SIZE), (USHORT)PALETTE_ADDRS_START);
+		else
+		{
+			ppu_set_data(*data++);
+			count--;
+			continue;
+		}
+
+		// Write every byte we can until the end of our contiguous memory.
+		UINT runCount = min(count, (UINT)((endAddr - addr + increment - 1) / increment));
+		BYTE* ptr = ppu_mem_translate(ppu_get_non_mirrored_addr(addr));
+		BOOL changed = FALSE;
+		for(UINT i = 0; i < runCount; i++)
+		{
+			changed |= ptr[i * increment] != data[i];
+			ptr[i * increment] = data[i];
+		}
+
+		// If this changed pattern table data, our resolved background tiles are no longer valid.
+		if(changed && IS_TILE_CACHE_MEMORY(addr))
+			ppu_invalidate_tile_cache();
+
+		ppuRegisters.v += runCount * increment;
+		data += runCount;
+		count -= runCount;
+	}
+}
+/*
+ * Writes the given byte to the PPU memory space the given amount of times starting at PPUADDR,
+ * as consecutive writes of the same value to PPUDATA would.
+ */
+void ppu_fill_data(BYTE data, UINT count)
+{
+	BYTE block[MEMORY_PAGE_SIZE];
+	memset(block, data, sizeof(block));
+	while(count > 0)
+	{
+		UINT blockCount = min(count, (UINT)sizeof(block));
+		ppu_write_data_block(block, blockCount);
+		count -= blockCount;
+	}
+}
+/*
+ * Increments the vertical scroll position in the current VRAM address (done at the end of every rendered scanline).
+ */
+void ppu_increment_vertical()
+{
+	USHORT v = ppuRegisters.v;
+	if(VRAM_ADDR_FINE_Y(v) < 7)
+	{
+		// Move to the next row of pixels in our tiles.
+		v += 0x1000;
+	}
+	else
+	{
+		// Move to the next row of tiles. Row 29 is the last row of a nametable, so we wrap into the vertically adjacent nametable.
+		// Rows 30 and 31 are in the attribute table, if scrolled there we wrap within the same nametable.
+		v &= ~0x7000;
+		USHORT coarseY = VRAM_ADDR_COARSE_Y(v);
+		if(coarseY == RESOLUTION_TILES_HEIGHT - 1)
+		{
+			coarseY = 0;
+			v ^= 0x0800;
+		}
+		else if(coarseY == 31)
+			coarseY = 0;
+		else
+			coarseY++;
+		v = (v & ~0x03E0) | (coarseY << 5);
+	}
+	ppuRegisters.v = v;
+}
+/*
+ * Copies the horizontal scroll position from the temporary VRAM address into the current VRAM address.
+ */
+void ppu_copy_horizontal()
+{
+	ppuRegisters.v = (ppuRegisters.v & ~VRAM_ADDR_HORIZONTAL_MASK) | (ppuRegisters.t & VRAM_ADDR_HORIZONTAL_MASK);
+}
+/*
+ * Copies the vertical scroll position from the temporary VRAM address into the current VRAM address.
+ */
+void ppu_copy_vertical()
+{
+	ppuRegisters.v = (ppuRegisters.v & ~VRAM_ADDR_VERTICAL_MASK) | (ppuRegisters.t & VRAM_ADDR_VERTICAL_MASK);
 }
 /*
  * Obtains the color for the given color index in our palette.
@@ -212,33 +365,94 @@ void ppu_set_data(BYTE data)
 UINT ppu_get_color(BYTE paletteColorIndex)
 {
 	// Retrieve the color (with a bounded index, ignore all upper bits out of range).
-	UINT paletteColor = palette[paletteColorIndex & 0x3F];
-
-	// Handle PPUMASK's greyscale flag as well.
+	// Greyscale colors are precomputed on initialization (see ppu_init).
 	if(ppuMask.greyscale || forceGreyscale)
+		return greyscalePalette[paletteColorIndex & 0x3F];
+	return palette[paletteColorIndex & 0x3F];
+}
+/*
+ * Invalidates every tile in the tile cache.
+ * (Called when pattern table or background palette data changes).
+ */
+void ppu_invalidate_tile_cache()
+{
+	tileCacheGeneration++;
+}
+/*
+ * Obtains a background tile fully resolved to RGBA colors from the tile cache, resolving it on a miss.
+ */
+struct TILECACHEENTRY* ppu_get_cached_tile(UINT patternTableIndex, BYTE tileIndex, BYTE paletteIndex, BOOL greyscale)
+{
+	// Our key identifies everything that determines the resolved colors of the tile.
+	UINT key = ((greyscale != 0) << 11) | (patternTableIndex << 10) | (paletteIndex << 8) | tileIndex;
+	struct TILECACHEENTRY* entry = &tileCache[(key ^ (key >> 10)) & (TILE_CACHE_SIZE - 1)];
+	if(entry->generation == tileCacheGeneration)
 	{
-		// Average the color components for greyscale
-		paletteColor = ((paletteColor >> 8) & 0xFF) + ((paletteColor >> 16) & 0xFF) + ((paletteColor >> 24) & 0xFF);
-		paletteColor = ((paletteColor / 3) * 0x01010100) | 0xFF;
-	}
+		if(entry->key == key)
+		{
+			tileCacheHits++;
+			return entry;
+		}
 
-	return paletteColor;
+		// A valid tile was in this slot, we're replacing it.
+		tileCacheEvictions++;
+	}
+	tileCacheMisses++;
+	entry->key = key;
+	entry->generation = tileCacheGeneration;
+
+	// Resolve every pixel of the tile. Transparent pixels resolve to the universal background color.
+	const UINT* colors = greyscale ? greyscalePalette : palette;
+	BYTE* paletteColorIndexes = backgroundColorPalette[paletteIndex].paletteColorIndex;
+	UINT universalColor = colors[universalBackgroundColor & 0x3F];
+	BYTE* patternTableTile = patternTables[patternTableIndex] + (tileIndex * 0x10);
+	for(UINT rowIndex = 0; rowIndex < PATTERN_TABLE_TILE_HEIGHT; rowIndex++)
+	{
+		// Obtain the low and high byte from the pattern table which describe the colors for the 8x1 row.
+		// Each pixel is 2 bits, one bit from each byte.
+		BYTE tileColorLowByte = patternTableTile[rowIndex];
+		BYTE tileColorHighByte = patternTableTile[rowIndex + 8];
+		for(UINT pixelIndex = 0; pixelIndex < PATTERN_TABLE_TILE_WIDTH; pixelIndex++)
+		{
+			// Our color index is two bits, a high bit from high byte, low bit from low byte.
+			// The higher bits are for lower pixel indexes.
+			BYTE colorIndex = (tileColorLowByte >> (7 - pixelIndex)) & 1;
+			colorIndex |= ((tileColorHighByte >> (7 - pixelIndex)) & 1) << 1;
+
+			// Color offset 0 means transparent, anything else indexes into the target background color palettes colors.
+			UINT offset = (rowIndex * PATTERN_TABLE_TILE_WIDTH) + pixelIndex;
+			entry->opaque[offset] = colorIndex > 0;
+			entry->pixels[offset] = colorIndex > 0 ? colors[paletteColorIndexes[colorIndex - 1] & 0x3F] : universalColor;
+		}
+	}
+	return entry;
+}
+/*
+ * Reverses the bits in a pattern table byte (used to flip sprites horizontally once, instead of per pixel).
+ */
+static FORCEINLINE BYTE ppu_reverse_bits(BYTE value)
+{
+	value = (BYTE)(((value & 0xF0) >> 4) | ((value & 0x0F) << 4));
+	value = (BYTE)(((value & 0xCC) >> 2) | ((value & 0x33) << 2));
+	value = (BYTE)(((value & 0xAA) >> 1) | ((value & 0x55) << 1));
+	return value;
 }
 
 /*
- * Updates the framebuffer by drawing the appropriate sprite layer on it.
- * The given priority is either 0 (top layer), 1 (behind background) and is determined in OAM Entry attributes.
+ * Draws the sprites with the given priority on the given pixels of the current scanline.
+ * This is the template every sprite renderer variant is generated from: the remaining arguments are
+ * compile time constants in each variant, so the checks on them are removed from the per-pixel loop.
  */
-void ppu_draw_sprites(BYTE priority)
+static FORCEINLINE void ppu_draw_sprites_scanline(BYTE priority, BOOL doubleSpriteHeight, BOOL clipLeft, BOOL greyscale, UINT startPixel, UINT endPixel)
 {
 	/*
 	 * References:
 	 * https://wiki.nesdev.com/w/index.php/PPU_OAM
 	 */
 	// Calculate our sprite height based off of our flags.
-	BYTE spriteHeight = SPRITE_HEIGHT;
-	if(ppuCtrl.doubleSpriteHeight)
-		spriteHeight *= 2;
+	const UINT* colors = greyscale ? greyscalePalette : palette;
+	BYTE spriteHeight = doubleSpriteHeight ? (SPRITE_HEIGHT * 2) : SPRITE_HEIGHT;
+	UINT* frameBufferRow = internalFrameBuffer + (currentScanline * RESOLUTION_WIDTH);
 
 	// Items earlier in the OAM table are drawn in front.
 	for(int spriteIndex = OAM_TABLE_COUNT - 1; spriteIndex >= 0; spriteIndex--)
@@ -246,22 +460,24 @@ void ppu_draw_sprites(BYTE priority)
 		// Obtain all relevant values for rendering.
 		struct OAMEntry oamEntry = objectAttributeMemory[spriteIndex];
 		BYTE y = oamEntry.Y + 1; // y is off by 1.
-		BYTE x = oamEntry.X;
+		UINT x = oamEntry.X; // unsigned, like the pixel bounds it is compared with.
 
 		// If the current sprite isn't on this scanline, skip to the next sprite.
 		if(y > currentScanline || (y + spriteHeight <= currentScanline))
 			continue;
 
-		// Obtain our flags from our attributes byte
-		BYTE paletteIndex = oamEntry.attributes & 3;
-		BYTE spritePriority = (oamEntry.attributes >> 5) & 1;
-
 		// If we're not rendering with the appropriate priority, skip to the next sprite.
+		BYTE spritePriority = (oamEntry.attributes >> 5) & 1;
 		if(spritePriority != priority)
 			continue;
 
-		// At this point we know we'll render the sprite on this scanline.
-		spritesOnCurrentLine++;
+		// At this point we know we'll render the sprite on this scanline (count it once, in the first segment).
+		if(startPixel == 0)
+			spritesOnCurrentLine++;
+
+		// If the sprite is entirely outside of the pixels we're drawing, skip to the next sprite.
+		if(x >= endPixel || x + SPRITE_WIDTH <= startPixel)
+			continue;
 
 		// If we already have 8 sprites drawn, stop drawing
 		// TODO: This is supposed to be implemented in this fashion, yet gives undesired effects..? Used documentation was likely wrong.
@@ -269,6 +485,7 @@ void ppu_draw_sprites(BYTE priority)
 		//	return;
 
 		// Obtain our remaining flags.
+		BYTE paletteIndex = oamEntry.attributes & 3;
 		BOOL flipHorizontal = (oamEntry.attributes >> 6) & 1;
 		BOOL flipVertical = (oamEntry.attributes >> 7);
 
@@ -282,11 +499,10 @@ void ppu_draw_sprites(BYTE priority)
 		else
 			spriteLineY = (y + spriteHeight) - (currentScanline + 1);
 
-
 		// Next determine the offset of our tile in our pattern table.
 		// 8x8 sprites use PPUCTRL for pattern table index, 8x16 use bit 0 of ID.
 		UINT patternTableIndex = ppuCtrl.spritePatternTableIndex;
-		if(ppuCtrl.doubleSpriteHeight)
+		if(doubleSpriteHeight)
 		{
 			// Pattern table index comes from bit 0 of our ID for 8x16 tiles.
 			patternTableIndex = spriteID & 1;
@@ -305,55 +521,66 @@ void ppu_draw_sprites(BYTE priority)
 		// Our ID is our index, each 8x8 pixel tile is represented as 0x10 bytes (look at background rendering method for more info).
 		UINT patternTableTileOffset = (spriteID * 0x10) + spriteLineY;
 
-    	// Obtain the low and high byte from the pattern table which describe the colors for the 8x8 tile.
-    	// Each 8x1 row comes from 2 bytes (16 bits). Each pixel is 2 bits, one bit from each byte.
+		// Obtain the low and high byte from the pattern table which describe the colors for the 8x8 tile.
+		// Each 8x1 row comes from 2 bytes (16 bits). Each pixel is 2 bits, one bit from each byte.
+		// Flipping horizontally is done once here by reversing the bits of both bytes.
 		assert(patternTableTileOffset < PATTERN_TABLE_SIZE, "Pattern Table access out of bounds.");
-    	BYTE tileColorLowByte = patternTables[patternTableIndex][patternTableTileOffset];
-    	BYTE tileColorHighByte = patternTables[patternTableIndex][patternTableTileOffset + 8];
-
-    	// Loop for every pixel to render.
-    	for(int spritePixelX = 0; spritePixelX < SPRITE_WIDTH; spritePixelX++)
-    	{
-    		// If our X coordinate we're drawing to is outside of the frameBuffer, stop.
-    		// If we're rendering first 8 pixels of screen and we're not meant to for sprites, stop.
-    		if(x + spritePixelX >= RESOLUTION_WIDTH)
-    			continue;
-    		else if((x + spritePixelX) < 8 && !ppuMask.showSpritesLeft)
-    			continue;
-
-    		// Our color index is two bits, a high bit from high byte, low bit from low byte.
-    		// The higher bits are for lower pixel indexes.
-    		// We take into account our flip horizontal flag here to flip the color to obtain.
-    		BYTE pixelIndex = flipHorizontal ? (7 - spritePixelX) : spritePixelX;
-    		BYTE colorIndex = (tileColorLowByte >> (7 - pixelIndex)) & 1;
-    		colorIndex |= ((tileColorHighByte >> (7 - pixelIndex)) & 1) << 1;
-
-    		// Color offset 0 means transparent, anything else indexes into the target sprite color palettes colors.
-    		if(colorIndex > 0)
-    		{
-    			// If we're rendering our first sprite's scanline, set our flag.
-    			if(spriteIndex == 0)
-    				ppuStatus.sprite0Hit = TRUE;
-
-    			// Read the color index which indexes into the NES internal color palette, and obtain the color.
-    			BYTE paletteColorIndex = spriteColorPalette[paletteIndex].paletteColorIndex[colorIndex - 1] & 0x3F;
-    			UINT rgbaColor =  ppu_get_color(paletteColorIndex);
-
-				// Determine our position in the frame buffer
-				UINT frameBufferRowOffset = currentScanline * RESOLUTION_WIDTH;
-				UINT frameBufferPixelOffset = frameBufferRowOffset + x + spritePixelX;
-
-				// Output our pixel.
-				assert(sizeof(internalFrameBuffer) > frameBufferPixelOffset, "Internal framebuffer drawing out of bounds.");
-				internalFrameBuffer[frameBufferPixelOffset] = rgbaColor;
-    		}
-    	}
+		BYTE tileColorLowByte = patternTables[patternTableIndex][patternTableTileOffset];
+		BYTE tileColorHighByte = patternTables[patternTableIndex][patternTableTileOffset + 8];
+		if(flipHorizontal)
+		{
+			tileColorLowByte = ppu_reverse_bits(tileColorLowByte);
+			tileColorHighByte = ppu_reverse_bits(tileColorHighByte);
+		}
+
+		// Determine which pixels are visible: pixels outside of the pixels we're drawing aren't drawn,
+		// and neither are the first 8 pixels of the screen if we're clipping sprites on the left.
+		// Bit 7 of our mask represents the leftmost pixel, matching the pattern table bytes.
+		BYTE visibleMask = tileColorLowByte | tileColorHighByte;
+		UINT leftPixel = (clipLeft && startPixel < 8) ? 8 : startPixel;
+		if(x + SPRITE_WIDTH <= leftPixel)
+			continue;
+		if(x < leftPixel)
+			visibleMask &= 0xFF >> (leftPixel - x);
+		if(x + SPRITE_WIDTH > endPixel)
+			visibleMask &= 0xFF << ((x + SPRITE_WIDTH) - endPixel);
+
+		// Color offset 0 means transparent, so if no pixels are left to draw, skip to the next sprite.
+		if(visibleMask == 0)
+			continue;
+
+		// If we're rendering our first sprite's scanline, set our flag.
+		if(spriteIndex == 0)
+			ppuStatus.sprite0Hit = TRUE;
+
+		// Loop for every pixel to render.
+		BYTE* paletteColorIndexes = spriteColorPalette[paletteIndex].paletteColorIndex;
+		UINT* spriteOutput = frameBufferRow + x;
+		for(int spritePixelX = 0; spritePixelX < SPRITE_WIDTH; spritePixelX++)
+		{
+			// Our color index is two bits, a high bit from high byte, low bit from low byte.
+			// The higher bits are for lower pixel indexes.
+			if(!((visibleMask >> (7 - spritePixelX)) & 1))
+				continue;
+
+			// Sprites behind the background are only visible where the background is transparent.
+			if(priority && backgroundOpaque[x + spritePixelX])
+				continue;
+			BYTE colorIndex = (tileColorLowByte >> (7 - spritePixelX)) & 1;
+			colorIndex |= ((tileColorHighByte >> (7 - spritePixelX)) & 1) << 1;
+
+			// Read the color index which indexes into the NES internal color palette, and output our pixel.
+			spriteOutput[spritePixelX] = colors[paletteColorIndexes[colorIndex - 1] & 0x3F];
+		}
 	}
 }
 /*
- * Updates the framebuffer by drawing the background layer onto it.
+ * Draws the background layer on the given pixels of the current scanline, from the VRAM address at the scanline origin.
+ * This is the template every background renderer variant is generated from: the remaining arguments are
+ * compile time constants in each variant. Aligned variants are only used when fine X scroll is 0 for the
+ * whole scanline, so every tile is drawn in full and there is no partial tile on either edge.
  */
-void ppu_draw_background()
+static FORCEINLINE void ppu_draw_background_scanline(BOOL aligned, BOOL greyscale, UINT startPixel, UINT endPixel)
 {
 	/*
 	 * Notes:
@@ -379,101 +606,235 @@ void ppu_draw_background()
 	 * https://opcode-defined.quora.com/How-NES-Graphics-Work-Nametables
 	 * https://wiki.nesdev.com/w/index.php/PPU_attribute_tables
 	 */
-	// Obtain our name table
-	UINT y = currentScanline + scrollY;
-
-    // Each scanline can have a maximum of two nametables it enters
-    // (it can enter another nametable horizontally depending on scrollX)
-    UINT nameTableIndexes[2];
-    nameTableIndexes[0] = ppuCtrl.baseNameTableIndex;
-    // If we overflow past our base name table into another via Y coordinate, calculate our indexes.
-    if(y >= RESOLUTION_HEIGHT)
-    {
-    	// We're in the bottom left instead of top right
-    	nameTableIndexes[0] += 2;
-    	nameTableIndexes[0] %= 4;
-    }
-    // The second table is the one adjacent to the first.
-    nameTableIndexes[1] = ((nameTableIndexes[0] / 2) * 2) + (1 - (nameTableIndexes[0] % 2));
-
-    // Figure out our column numbers (normally 0-32) with respect to wrapping into another nametable (0-64).
-    UINT startColumn = scrollX / PATTERN_TABLE_TILE_WIDTH;
-    UINT endColumn = startColumn + RESOLUTION_TILES_WIDTH;
-
-    for (UINT columnIndex = startColumn; columnIndex < endColumn + 1; columnIndex++)
-    {
-    	// TODO: Revisit this, maybe timing is wrong but StarsSE toggles this and it causes a stuttering effect. Not important for now.
-    	// If we're not supposed to render the first 8 pixel tiles of the background, and we are the first 8 pixel wide tile, skip.
-    	//if(columnIndex == startColumn && !ppuMask.showBackgroundLeft)
-    	//	continue;
-
-    	// Determine if we're rendering in the first or second nametable (can be two if we scrolled).
-    	UINT nameTableIndexesIndex = columnIndex >= RESOLUTION_TILES_WIDTH;
-    	UINT nameTableIndex = nameTableIndexes[nameTableIndexesIndex];
-    	UINT columnInNametable = columnIndex % RESOLUTION_TILES_WIDTH;
-    	UINT tileIndexY = (y / PATTERN_TABLE_TILE_HEIGHT);
-
-    	// Obtain the offset of the nametable cell which points to an index in the pattern table which describes an 8x8 tile.
-    	UINT nameTableCellOffset = (tileIndexY * RESOLUTION_TILES_WIDTH) + columnInNametable;
-    	UINT patternTableTileIndex = nameTables[nameTableIndex]->cells[nameTableCellOffset];
-    	UINT patternTableTileOffset = (patternTableTileIndex * 0x10) + (y % PATTERN_TABLE_TILE_HEIGHT);
-
-    	// Determine which palette to use by obtaining an attribute byte.
-    	// Every attribute byte describes 4x4 tiles (32x32 pixels), we divide by 4 to get from tile indexes to attribute byte positions.
+	UINT* frameBufferRow = internalFrameBuffer + (currentScanline * RESOLUTION_WIDTH);
+
+	// Obtain our vertical position from the VRAM address (this is the same for the entire scanline).
+	USHORT addr = scanlineOriginAddr;
+	UINT tileIndexY = VRAM_ADDR_COARSE_Y(addr);
+	UINT tileRowY = VRAM_ADDR_FINE_Y(addr);
+	UINT nameTableY = VRAM_ADDR_NAMETABLE(addr) & 2;
+
+	// Obtain our horizontal position across the two horizontally adjacent nametables (0-511).
+	// We draw from left to right, so this increments with every pixel since the origin.
+	UINT positionX = ((VRAM_ADDR_NAMETABLE(addr) & 1) * RESOLUTION_WIDTH) + (VRAM_ADDR_COARSE_X(addr) * PATTERN_TABLE_TILE_WIDTH);
+	positionX += ppuRegisters.x + (startPixel - scanlineOriginDot);
+
+	UINT pixel = startPixel;
+	while(pixel < endPixel)
+	{
+		// TODO: Revisit this, maybe timing is wrong but StarsSE toggles this and it causes a stuttering effect. Not important for now.
+		// If we're not supposed to render the first 8 pixel tiles of the background, and we are the first 8 pixel wide tile, skip.
+		//if(pixel < 8 && !ppuMask.showBackgroundLeft)
+		//	continue;
+
+		// Determine which nametable we're rendering in (we cross into the adjacent one when scrolled horizontally).
+		positionX %= RESOLUTION_WIDTH * 2;
+		struct NAMETABLE* nameTable = nameTables[nameTableY | (positionX / RESOLUTION_WIDTH)];
+		UINT columnInNametable = (positionX / PATTERN_TABLE_TILE_WIDTH) % RESOLUTION_TILES_WIDTH;
+
+		// Obtain the offset of the nametable cell which points to an index in the pattern table which describes an 8x8 tile.
+		// (Rows 30 and 31 are past the cells and read from the attribute table, as the PPU does).
+		UINT nameTableCellOffset = (tileIndexY * RESOLUTION_TILES_WIDTH) + columnInNametable;
+		BYTE patternTableTileIndex = ((BYTE*)nameTable)[nameTableCellOffset];
+
+		// Determine which palette to use by obtaining an attribute byte.
+		// Every attribute byte describes 4x4 tiles (32x32 pixels), we divide by 4 to get from tile indexes to attribute byte positions.
 		// Every row is 32 tiles, so 8 attribute bytes. Using column number as X coordinate, we can obtain the appropriate attribute byte.
 		// Recall, this byte describes 4x4 tiles, so each 2x2 tile's palette index is 2 bits in order from lowest to highest: top left, top right, bottom left, bottom right.
 		// We shift according to which tile we're in (2 * positionIndex) where positionIndex is the index in the positions mentioned above.
 		// Since positionIndex can be 0-3, we use 2 bits, the high bit can be determined if we're in the second nametable on the Y axis, the low bit by the same on X axis.
-    	BYTE paletteIndex = nameTables[nameTableIndex]->attributes[((tileIndexY / 4) * (32 / 4)) + (columnInNametable / 4)];
+		BYTE paletteIndex = nameTable->attributes[((tileIndexY / 4) * (32 / 4)) + (columnInNametable / 4)];
 		paletteIndex = (BYTE)(paletteIndex >> ((2 * ((columnInNametable % 4) / 2)) | (4 * ((tileIndexY % 4) / 2)))) & 3;
 
-    	// Obtain the low and high byte from the pattern table which describe the colors for the 8x8 tile.
-    	// Each 8x1 row comes from 2 bytes (16 bits). Each pixel is 2 bits, one bit from each byte.
-    	BYTE tileColorLowByte = patternTables[ppuCtrl.backgroundPatternTableIndex][patternTableTileOffset];
-    	BYTE tileColorHighByte = patternTables[ppuCtrl.backgroundPatternTableIndex][patternTableTileOffset + 8];
-
-    	// Determine which pixels of this tile to render.
-    	// If we're on the first or last tile, we can be offset by a few pixels.
-    	// Tiles are 8 pixels, so determining offset is simple by using scroll value.
-    	BYTE startPixel = 0;
-        BYTE endPixel = 8;
-        if(columnIndex == startColumn)
-        	startPixel = scrollX % PATTERN_TABLE_TILE_WIDTH;
-        else if(columnIndex == endColumn)
-        	endPixel = scrollX % PATTERN_TABLE_TILE_WIDTH;
-
-        // Loop for each pixel in the row to render.
-        for (int pixelIndex = startPixel; pixelIndex < endPixel; pixelIndex++)
-        {
-        	// Our color index is two bits, a high bit from high byte, low bit from low byte.
-        	// The higher bits are for lower pixel indexes.
-        	BYTE colorIndex = (tileColorLowByte >> (7 - pixelIndex)) & 1;
-        	colorIndex |= ((tileColorHighByte >> (7 - pixelIndex)) & 1) << 1;
-
-        	// Color offset 0 means transparent, anything else indexes into the target background color palettes colors.
-            if(colorIndex > 0)
-            {
-            	// Read the color index which indexes into the NES internal color palette, and obtain the color.
-            	BYTE paletteColorIndex = backgroundColorPalette[paletteIndex].paletteColorIndex[colorIndex - 1] & 0x3F;
-				UINT rgbaColor =  ppu_get_color(paletteColorIndex);
-
-				// Determine our position in the frame buffer
-				UINT frameBufferRowOffset = currentScanline * RESOLUTION_WIDTH;
-				UINT frameBufferTileOffset = frameBufferRowOffset + (8 * columnInNametable);
-				UINT frameBufferPixelOffset;
-
-				// If we are rendering in the second name table, our scroll comes from the other end.
-				if (nameTableIndexesIndex == 0)
-					frameBufferPixelOffset = frameBufferTileOffset + pixelIndex - scrollX;
-				else
-					frameBufferPixelOffset = frameBufferTileOffset + pixelIndex + (RESOLUTION_WIDTH - scrollX);
+		// Obtain the resolved tile from our cache.
+		struct TILECACHEENTRY* tile = ppu_get_cached_tile(ppuCtrl.backgroundPatternTableIndex, patternTableTileIndex, paletteIndex, greyscale);
+		UINT tileRowOffset = tileRowY * PATTERN_TABLE_TILE_WIDTH;
+
+		// Determine which pixels of this tile to render.
+		// If we're on the first or last tile, we can be offset by a few pixels.
+		UINT tilePixel = aligned ? 0 : (positionX % PATTERN_TABLE_TILE_WIDTH);
+		UINT pixelCount = aligned ? PATTERN_TABLE_TILE_WIDTH : min(PATTERN_TABLE_TILE_WIDTH - tilePixel, endPixel - pixel);
+
+		// Copy the row of the tile (transparent pixels are already resolved to the universal background color).
+		memcpy(frameBufferRow + pixel, tile->pixels + tileRowOffset + tilePixel, pixelCount * sizeof(UINT));
+		memcpy(backgroundOpaque + pixel, tile->opaque + tileRowOffset + tilePixel, pixelCount);
+		pixel += pixelCount;
+		positionX += pixelCount;
+	}
+}
+
+// Generate every renderer variant from the templates above.
+#define PPU_SPRITE_RENDERER(doubleSpriteHeight, clipLeft, greyscale) ppu_draw_sprites_h##doubleSpriteHeight##_c##clipLeft##_g##greyscale
+#define PPU_DEFINE_SPRITE_RENDERER(doubleSpriteHeight, clipLeft, greyscale) \
+	static void PPU_SPRITE_RENDERER(doubleSpriteHeight, clipLeft, greyscale)(BYTE priority) \
+	{ ppu_draw_sprites_scanline(priority, doubleSpriteHeight, clipLeft, greyscale, 0, RESOLUTION_WIDTH); }
+#define PPU_BACKGROUND_RENDERER(aligned, greyscale) ppu_draw_background_a##aligned##_g##greyscale
+#define PPU_DEFINE_BACKGROUND_RENDERER(aligned, greyscale) \
+	static void PPU_BACKGROUND_RENDERER(aligned, greyscale)() \
+	{ ppu_draw_background_scanline(aligned, greyscale, 0, RESOLUTION_WIDTH); }
+
+PPU_DEFINE_SPRITE_RENDERER(0, 0, 0)
+PPU_DEFINE_SPRITE_RENDERER(0, 0, 1)
+PPU_DEFINE_SPRITE_RENDERER(0, 1, 0)
+PPU_DEFINE_SPRITE_RENDERER(0, 1, 1)
+PPU_DEFINE_SPRITE_RENDERER(1, 0, 0)
+PPU_DEFINE_SPRITE_RENDERER(1, 0, 1)
+PPU_DEFINE_SPRITE_RENDERER(1, 1, 0)
+PPU_DEFINE_SPRITE_RENDERER(1, 1, 1)
+PPU_DEFINE_BACKGROUND_RENDERER(0, 0)
+PPU_DEFINE_BACKGROUND_RENDERER(0, 1)
+PPU_DEFINE_BACKGROUND_RENDERER(1, 0)
+PPU_DEFINE_BACKGROUND_RENDERER(1, 1)
+
+/*
+ * Sprite renderer variants, indexed by [doubleSpriteHeight][clipLeft][greyscale].
+ */
+SpriteScanlineRenderer spriteScanlineRenderers[2][2][2] =
+{
+	{
+		{ PPU_SPRITE_RENDERER(0, 0, 0), PPU_SPRITE_RENDERER(0, 0, 1) },
+		{ PPU_SPRITE_RENDERER(0, 1, 0), PPU_SPRITE_RENDERER(0, 1, 1) }
+	},
+	{
+		{ PPU_SPRITE_RENDERER(1, 0, 0), PPU_SPRITE_RENDERER(1, 0, 1) },
+		{ PPU_SPRITE_RENDERER(1, 1, 0), PPU_SPRITE_RENDERER(1, 1, 1) }
+	}
+};
+/*
+ * Background renderer variants, indexed by [aligned][greyscale].
+ */
+BackgroundScanlineRenderer backgroundScanlineRenderers[2][2] =
+{
+	{ PPU_BACKGROUND_RENDERER(0, 0), PPU_BACKGROUND_RENDERER(0, 1) },
+	{ PPU_BACKGROUND_RENDERER(1, 0), PPU_BACKGROUND_RENDERER(1, 1) }
+};
+
+/*
+ * Obtains the sprite renderer variant for the current PPUCTRL/PPUMASK state.
+ */
+SpriteScanlineRenderer ppu_get_sprite_renderer()
+{
+	BOOL greyscale = ppuMask.greyscale || forceGreyscale;
+	return spriteScanlineRenderers[ppuCtrl.doubleSpriteHeight != 0][!ppuMask.showSpritesLeft][greyscale != 0];
+}
+/*
+ * Obtains the background renderer variant for the current PPUMASK/fine X scroll state.
+ */
+BackgroundScanlineRenderer ppu_get_background_renderer()
+{
+	BOOL greyscale = ppuMask.greyscale || forceGreyscale;
+	BOOL aligned = ppuRegisters.x == 0;
+	return backgroundScanlineRenderers[aligned][greyscale != 0];
+}
+/*
+ * Updates the framebuffer by drawing the appropriate sprite layer on it.
+ * The given priority is either 0 (top layer), 1 (behind background) and is determined in OAM Entry attributes.
+ */
+void ppu_draw_sprites(BYTE priority)
+{
+	ppu_get_sprite_renderer()(priority);
+}
+/*
+ * Updates the framebuffer by drawing the background layer onto it.
+ */
+void ppu_draw_background()
+{
+	ppu_get_background_renderer()();
+}
+/*
+ * Draws sprites without a specialized variant, checking all PPUCTRL/PPUMASK flags at runtime.
+ * (Only used as a baseline to measure the specialized renderers against)
+ */
+void ppu_draw_sprites_generic(BYTE priority)
+{
+	ppu_draw_sprites_scanline(priority, ppuCtrl.doubleSpriteHeight, !ppuMask.showSpritesLeft, ppuMask.greyscale || forceGreyscale, 0, RESOLUTION_WIDTH);
+}
+/*
+ * Draws the background without a specialized variant, checking all PPUMASK/scroll flags at runtime.
+ * (Only used as a baseline to measure the specialized renderers against)
+ */
+void ppu_draw_background_generic()
+{
+	ppu_draw_background_scanline(ppuRegisters.x == 0, ppuMask.greyscale || forceGreyscale, 0, RESOLUTION_WIDTH);
+}
+/*
+ * Draws the given pixels of the current scanline with the current PPUCTRL/PPUMASK state.
+ * (Used for segments of scanlines which were split by register writes)
+ */
+void ppu_draw_segment(USHORT startDot, USHORT endDot)
+{
+	BOOL greyscale = ppuMask.greyscale || forceGreyscale;
+	if(ppuMask.showBackground)
+	{
+		// Draw background for these pixels (transparent pixels are drawn with the universal background color).
+		ppu_draw_background_scanline(FALSE, greyscale, startDot, endDot);
+	}
+	else
+	{
+		// Set the pixels to the background color.
+		UINT color = ppu_get_color(universalBackgroundColor);
+		for(UINT i = startDot; i < endDot; i++)
+			internalFrameBuffer[(currentScanline * RESOLUTION_WIDTH) + i] = color;
+		memset(backgroundOpaque + startDot, 0, endDot - startDot);
+	}
+	if(ppuMask.showSprites)
+	{
+		// Draw the sprites that are behind the background (only where it is transparent), then the sprites in front of it.
+		ppu_draw_sprites_scanline(1, ppuCtrl.doubleSpriteHeight, !ppuMask.showSpritesLeft, greyscale, startDot, endDot);
+		ppu_draw_sprites_scanline(0, ppuCtrl.doubleSpriteHeight, !ppuMask.showSpritesLeft, greyscale, startDot, endDot);
+	}
+}
+/*
+ * Draws the entire current scanline in one pass, with the renderer variants for the current PPUCTRL/PPUMASK state.
+ */
+void ppu_draw_scanline()
+{
+	// Select our renderer variants once for the entire scanline.
+	SpriteScanlineRenderer drawSprites = ppu_get_sprite_renderer();
+	BackgroundScanlineRenderer drawBackground = ppu_get_background_renderer();
 
-				// Output our pixel.
-				assert(sizeof(internalFrameBuffer) > frameBufferPixelOffset, "Internal framebuffer drawing out of bounds.");
-				internalFrameBuffer[frameBufferPixelOffset] = rgbaColor;
-            }
-        }
-    }
+	if(ppuMask.showBackground)
+	{
+		// Draw background for this scanline (transparent pixels are drawn with the universal background color).
+		drawBackground();
+	}
+	else
+	{
+		// Set the entire scanline color to the background color.
+		UINT color = ppu_get_color(universalBackgroundColor);
+		for(UINT i = 0; i < RESOLUTION_WIDTH; i++)
+			internalFrameBuffer[(currentScanline * RESOLUTION_WIDTH) + i] = color;
+		memset(backgroundOpaque, 0, sizeof(backgroundOpaque));
+	}
+	if (ppuMask.showSprites)
+	{
+		// Draw the sprites that are behind the background (only where it is transparent), then the sprites in front of it.
+		drawSprites(1);
+		drawSprites(0);
+	}
+}
+/*
+ * Draws the current scanline up to the given dot, if it is a visible scanline that isn't drawn that far yet.
+ * (Called before register writes which affect rendering take effect)
+ */
+void ppu_draw_to_dot(USHORT dot)
+{
+	if(currentScanline >= RESOLUTION_HEIGHT)
+		return;
+	if(dot > RESOLUTION_WIDTH)
+		dot = RESOLUTION_WIDTH;
+	if(dot <= scanlineDrawnDot)
+		return;
+	ppu_draw_segment(scanlineDrawnDot, dot);
+	scanlineDrawnDot = dot;
+}
+/*
+ * Obtains the amount of PPU cycles until the next vertical blank begins (where an NMI may be requested).
+ */
+UINT ppu_cycles_until_vblank()
+{
+	UINT scanlines = (SCANLINES_PER_VBLANK - 1 - currentScanline + SCANLINES_PER_FRAME) % SCANLINES_PER_FRAME;
+	return (scanlines * PPU_CYCLES_PER_SCANLINE) + (PPU_CYCLES_PER_SCANLINE - ppuCycles);
 }
 /*
  * Updates the PPU (as if one cycle had occurred).
@@ -481,7 +842,8 @@ void ppu_draw_background()
 void ppu_update()
 {
 	// Increment another cycle, determine if we finished rendering our current scanline.
-	// We control timing through scanline number, rendering a scanline at a time, executing NMI on the appropriate scan line number.
+	// We control timing through scanline number and dot (cycle) within the scanline, drawing a scanline when its visible
+	// dots have passed, executing NMI on the appropriate scan line number.
 	// NOTE: There is more scanlines/cycles tracked beyond the height, where we perform other actions.
 	ppuCycles++;
 	if(ppuCycles == PPU_CYCLES_PER_SCANLINE)
@@ -489,33 +851,20 @@ void ppu_update()
 		// Increment our scanline number, reset our cycles we're keeping track of
 		ppuCycles = 0;
 		currentScanline++;
+		if(currentScanline == SCANLINES_PER_FRAME)
+		{
+			// We completed a frame, reset some variables.
+			currentScanline = 0;
+			ppuStatus.sprite0Hit = FALSE;
+		}
 
 		if(currentScanline < RESOLUTION_HEIGHT)
 		{
-			// Reset our sprite count for the current line.
+			// Start a new scanline, drawn from the current VRAM address.
 			spritesOnCurrentLine = 0;
-
-			// Start by setting the entire scanline color to the background color.
-			UINT color = ppu_get_color(universalBackgroundColor);
-			for(UINT i = 0; i < RESOLUTION_WIDTH; i++)
-				internalFrameBuffer[(currentScanline * RESOLUTION_WIDTH) + i] = color;
-
-			if (ppuMask.showSprites)
-			{
-				// Draw the sprites that are behind the background.
-				ppu_draw_sprites(1);
-			}
-			if(ppuMask.showBackground)
-			{
-				// Draw background for this scanline.
-				ppu_draw_background();
-			}
-			if(ppuMask.showSprites)
-			{
-				// Draw the sprites that are in front of the background.
-				ppu_draw_sprites(0);
-			}
-			ppuStatus.spriteOverflow = spritesOnCurrentLine > 8;
+			scanlineDrawnDot = 0;
+			scanlineOriginDot = 0;
+			scanlineOriginAddr = ppuRegisters.v;
 		}
 		else if(currentScanline == RESOLUTION_HEIGHT)
 		{
@@ -525,18 +874,37 @@ void ppu_update()
 					frameBuffer[((RESOLUTION_HEIGHT - (y + 1)) * RESOLUTION_WIDTH)+x] = internalFrameBuffer[(y * RESOLUTION_WIDTH) + x];
 			frameCount++;
 		}
-		else if(currentScanline == SCANLINES_PER_FRAME)
-		{
-			// We completed a frame, reset some variables.
-			currentScanline = 0;
-			ppuStatus.sprite0Hit = FALSE;
-		}
 
 		// Check if we're to handle our NMI interrupt (V-Blank).
 		ppuStatus.verticalBlanking = (currentScanline == SCANLINES_PER_VBLANK);
 		if(ppuStatus.verticalBlanking && ppuCtrl.executeNMIonVBLANK)
 			interrupts.requestedNMI = TRUE;
 	}
+	else if(currentScanline < RESOLUTION_HEIGHT || currentScanline == PRERENDER_SCANLINE)
+	{
+		// Update our VRAM address as the PPU does while rendering.
+		// https://wiki.nesdev.com/w/index.php/PPU_scrolling#During_dots_256_to_257
+		BOOL renderingEnabled = ppuMask.showBackground || ppuMask.showSprites;
+		if(ppuCycles == PPU_DOT_INCREMENT_Y)
+		{
+			if(currentScanline < RESOLUTION_HEIGHT)
+			{
+				// The visible dots have passed, draw the scanline (in one pass if no register writes split it).
+				if(scanlineDrawnDot == 0)
+					ppu_draw_scanline();
+				else
+					ppu_draw_to_dot(RESOLUTION_WIDTH);
+				scanlineDrawnDot = RESOLUTION_WIDTH;
+				ppuStatus.spriteOverflow = spritesOnCurrentLine > 8;
+			}
+			if(renderingEnabled)
+				ppu_increment_vertical();
+		}
+		else if(ppuCycles == PPU_DOT_COPY_HORIZONTAL && renderingEnabled)
+			ppu_copy_horizontal();
+		else if(ppuCycles == PPU_DOT_COPY_VERTICAL && currentScanline == PRERENDER_SCANLINE && renderingEnabled)
+			ppu_copy_vertical();
+	}
 }
 
 // ---------------------------------
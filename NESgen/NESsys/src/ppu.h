@@ -28,6 +28,20 @@
 #define PPU_CYCLES_PER_SCANLINE		341
 #define PPU_CYCLES_PER_FRAME		(SCANLINES_PER_FRAME * PPU_CYCLES_PER_SCANLINE)
 #define PPU_CYCLES_PER_VBLANK		(SCANLINES_PER_VBLANK * PPU_CYCLES_PER_SCANLINE)
+#define PALETTE_COLOR_COUNT			0x40
+#define PRERENDER_SCANLINE			(SCANLINES_PER_FRAME - 1)
+#define PPU_DOT_INCREMENT_Y			256
+#define PPU_DOT_COPY_HORIZONTAL		257
+#define PPU_DOT_COPY_VERTICAL		280
+#define TILE_CACHE_SIZE				0x400 // must be a power of two
+
+// Internal VRAM address fields (yyy NN YYYYY XXXXX: fine Y, nametable, coarse Y, coarse X).
+#define VRAM_ADDR_COARSE_X(addr)		((addr) & 0x1F)
+#define VRAM_ADDR_COARSE_Y(addr)		(((addr) >> 5) & 0x1F)
+#define VRAM_ADDR_NAMETABLE(addr)		(((addr) >> 10) & 3)
+#define VRAM_ADDR_FINE_Y(addr)			(((addr) >> 12) & 7)
+#define VRAM_ADDR_HORIZONTAL_MASK		0x041F // coarse X, horizontal nametable
+#define VRAM_ADDR_VERTICAL_MASK			0x7BE0 // fine Y, coarse Y, vertical nametable
 
 enum MIRRORINGTYPE { HORIZONTAL, VERTICAL, FOUR_SCREEN, ONE_SCREEN };
 enum MASTERSLAVEMODE { MASTERSLAVE_SLAVE, MASTERSLAVE_MASTER, MASTERSLAVE_UNSET };
@@ -37,7 +51,6 @@ enum MASTERSLAVEMODE { MASTERSLAVE_SLAVE, MASTERSLAVE_MASTER, MASTERSLAVE_UNSET
  */
 struct PPUCTRL
 {
-	BYTE baseNameTableIndex; // 0-3 index into patternTables
 	BOOL vramAddrIncrements32; // increment per read/write. index into [1,32].
 	BYTE spritePatternTableIndex; // 0/1 index into patternTables. (only for 8x8 sprites)
 	BYTE backgroundPatternTableIndex; // 0/1 index into patternTables
@@ -68,6 +81,17 @@ struct PPUSTATUS
 	BOOL sprite0Hit;
 	BOOL spriteOverflow;
 };
+/*
+ * Internal registers shared by PPUSCROLL/PPUADDR (commonly known as the "loopy" registers).
+ * https://wiki.nesdev.com/w/index.php/PPU_scrolling
+ */
+struct PPUINTERNALREGISTERS
+{
+	USHORT v; // current VRAM address, also the scroll position being rendered.
+	USHORT t; // temporary VRAM address, the scroll position copied into v during rendering.
+	BYTE x; // fine X scroll (3 bits).
+	BOOL w; // write toggle, FALSE on the first write of a pair.
+};
 /*
  * Object Attribute Memory (dictates sprite information)
  */
@@ -84,6 +108,13 @@ struct NAMETABLE
 	BYTE attributes[64]; // controls palette for 4x4 cells above. 2 bits for every 2x2 top-left, top-right, bottom-left, bottom-right.
 };
 USHORT nameTableSize;
+struct TILECACHEENTRY
+{
+	UINT key; // greyscale, pattern table index, palette index and tile index (see ppu_get_cached_tile)
+	UINT generation; // the cache generation this tile was resolved in, older generations are invalid.
+	UINT pixels[PATTERN_TABLE_TILE_WIDTH * PATTERN_TABLE_TILE_HEIGHT]; // resolved RGBA colors
+	BYTE opaque[PATTERN_TABLE_TILE_WIDTH * PATTERN_TABLE_TILE_HEIGHT]; // whether each pixel is opaque (non-zero color index)
+};
 struct COLORPALETTE
 {
 	BYTE paletteColorIndex[3];
@@ -145,26 +176,22 @@ struct NAMETABLE physicalNameTables[2];
  */
 struct OAMEntry objectAttributeMemory[OAM_TABLE_COUNT];
 /*
- * The address to read/write from/to the PPU memory space, as set by PPUADDR.
+ * Internal VRAM address/scroll registers, as set by PPUCTRL, PPUSCROLL and PPUADDR.
  */
-USHORT vramReadWriteAddress;
-/*
- * The toggle which is set high/low when setting two values (16-bits) through one register (8-bit).
- */
-BOOL vramWriteToggle;
+struct PPUINTERNALREGISTERS ppuRegisters;
 /*
  * Internal read buffer for PPUDATA for accesses to certain memory locations.
  * https://wiki.nesdev.com/w/index.php/PPU_registers#PPUDATA
  */
 BOOL vramReadValue;
 /*
- * Horizontal scroll value as set by PPUSCROLL register.
+ * Raster state of the current scanline. Register writes during the visible part of a scanline are stamped with
+ * their dot: the scanline is drawn up to that dot before the write takes effect, splitting it into segments.
+ * Scanlines without such writes are drawn in one pass when the visible part ends.
  */
-BYTE scrollX;
-/*
- * Vertical scroll value as set by PPUSCROLL register.
- */
-BYTE scrollY;
+USHORT scanlineDrawnDot; // the first dot not yet drawn on the current scanline.
+USHORT scanlineOriginDot; // the dot the background position is counted from (where v was last set).
+USHORT scanlineOriginAddr; // v as of the origin dot.
 /*
  * The address to read/write from/to the OAM internal memory, as set by the OAMADDR register.
  */
@@ -197,6 +224,32 @@ extern UINT palette[];
  * The total count of colors in the palette.
  */
 UINT paletteCount;
+/*
+ * Greyscale versions of the palette colors (computed on initialization).
+ */
+UINT greyscalePalette[PALETTE_COLOR_COUNT];
+/*
+ * Cache of background tiles fully resolved to RGBA colors, keyed by pattern table, tile and palette.
+ * Invalidated (by advancing the generation) when pattern table or background palette data changes.
+ */
+struct TILECACHEENTRY tileCache[TILE_CACHE_SIZE];
+UINT tileCacheGeneration;
+ULONGLONG tileCacheHits;
+ULONGLONG tileCacheMisses;
+ULONGLONG tileCacheEvictions;
+/*
+ * Whether each pixel of the background on the current scanline is opaque.
+ * (Used to draw sprites behind the background after the background is drawn).
+ */
+BYTE backgroundOpaque[RESOLUTION_WIDTH];
+/*
+ * Scanline renderers. A variant is generated for every combination of the PPUCTRL/PPUMASK/scroll flags
+ * that affect drawing, and the appropriate one is selected once per scanline.
+ */
+typedef void (*SpriteScanlineRenderer)(BYTE priority);
+typedef void (*BackgroundScanlineRenderer)();
+extern SpriteScanlineRenderer spriteScanlineRenderers[2][2][2];
+extern BackgroundScanlineRenderer backgroundScanlineRenderers[2][2];
 
 // ---------------------------------
 // Functions
@@ -212,10 +265,25 @@ void ppu_set_oamdata(BYTE data);
 void ppu_set_ppuscroll(BYTE data);
 void ppu_set_ppuaddr(BYTE data);
 void ppu_set_data(BYTE data);
+void ppu_write_data_block(const BYTE* data, UINT count);
+void ppu_fill_data(BYTE data, UINT count);
 void ppu_oam_dma(BYTE pageNumber);
+void ppu_increment_vertical();
+void ppu_copy_horizontal();
+void ppu_copy_vertical();
+void ppu_draw_to_dot(USHORT dot);
 UINT ppu_get_color(BYTE paletteColorIndex);
+void ppu_invalidate_tile_cache();
+struct TILECACHEENTRY* ppu_get_cached_tile(UINT patternTableIndex, BYTE tileIndex, BYTE paletteIndex, BOOL greyscale);
 void ppu_draw_sprites(BYTE priority);
 void ppu_draw_background();
+void ppu_draw_segment(USHORT startDot, USHORT endDot);
+void ppu_draw_scanline();
+SpriteScanlineRenderer ppu_get_sprite_renderer();
+BackgroundScanlineRenderer ppu_get_background_renderer();
+void ppu_draw_sprites_generic(BYTE priority);
+void ppu_draw_background_generic();
+UINT ppu_cycles_until_vblank();
 void ppu_update();
 
 #endif /* PPU_H_ */
@@ -0,0 +1,97 @@
+#include "NESsys.h"
+#include <stdio.h>
+#include "profile.h"
+
+/*
+ * NOTES:
+ * -Games generated with -g record how often code sections are entered, branches are taken and which targets runtime calculated
+ *  jumps go to. The profile is written when the application exits, and NESgen.py -P uses it to tune the next build.
+ * -Profiles are plain text, one record per line, with only non-zero counts (see NESgen/ExecutionProfile.py).
+ */
+
+/*
+ * Discards all recorded counts.
+ */
+void profile_init()
+{
+	memset(profileBlockCounts, 0, sizeof(profileBlockCounts));
+	memset(profileBranchCounts, 0, sizeof(profileBranchCounts));
+	memset(profileIndirectTargets, 0, sizeof(profileIndirectTargets));
+	memset(profileMissCounts, 0, sizeof(profileMissCounts));
+}
+/*
+ * Records the code section at the given address was entered.
+ */
+void profile_block(USHORT address)
+{
+	profileBlockCounts[PROFILE_PRG_ROM_INDEX(address)]++;
+}
+/*
+ * Records the outcome of the branch at the given address. Returns whether it was taken, so it can wrap the branch condition.
+ */
+BOOL profile_branch(USHORT address, BOOL taken)
+{
+	profileBranchCounts[PROFILE_PRG_ROM_INDEX(address)][taken ? 1 : 0]++;
+	return taken;
+}
+/*
+ * Records the runtime calculated jump at the given address went to the given target.
+ */
+void profile_indirect(USHORT jumpAddress, USHORT targetAddress)
+{
+	// Open addressing, if we run out of room we stop recording new pairs.
+	UINT hash = ((jumpAddress * 31) ^ targetAddress) % PROFILE_INDIRECT_TARGETS_SIZE;
+	for(UINT i = 0; i < PROFILE_INDIRECT_TARGETS_SIZE; i++)
+	{
+		struct PROFILEINDIRECTTARGET* entry = &profileIndirectTargets[(hash + i) % PROFILE_INDIRECT_TARGETS_SIZE];
+		if(entry->count == 0)
+		{
+			entry->jumpAddress = jumpAddress;
+			entry->targetAddress = targetAddress;
+		}
+		if(entry->jumpAddress == jumpAddress && entry->targetAddress == targetAddress)
+		{
+			entry->count++;
+			return;
+		}
+	}
+}
+/*
+ * Records a jump to the given address had no label in the compiled code.
+ */
+void profile_miss(USHORT address)
+{
+	profileMissCounts[address]++;
+}
+/*
+ * Writes all recorded counts to the profile at the given path. Returns FALSE if it couldn't be written.
+ */
+BOOL profile_write(const char* path)
+{
+	FILE* file = fopen(path, "w");
+	if(file == NULL)
+		return FALSE;
+	fprintf(file, "# %s execution profile\n", APPLICATION_NAME);
+	for(UINT i = 0; i < 0x8000; i++)
+	{
+		if(profileBlockCounts[i] != 0)
+			fprintf(file, "block %04x %u\n", i + 0x8000, profileBlockCounts[i]);
+	}
+	for(UINT i = 0; i < 0x8000; i++)
+	{
+		if(profileBranchCounts[i][0] != 0 || profileBranchCounts[i][1] != 0)
+			fprintf(file, "branch %04x %u %u\n", i + 0x8000, profileBranchCounts[i][0], profileBranchCounts[i][1]);
+	}
+	for(UINT i = 0; i < PROFILE_INDIRECT_TARGETS_SIZE; i++)
+	{
+		if(profileIndirectTargets[i].count != 0)
+			fprintf(file, "indirect %04x %04x %u\n", profileIndirectTargets[i].jumpAddress, profileIndirectTargets[i].targetAddress, profileIndirectTargets[i].count);
+	}
+	for(UINT i = 0; i < 0x10000; i++)
+	{
+		if(profileMissCounts[i] != 0)
+			fprintf(file, "miss %04x %u\n", i, profileMissCounts[i]);
+	}
+	fclose(file);
+	return TRUE;
+}
@@ -0,0 +1,35 @@
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+#include "NESsys.h"
+
+// ---------------------------------
+// Profile Definitions
+// ---------------------------------
+#define PROFILE_INDIRECT_TARGETS_SIZE		0x400 // distinct (jump, target) pairs we can record.
+#define PROFILE_PRG_ROM_INDEX(addr)			((addr) & 0x7FFF)
+
+struct PROFILEINDIRECTTARGET
+{
+	USHORT jumpAddress;
+	USHORT targetAddress;
+	UINT count; // zero if unused.
+};
+
+// Execution counts recorded by games generated with -g (and dispatcher misses, recorded by the interpreter).
+UINT profileBlockCounts[0x8000]; // times a code section was entered, by PRG-ROM address.
+UINT profileBranchCounts[0x8000][2]; // times a branch was not taken/taken, by PRG-ROM address.
+struct PROFILEINDIRECTTARGET profileIndirectTargets[PROFILE_INDIRECT_TARGETS_SIZE];
+UINT profileMissCounts[0x10000]; // times a jump the compiled code had no label for went to an address.
+
+// ---------------------------------
+// Functions
+// ---------------------------------
+void profile_init();
+void profile_block(USHORT address);
+BOOL profile_branch(USHORT address, BOOL taken);
+void profile_indirect(USHORT jumpAddress, USHORT targetAddress);
+void profile_miss(USHORT address);
+BOOL profile_write(const char* path);
+
+#endif /* PROFILE_H_ */
@@ -6,6 +6,12 @@
 #include "game_base.h"
 #include "memory.h"
 #include "ppu.h"
+#include "instructions.h"
+#include "idioms.h"
+#include "hle.h"
+#include "memo.h"
+#include "interpreter.h"
+#include "profile.h"
 #include "tests.h"
 
 void fail(const char *fmt, ...)
@@ -84,6 +90,526 @@ void test_ppu_oamdma_register()
 	cpu_write8(PPUOAMADDR_REGISTER, 0x00);
 	assert(cpu_read8(PPUOAMDATA_REGISTER) == 0x02, "PPUADDR or PPUDATA Register Write/Read Test #6.");
 }
+void test_ppu_internal_registers()
+{
+	// Example sequence from https://wiki.nesdev.com/w/index.php/PPU_scrolling
+	cpu_write8(PPUCTRL_REGISTER, 0x00);
+	cpu_read8(PPUSTATUS_REGISTER);
+	assert(ppuRegisters.w == FALSE, "PPU Internal Registers Test #1");
+	cpu_write8(PPUSCROLL_REGISTER, 0x7D);
+	assert((ppuRegisters.t & 0x1F) == 0x0F && ppuRegisters.x == 0x05 && ppuRegisters.w, "PPU Internal Registers Test #2");
+	cpu_write8(PPUSCROLL_REGISTER, 0x5E);
+	assert(ppuRegisters.t == 0x616F && !ppuRegisters.w, "PPU Internal Registers Test #3");
+	cpu_write8(PPUADDR_REGISTER, 0x3D);
+	assert(ppuRegisters.t == 0x3D6F, "PPU Internal Registers Test #4");
+	cpu_write8(PPUADDR_REGISTER, 0xF0);
+	assert(ppuRegisters.t == 0x3DF0 && ppuRegisters.v == 0x3DF0, "PPU Internal Registers Test #5");
+
+	// Vertical increments move through fine Y, then coarse Y, wrapping into the vertically adjacent nametable after row 29.
+	ppuRegisters.v = 0x63A0; // fine Y 6, coarse Y 29, nametable 0
+	ppu_increment_vertical();
+	assert(ppuRegisters.v == 0x73A0, "PPU Internal Registers Test #6");
+	ppu_increment_vertical();
+	assert(ppuRegisters.v == 0x0800, "PPU Internal Registers Test #7");
+	ppuRegisters.v = 0x73E0; // fine Y 7, coarse Y 31 (attribute table) wraps without switching nametable.
+	ppu_increment_vertical();
+	assert(ppuRegisters.v == 0x0000, "PPU Internal Registers Test #8");
+
+	// Copies only take the horizontal/vertical bits from the temporary address.
+	ppuRegisters.v = 0x0000;
+	ppuRegisters.t = 0x7FFF;
+	ppu_copy_horizontal();
+	assert(ppuRegisters.v == 0x041F, "PPU Internal Registers Test #9");
+	ppu_copy_vertical();
+	assert(ppuRegisters.v == 0x7FFF, "PPU Internal Registers Test #10");
+	memset(&ppuRegisters, 0, sizeof(ppuRegisters));
+}
+void test_ppu_raster_split()
+{
+	// Set up distinct tiles across the first row of tiles.
+	for(UINT i = 0; i < 0x100; i++)
+	{
+		patternTables[0][i * 0x10] = (BYTE)i;
+		patternTables[0][(i * 0x10) + 8] = (BYTE)~i;
+	}
+	for(UINT i = 0; i < RESOLUTION_TILES_WIDTH; i++)
+	{
+		physicalNameTables[0].cells[i] = (BYTE)i;
+		physicalNameTables[1].cells[i] = (BYTE)(0x80 + i);
+	}
+	ppu_write8(0x3F01, 0x16);
+	ppu_write8(0x3F02, 0x2A);
+	ppu_write8(0x3F03, 0x12);
+	ppu_invalidate_tile_cache();
+	ppuMask.showBackground = TRUE;
+	currentScanline = 0;
+
+	// Draw the scanline from two addresses without any splits.
+	UINT expected[RESOLUTION_WIDTH];
+	scanlineOriginDot = 0;
+	scanlineOriginAddr = 0x0000;
+	ppu_draw_scanline();
+	memcpy(expected, internalFrameBuffer, (RESOLUTION_WIDTH / 2) * sizeof(UINT));
+	scanlineOriginAddr = 0x0010;
+	ppu_draw_scanline();
+	memcpy(expected + (RESOLUTION_WIDTH / 2), internalFrameBuffer, (RESOLUTION_WIDTH / 2) * sizeof(UINT));
+
+	// Draw the scanline with a PPUADDR write in the middle, the right half should be drawn from the new address.
+	scanlineDrawnDot = 0;
+	scanlineOriginAddr = 0x0000;
+	ppuCycles = RESOLUTION_WIDTH / 2;
+	cpu_write8(PPUADDR_REGISTER, 0x00);
+	cpu_write8(PPUADDR_REGISTER, 0x10);
+	ppu_draw_to_dot(RESOLUTION_WIDTH);
+	assert(scanlineOriginDot == RESOLUTION_WIDTH / 2 && scanlineDrawnDot == RESOLUTION_WIDTH, "PPU Raster Split Test #1");
+	assert(memcmp(expected, internalFrameBuffer, sizeof(expected)) == 0, "PPU Raster Split Test #2");
+
+	// Restore our PPU state.
+	ppu_init();
+}
+void test_ppu_tile_cache()
+{
+	tileCacheHits = tileCacheMisses = tileCacheEvictions = 0;
+	ppu_invalidate_tile_cache();
+
+	// Resolving the same tile twice should only miss once.
+	struct TILECACHEENTRY* tile = ppu_get_cached_tile(0, 0x01, 2, FALSE);
+	assert(ppu_get_cached_tile(0, 0x01, 2, FALSE) == tile, "Tile Cache Test #1");
+	assert(tileCacheHits == 1 && tileCacheMisses == 1, "Tile Cache Test #2");
+
+	// Tiles which map to the same slot evict each other.
+	ppu_get_cached_tile(1, 0x00, 2, FALSE);
+	assert(tileCacheEvictions == 1, "Tile Cache Test #3");
+
+	// Writing the same value doesn't invalidate, writing a new background palette or pattern table value does.
+	ppu_get_cached_tile(0, 0x01, 2, FALSE);
+	ppu_write8(0x3F09, ppu_read8(0x3F09));
+	ppu_get_cached_tile(0, 0x01, 2, FALSE);
+	assert(tileCacheHits == 2, "Tile Cache Test #4");
+	ppu_write8(0x3F09, ppu_read8(0x3F09) + 1);
+	tile = ppu_get_cached_tile(0, 0x01, 2, FALSE);
+	assert(tileCacheHits == 2 && tileCacheEvictions == 2, "Tile Cache Test #5");
+	BYTE colorIndex = ((patternTables[0][0x10] >> 7) & 1) | (((patternTables[0][0x18] >> 7) & 1) << 1);
+	BYTE paletteColorIndex = colorIndex ? backgroundColorPalette[2].paletteColorIndex[colorIndex - 1] : universalBackgroundColor;
+	assert(tile->pixels[0] == palette[paletteColorIndex & 0x3F] && tile->opaque[0] == (colorIndex > 0), "Tile Cache Test #6");
+	BYTE patternData = ppu_read8(0x0010);
+	ppu_write8(0x0010, ~patternData);
+	ppu_get_cached_tile(0, 0x01, 2, FALSE);
+	assert(tileCacheHits == 2 && tileCacheMisses == 5, "Tile Cache Test #7");
+	ppu_write8(0x0010, patternData);
+}
+void test_ppu_oamdma_transfer()
+{
+	// DMA copies a page into OAM starting at OAMADDR (wrapping around), stalling the CPU.
+	for(UINT i = 0; i < MEMORY_PAGE_SIZE; i++)
+		cpu_write8(0x200 + i, (BYTE)(i ^ 0xA5));
+	cpuStallCycles = 0;
+	cpuCyclesTotal = 7;
+	cpu_write8(PPUOAMADDR_REGISTER, 0x10);
+	cpu_write8(PPUOAMDMA_REGISTER, 0x02);
+	BYTE* dataArray = (BYTE*)objectAttributeMemory;
+	for(UINT i = 0; i < MEMORY_PAGE_SIZE; i++)
+		assert(dataArray[(BYTE)(0x10 + i)] == (BYTE)(i ^ 0xA5), "OAM DMA Transfer Test #1 (offset 0x%02x)", i);
+	assert(cpuStallCycles == 514, "OAM DMA Transfer Test #2");
+	cpuStallCycles = 0;
+	cpuCyclesTotal = 8;
+	cpu_write8(PPUOAMDMA_REGISTER, 0x02);
+	assert(cpuStallCycles == 513, "OAM DMA Transfer Test #3");
+
+	// Mirrored RAM resolves to the same page.
+	assert(cpu_mem_translate_page(0x0A) == cpu_mem_translate_page(0x02), "OAM DMA Transfer Test #4");
+	assert(cpu_mem_translate_page(0x20) == NULL, "OAM DMA Transfer Test #5");
+	cpuStallCycles = 0;
+	cpuCyclesTotal = 0;
+	cpu_write8(PPUOAMADDR_REGISTER, 0x00);
+}
+void test_ppu_data_transfer()
+{
+	// Block writes should produce the same result as individual PPUDATA writes, for both increments.
+	BYTE data[0x50];
+	for(UINT i = 0; i < sizeof(data); i++)
+		data[i] = (BYTE)(i * 7);
+	for(UINT increment32 = 0; increment32 < 2; increment32++)
+	{
+		cpu_write8(PPUCTRL_REGISTER, increment32 ? 0x04 : 0x00);
+		cpu_read8(PPUSTATUS_REGISTER);
+		cpu_write8(PPUADDR_REGISTER, 0x23);
+		cpu_write8(PPUADDR_REGISTER, 0xE0);
+		for(UINT i = 0; i < sizeof(data); i++)
+			cpu_write8(PPUDATA_REGISTER, data[i]);
+		USHORT expectedAddr = ppuRegisters.v;
+		BYTE expected[sizeof(data)];
+		for(UINT i = 0; i < sizeof(data); i++)
+			expected[i] = ppu_read8(0x23E0 + (i * (increment32 ? 32 : 1)));
+
+		// Clear the data, then write it again as a block.
+		cpu_write8(PPUADDR_REGISTER, 0x23);
+		cpu_write8(PPUADDR_REGISTER, 0xE0);
+		ppu_fill_data(0, sizeof(data));
+		assert(ppuRegisters.v == expectedAddr, "PPUDATA Transfer Test #1");
+		cpu_write8(PPUADDR_REGISTER, 0x23);
+		cpu_write8(PPUADDR_REGISTER, 0xE0);
+		ppu_write_data_block(data, sizeof(data));
+		assert(ppuRegisters.v == expectedAddr, "PPUDATA Transfer Test #2");
+		for(UINT i = 0; i < sizeof(data); i++)
+			assert(ppu_read8(0x23E0 + (i * (increment32 ? 32 : 1))) == expected[i], "PPUDATA Transfer Test #3 (index %i)", i);
+	}
+
+	// Block writes into the palette are mirrored like individual writes.
+	cpu_write8(PPUCTRL_REGISTER, 0x00);
+	cpu_write8(PPUADDR_REGISTER, 0x3F);
+	cpu_write8(PPUADDR_REGISTER, 0x10);
+	ppu_fill_data(0x21, 1);
+	assert(universalBackgroundColor == 0x21, "PPUDATA Transfer Test #4");
+	memset(&ppuRegisters, 0, sizeof(ppuRegisters));
+}
+void test_register_instructions()
+{
+	// Instructions for registers kept in local variables take the register and return the result, setting the same flags.
+	#define FLAGS(c, z, v, n)		((1 << CPU_FLAG_UNUSED) | (c << CPU_FLAG_CARRY) | (z << CPU_FLAG_ZERO) | (v << CPU_FLAG_OVERFLOW) | (n << CPU_FLAG_SIGN))
+	cpu_set_flags(0);
+	assert(MOSInstr_AddWithCarry(0x50, 0x50) == 0xA0 && registers.P == FLAGS(0, 0, 1, 1), "Register Instruction Test #1");
+	cpu_set_flags(FLAGS(1, 0, 0, 0));
+	assert(MOSInstr_AddWithCarry(0xFF, 0x00) == 0x00 && registers.P == FLAGS(1, 1, 0, 0), "Register Instruction Test #2");
+	cpu_set_flags(FLAGS(1, 0, 0, 0));
+	assert(MOSInstr_SubtractWithBorrow(0x50, 0xF0) == 0x60 && registers.P == FLAGS(0, 0, 0, 0), "Register Instruction Test #3");
+	cpu_set_flags(0);
+	assert(MOSInstr_SubtractWithBorrow(0x80, 0x00) == 0x7F && registers.P == FLAGS(1, 0, 1, 0), "Register Instruction Test #4");
+	cpu_set_flags(0);
+	MOSInstr_Compare(0x10, 0x10);
+	assert(registers.P == FLAGS(1, 1, 0, 0), "Register Instruction Test #5");
+	MOSInstr_Test(0x0F, 0xC0);
+	assert(registers.P == FLAGS(1, 1, 1, 1), "Register Instruction Test #6");
+	cpu_set_flags(0);
+	assert(MOSInstr_Load(0x80) == 0x80 && registers.P == FLAGS(0, 0, 0, 1), "Register Instruction Test #7");
+
+	// The registers structure versions give the same results.
+	registers.A = 0x50;
+	MOSInstr_ADC(0x50);
+	assert(registers.A == 0xA0 && registers.P == FLAGS(0, 0, 1, 1), "Register Instruction Test #8");
+	#undef FLAGS
+	cpu_set_flags(0);
+	registers.A = 0;
+}
+void test_fused_instructions()
+{
+	// Shift chains give the same results as their instructions executed one at a time.
+	for(UINT count = 1; count <= 8; count++)
+	{
+		for(UINT value = 0; value < 0x100; value++)
+		{
+			BYTE expected = (BYTE)value;
+			for(UINT i = 0; i < count; i++)
+				expected = MOSInstr_ASL(expected);
+			BYTE expectedFlags = registers.P;
+			cpu_set_flags(0);
+			assert(MOSInstr_ShiftLeftBy((BYTE)value, count) == expected && registers.P == expectedFlags, "Fused Instruction Test #1 (%u, %u)", value, count);
+
+			expected = (BYTE)value;
+			for(UINT i = 0; i < count; i++)
+				expected = MOSInstr_LSR(expected);
+			expectedFlags = registers.P;
+			cpu_set_flags(0);
+			assert(MOSInstr_ShiftRightBy((BYTE)value, count) == expected && registers.P == expectedFlags, "Fused Instruction Test #2 (%u, %u)", value, count);
+		}
+	}
+	USHORT values[] = { 0x0000, 0x0001, 0x00FF, 0x0180, 0x8001, 0xA55A, 0xFFFF };
+	for(UINT count = 1; count <= 15; count++)
+	{
+		for(UINT x = 0; x < sizeof(values) / sizeof(values[0]); x++)
+		{
+			BYTE low = values[x] & 0xFF, high = values[x] >> 8;
+			cpu_set_flags(0);
+			for(UINT i = 0; i < count; i++)
+			{
+				low = MOSInstr_ASL(low);
+				high = MOSInstr_ROL(high);
+			}
+			BYTE expectedFlags = registers.P;
+			cpu_set_flags(0);
+			assert(MOSInstr_ShiftLeft16(values[x], count) == ((high << 8) | low) && registers.P == expectedFlags, "Fused Instruction Test #3 (%u, %u)", values[x], count);
+
+			// (with the flags the chain doesn't change set, and carry set, which the first LSR replaces)
+			low = values[x] & 0xFF, high = values[x] >> 8;
+			cpu_set_flags(0xFF);
+			for(UINT i = 0; i < count; i++)
+			{
+				high = MOSInstr_LSR(high);
+				low = MOSInstr_ROR(low);
+			}
+			expectedFlags = registers.P;
+			cpu_set_flags(0xFF);
+			assert(MOSInstr_ShiftRight16(values[x], count) == ((high << 8) | low) && registers.P == expectedFlags, "Fused Instruction Test #4 (%u, %u)", values[x], count);
+		}
+	}
+	cpu_set_flags(0);
+	registers.A = 0;
+}
+void test_idiom_loops()
+{
+	// STA (0x10),Y / DEY / BNE: fills from the pointer + Y down to the pointer + 1.
+	struct IDIOMLOOP fill = { IDIOM_FILL, IDIOM_INDEX_Y, TRUE, FALSE, 0, { IDIOM_OPERAND_NONE, 0 }, { IDIOM_OPERAND_INDIRECT, 0x10 }, 11 };
+	memset(zeroPage, 0, sizeof(zeroPage));
+	memset(ram, 0, sizeof(ram));
+	cpu_write16(0x10, 0x300);
+	registers.A = 0x5A;
+	registers.Y = 0x10;
+	cpu_set_flag(CPU_FLAG_SIGN, TRUE);
+	assert(idiom_execute_loop(&fill) == (0x10 * 11) - 1, "Idiom Loop Test #1");
+	for(UINT i = 1; i <= 0x10; i++)
+		assert(cpu_read8(0x300 + i) == 0x5A, "Idiom Loop Test #2 (index %i)", i);
+	assert(cpu_read8(0x300) == 0 && cpu_read8(0x311) == 0, "Idiom Loop Test #3");
+	assert(registers.Y == 0 && cpu_get_flag(CPU_FLAG_ZERO) && !cpu_get_flag(CPU_FLAG_SIGN), "Idiom Loop Test #4");
+
+	// LDA 0x400,X / STA 0x500,X / INX / CPX #0x20 / BNE: copies in order, ending with the last value loaded.
+	struct IDIOMLOOP copy = { IDIOM_COPY, IDIOM_INDEX_X, FALSE, TRUE, 0x20, { IDIOM_OPERAND_ABSOLUTE, 0x400 }, { IDIOM_OPERAND_ABSOLUTE, 0x500 }, 15 };
+	for(UINT i = 0; i < 0x20; i++)
+		cpu_write8(0x400 + i, (BYTE)(i + 1));
+	registers.X = 0;
+	cpu_set_flag(CPU_FLAG_CARRY, FALSE);
+	assert(idiom_execute_loop(&copy) == (0x20 * 15) - 1, "Idiom Loop Test #5");
+	for(UINT i = 0; i < 0x20; i++)
+		assert(cpu_read8(0x500 + i) == (BYTE)(i + 1), "Idiom Loop Test #6 (index %i)", i);
+	assert(registers.X == 0x20 && registers.A == 0x20 && cpu_get_flag(CPU_FLAG_CARRY) && cpu_get_flag(CPU_FLAG_ZERO), "Idiom Loop Test #7");
+
+	// Loops which overwrite their own pointer, or could be interrupted, are left to execute instruction by instruction.
+	cpu_write16(0x10, 0x0000);
+	registers.Y = 0x20;
+	assert(idiom_execute_loop(&fill) == 0 && registers.Y == 0x20 && cpu_read8(0x01) == 0, "Idiom Loop Test #8");
+	cpu_write16(0x10, 0x300);
+	ppuCtrl.executeNMIonVBLANK = TRUE;
+	currentScanline = SCANLINES_PER_VBLANK - 1;
+	ppuCycles = PPU_CYCLES_PER_SCANLINE - 0x40;
+	assert(idiom_execute_loop(&fill) == 0 && registers.Y == 0x20, "Idiom Loop Test #9");
+	ppuCtrl.executeNMIonVBLANK = FALSE;
+	currentScanline = 0;
+	ppuCycles = 0;
+
+	// The iterations after it branch back to the loop's head, which doesn't check them again (a later execution of the loop is).
+	BOOL skipped = TRUE;
+	for(registers.Y = 0x1F; registers.Y != 0; registers.Y--)
+		skipped &= idiom_execute_loop(&fill) == 0;
+	assert(skipped, "Idiom Loop Test #10");
+	registers.Y = 0x20;
+	assert(idiom_execute_loop(&fill) == (0x20 * 11) - 1 && registers.Y == 0, "Idiom Loop Test #11");
+
+	// STA PPUDATA / DEX / BNE: fills VRAM while rendering is disabled.
+	struct IDIOMLOOP ppuFill = { IDIOM_FILL, IDIOM_INDEX_X, TRUE, FALSE, 0, { IDIOM_OPERAND_NONE, 0 }, { IDIOM_OPERAND_PPUDATA, 0 }, 9 };
+	cpu_write8(PPUMASK_REGISTER, 0x00);
+	cpu_read8(PPUSTATUS_REGISTER);
+	cpu_write8(PPUADDR_REGISTER, 0x24);
+	cpu_write8(PPUADDR_REGISTER, 0x00);
+	registers.A = 0x5A;
+	registers.X = 0;
+	assert(idiom_execute_loop(&ppuFill) == (0x100 * 9) - 1, "Idiom Loop Test #12");
+	assert(ppu_read8(0x2400) == 0x5A && ppu_read8(0x24FF) == 0x5A && ppuRegisters.v == 0x2500, "Idiom Loop Test #13");
+	memset(ram, 0, sizeof(ram));
+	memset(zeroPage, 0, sizeof(zeroPage));
+	memset(&ppuRegisters, 0, sizeof(ppuRegisters));
+	cpu_set_flags(0);
+}
+void test_known_routines()
+{
+	// 13 * 11 = 143, with three of the eight iterations adding.
+	struct HLEROUTINE multiply = { HLE_MULTIPLY, { 8, 0x10, 0x11 } };
+	memset(zeroPage, 0, sizeof(zeroPage));
+	zeroPage[0x10] = 13;
+	zeroPage[0x11] = 11;
+	assert(hle_execute_routine(&multiply) == 9 + (8 * 15) + (3 * 4) - 1, "Known Routine Test #1");
+	assert(registers.A == 0 && zeroPage[0x10] == 143 && registers.X == 0 && !cpu_get_flag(CPU_FLAG_CARRY) && cpu_get_flag(CPU_FLAG_ZERO), "Known Routine Test #2");
+
+	// 1000 / 7 = 142 remainder 6, with four of the sixteen iterations subtracting.
+	struct HLEROUTINE divide = { HLE_DIVIDE, { 16, 0x10, 0x11, 0x12 } };
+	cpu_write16(0x10, 1000);
+	zeroPage[0x12] = 7;
+	assert(hle_execute_routine(&divide) == 4 + (16 * 23) + (4 * 7) - 1, "Known Routine Test #3");
+	assert(cpu_read16(0x10) == 142 && registers.A == 6 && registers.X == 0, "Known Routine Test #4");
+
+	// 254 = 2 hundreds, 5 tens and 4 ones, leaving the flags of comparing 4 with 10.
+	struct HLEROUTINE decimal = { HLE_DECIMAL, { 0x10, 0x11, 0x12 } };
+	registers.A = 254;
+	assert(hle_execute_routine(&decimal) == 2 + (2 * 11) + 5 + 5 + (5 * 11) + 5 + 6, "Known Routine Test #5");
+	assert(zeroPage[0x10] == 2 && zeroPage[0x11] == 5 && zeroPage[0x12] == 4 && registers.Y == 5, "Known Routine Test #6");
+	assert(!cpu_get_flag(CPU_FLAG_CARRY) && !cpu_get_flag(CPU_FLAG_ZERO) && cpu_get_flag(CPU_FLAG_SIGN), "Known Routine Test #7");
+
+	// 0x8001 shifted once, the bit shifted out applying the feedback.
+	struct HLEROUTINE lfsr = { HLE_LFSR, { 1, 0x10, 0x11, 0x2D } };
+	cpu_write16(0x10, 0x8001);
+	assert(hle_execute_routine(&lfsr) == 2 + 3 + 7 + 4 + 5 - 1 + 5, "Known Routine Test #8");
+	assert(cpu_read16(0x10) == 0x002F && registers.A == 0x2F && !cpu_get_flag(CPU_FLAG_ZERO), "Known Routine Test #9");
+
+	// Routines which could be interrupted are left to execute instruction by instruction.
+	zeroPage[0x10] = 13;
+	ppuCtrl.executeNMIonVBLANK = TRUE;
+	currentScanline = SCANLINES_PER_VBLANK - 1;
+	ppuCycles = PPU_CYCLES_PER_SCANLINE - 0x40;
+	assert(hle_execute_routine(&multiply) == 0 && zeroPage[0x10] == 13, "Known Routine Test #10");
+	ppuCtrl.executeNMIonVBLANK = FALSE;
+	currentScanline = 0;
+	ppuCycles = 0;
+	memset(zeroPage, 0, sizeof(zeroPage));
+	cpu_set_flags(0);
+	registers.A = registers.X = registers.Y = 0;
+}
+void test_memoization()
+{
+	// A subroutine reading X and 0x10, writing A, the zero and sign flags and 0x11.
+	static struct MEMOSUBROUTINE subroutine = { .address = 0x8000, .inputRegisters = MEMO_REGISTER_X, .inputFlags = 0, .inputCount = 1, .inputs = { 0x10 },
+			.outputRegisters = MEMO_REGISTER_A, .outputFlags = 0x82, .outputCount = 1, .outputs = { 0x11 } };
+	memset(zeroPage, 0, sizeof(zeroPage));
+	registers.X = 3;
+	zeroPage[0x10] = 5;
+	assert(memo_lookup(&subroutine) == 0, "Memoization Test #1");
+	registers.A = 8;
+	zeroPage[0x11] = 8;
+	cpu_set_flags(0);
+	cpuCyclesTotal += 20;
+	memo_store(&subroutine);
+
+	// The same inputs apply the stored results (and only those), other inputs miss.
+	registers.A = 0;
+	registers.Y = 0x40;
+	zeroPage[0x11] = 0;
+	cpu_set_flags(0x83);
+	assert(memo_lookup(&subroutine) == 20, "Memoization Test #2");
+	assert(registers.A == 8 && registers.Y == 0x40 && zeroPage[0x11] == 8 && cpu_get_flag(CPU_FLAG_CARRY) && !cpu_get_flag(CPU_FLAG_ZERO) && !cpu_get_flag(CPU_FLAG_SIGN), "Memoization Test #3");
+	zeroPage[0x10] = 6;
+	assert(memo_lookup(&subroutine) == 0, "Memoization Test #4");
+
+	// Results of an execution an interrupt was handled during aren't stored, and results aren't used if an interrupt could occur.
+	cpuCyclesTotal += 20;
+	cpuInterruptCount++;
+	memo_store(&subroutine);
+	assert(memo_lookup(&subroutine) == 0, "Memoization Test #5");
+	zeroPage[0x10] = 5;
+	ppuCtrl.executeNMIonVBLANK = TRUE;
+	currentScanline = SCANLINES_PER_VBLANK - 1;
+	ppuCycles = PPU_CYCLES_PER_SCANLINE - 0x20;
+	assert(memo_lookup(&subroutine) == 0, "Memoization Test #6");
+	ppuCtrl.executeNMIonVBLANK = FALSE;
+	currentScanline = 0;
+	ppuCycles = 0;
+	assert(subroutine.calls == 5 && subroutine.hits == 1 && subroutine.cyclesSkipped == 20, "Memoization Test #7");
+	memset(zeroPage, 0, sizeof(zeroPage));
+	cpu_set_flags(0);
+	registers.A = registers.X = registers.Y = 0;
+}
+void test_interpreter()
+{
+	// Code without a label is interpreted until it reaches one. Code in RAM never does, so it returns at the final RTS.
+	BYTE code[] =
+	{
+		0xA9, 0x10, 0x18, 0x69, 0x05, 0x8D, 0x00, 0x04, // LDA #0x10 / CLC / ADC #0x05 / STA 0x400
+		0xA2, 0x03, 0xCA, 0xD0, 0xFD, // LDX #0x03 / DEX / BNE -3
+		0xA9, 0x03, 0x48, 0xA9, 0x14, 0x48, 0x60, 0x00, // LDA #0x03 / PHA / LDA #0x14 / PHA / RTS (dispatches to 0x315) / BRK
+		0xE6, 0x20, 0x60 // INC 0x20 / RTS
+	};
+	memset(zeroPage, 0, sizeof(zeroPage));
+	memset(ram, 0, sizeof(ram));
+	for(UINT i = 0; i < sizeof(code); i++)
+		cpu_write8(0x300 + i, code[i]);
+	BYTE stackPointer = registers.SP;
+	assert(interpreter_execute(0x300) == FALSE, "Interpreter Test #1");
+	assert(cpu_read8(0x400) == 0x15 && registers.X == 0, "Interpreter Test #2");
+	assert(cpu_read8(0x20) == 0x01 && registers.SP == stackPointer, "Interpreter Test #3");
+	assert(interpreterCycles > 0 && interpreterBlockMisses == 4 && interpreterBlockHits == 1, "Interpreter Test #4");
+
+	// Code which is rewritten (even by its own block) is decoded again.
+	BYTE selfModifyingCode[] =
+	{
+		0xA9, 0x07, 0x8D, 0x06, 0x03, // LDA #0x07 / STA 0x306
+		0xA9, 0x00, 0x8D, 0x01, 0x04, // LDA #0x00 (operand rewritten above) / STA 0x401
+		0x60 // RTS
+	};
+	for(UINT i = 0; i < sizeof(selfModifyingCode); i++)
+		cpu_write8(0x300 + i, selfModifyingCode[i]);
+	assert(interpreter_execute(0x300) == FALSE && cpu_read8(0x401) == 0x07, "Interpreter Test #5");
+	cpu_write8(0x301, 0x09);
+	assert(interpreter_execute(0x300) == FALSE && cpu_read8(0x401) == 0x09, "Interpreter Test #6");
+
+	// With a return stack, JSR pushes its return address (the JSR's last byte) and RTS returns through it.
+	BYTE returnStackCode[] =
+	{
+		0x20, 0x06, 0x03, 0xE6, 0x21, 0x40, // JSR 0x306 / INC 0x21 / RTI
+		0xE6, 0x20, 0xBA, 0x86, 0x22, 0x60 // INC 0x20 / TSX / STX 0x22 / RTS
+	};
+	for(UINT i = 0; i < sizeof(returnStackCode); i++)
+		cpu_write8(0x300 + i, returnStackCode[i]);
+	memset(zeroPage, 0, sizeof(zeroPage));
+	gameUsesReturnStack = TRUE;
+	stackPointer = registers.SP;
+	assert(interpreter_execute(0x300) == TRUE, "Interpreter Test #7");
+	assert(cpu_read8(0x20) == 0x01 && cpu_read8(0x21) == 0x01 && registers.SP == stackPointer, "Interpreter Test #8");
+	assert(cpu_read8(0x22) == (BYTE)(stackPointer - 2) && stack[stackPointer] == 0x03 && stack[(BYTE)(stackPointer - 1)] == 0x02, "Interpreter Test #9");
+	gameUsesReturnStack = FALSE;
+	memset(ram, 0, sizeof(ram));
+	memset(zeroPage, 0, sizeof(zeroPage));
+	cpu_set_flags(0);
+}
+void test_profile()
+{
+	// Counts are written as the records NESgen reads back with -P (which also corrects mirrored PRG-ROM addresses).
+	const char* path = "NESsys_test.profile";
+	profile_init();
+	profile_block(0x8010);
+	profile_block(0x8010);
+	assert(profile_branch(0x8020, TRUE) == TRUE && profile_branch(0x8020, FALSE) == FALSE, "Profile Test #1");
+	profile_branch(0x8020, TRUE);
+	profile_indirect(0x8030, 0x9000);
+	profile_indirect(0x8030, 0x9000);
+	profile_indirect(0x8030, 0x9100);
+	profile_miss(0x0300);
+	assert(profile_write(path), "Profile Test #2");
+
+	char line[0x40];
+	const char* expected[] = { "block 8010 2\n", "branch 8020 1 2\n", "indirect 8030 9100 1\n", "indirect 8030 9000 2\n", "miss 0300 1\n" };
+	FILE* file = fopen(path, "r");
+	assert(file != NULL && fgets(line, sizeof(line), file) != NULL && line[0] == '#', "Profile Test #3");
+	for(UINT i = 0; i < sizeof(expected) / sizeof(expected[0]); i++)
+		assert(fgets(line, sizeof(line), file) != NULL && strcmp(line, expected[i]) == 0, "Profile Test #4 (record %u)", i);
+	assert(fgets(line, sizeof(line), file) == NULL, "Profile Test #5");
+	fclose(file);
+	remove(path);
+	profile_init();
+}
+/*
+ * Requests an IRQ once, stopping the interrupt handler which is syncing.
+ */
+void test_request_irq()
+{
+	onCpuSync = NULL;
+	interrupts.requestedIRQ = TRUE;
+}
+void test_cpu_interrupts()
+{
+	// Interrupt handlers behave the same whether called from the code they interrupt, or in their own context.
+	for(UINT coroutines = 0; coroutines <= PLATFORM_SUPPORTS_CONTEXTS; coroutines++)
+	{
+		cpuInterruptCoroutines = coroutines;
+		memset(zeroPage, 0, sizeof(zeroPage));
+		registers.SP = 0xFF;
+		cpu_set_flags(0);
+		cpu_set_flag(CPU_FLAG_CARRY, TRUE);
+		interrupts.requestedIRQ = TRUE;
+		assert(cpu_sync_interrupts() == FALSE && interrupts.current == INTERRUPT_RESET && registers.SP == 0xFF, "Interrupt Test #1 (coroutines %u)", coroutines);
+		assert(cpu_get_flag(CPU_FLAG_CARRY) && !cpu_get_flag(CPU_FLAG_INTERRUPT_DISABLE), "Interrupt Test #2 (coroutines %u)", coroutines);
+
+		// An NMI stopped at its first sync by an IRQ request returns to the interrupted code, leaving the IRQ to be handled next.
+		onCpuSync = test_request_irq;
+		interrupts.requestedNMI = TRUE;
+		assert(cpu_sync_interrupts() == FALSE && interrupts.current == INTERRUPT_RESET && interrupts.requestedIRQ && zeroPage[0] == 0, "Interrupt Test #3 (coroutines %u)", coroutines);
+		registers.SP = 0xFF;
+		assert(cpu_sync_interrupts() == FALSE && !interrupts.requestedIRQ && registers.SP == 0xFF, "Interrupt Test #4 (coroutines %u)", coroutines);
+
+		// And the next NMI executes from the start.
+		interrupts.requestedNMI = TRUE;
+		assert(cpu_sync_interrupts() == FALSE && interrupts.current == INTERRUPT_RESET && zeroPage[0] == 1 && registers.SP == 0xFF, "Interrupt Test #5 (coroutines %u)", coroutines);
+	}
+	cpuInterruptCoroutines = CPU_USE_COROUTINES;
+	memset(zeroPage, 0, sizeof(zeroPage));
+	memset(objectAttributeMemory, 0, sizeof(objectAttributeMemory));
+	cpu_set_flags(0);
+}
 void test_cpu_flags()
 {
 	assert(cpu_get_flag(CPU_FLAG_INTERRUPT_DISABLE) == FALSE, "CPU_FLAG_INTERRUPT_DISABLE should've been FALSE, but was TRUE.");
@@ -99,11 +625,20 @@ void test_chrrom()
 		assert(patternTables[bank][index] == chrRom[x], "CHR-ROM improperly loaded into pattern table (offset 0x%02x)", x);
 	}
 }
+void test_prgrom()
+{
+	// PRG-ROM is read-only (the compiler outputs it as const data, which may be linked in from binary files), writes to it are ignored.
+	BYTE value = cpu_read8(0xFFFC);
+	cpu_write8(0xFFFC, ~value);
+	assert(cpu_read8(0xFFFC) == value, "PRG-ROM Test #1");
+	assert(value == prgRomCode[(0xFFFC - 0x8000) % prgRomCodeSize], "PRG-ROM Test #2");
+}
 void test_all()
 {
 	// Initialize any needed hardware.
 	cpu_init();
 	ppu_init();
+	interpreter_init();
 
 	test_struct_sizes();
 	test_cpu_flags();
@@ -111,6 +646,20 @@ void test_all()
 	test_ppu_read_write();
 	test_cpu_read_write();
 	test_ppu_oamdma_register();
+	test_ppu_internal_registers();
+	test_ppu_oamdma_transfer();
+	test_ppu_data_transfer();
+	test_ppu_tile_cache();
+	test_ppu_raster_split();
+	test_register_instructions();
+	test_fused_instructions();
+	test_idiom_loops();
+	test_known_routines();
+	test_memoization();
+	test_interpreter();
+	test_profile();
+	test_cpu_interrupts();
 	test_chrrom();
+	test_prgrom();
 	printf("Passed all tests...\n");
 }